@@ -0,0 +1,50 @@
+#ifndef ANGLECALIBRATION_H
+#define ANGLECALIBRATION_H
+
+#include <Arduino.h>
+
+#define ANGLE_TABLE_SEGMENTS 16
+#define ANGLE_RAW_COUNTS 4096 // AS5600: 12 bits per turn
+
+// Signed distance a -> b on the 12-bit circle (-2048..2047)
+inline int16_t angleWrapDiff(uint16_t a, uint16_t b) {
+    int16_t d = (b - a) & (ANGLE_RAW_COUNTS - 1);
+    return (d >= ANGLE_RAW_COUNTS / 2) ? d - ANGLE_RAW_COUNTS : d;
+}
+
+// ============================================================================
+// RAW-TO-DEGREES CALIBRATION TABLE
+// ============================================================================
+// Built from readings captured at evenly spaced saw angles (0, 15, 30 ...).
+// A magnet that isn't centred, or a gear between saw and sensor, bends the
+// raw/angle line; a piecewise-linear fit through every captured point takes
+// that out where a single 0/45 pair can't.
+//
+// Readings are unwrapped first: each one is taken as a signed distance from
+// the 0-degree reading, in the direction the raw value moves as the angle
+// grows, so a span crossing raw 4095 -> 0 is one straight run.
+//
+// Like CalibrationTable, the fit is resampled at evenly spaced nodes, 2^shift
+// counts apart, so a lookup is one shift and one interpolation, no search.
+// Outside the captured span the end segments' slopes are extended.
+//
+// Pure integer lookup, no HAL: fit and lookup can be exercised off-target.
+class AngleCalibration {
+public:
+    AngleCalibration();
+
+    // raw[i]: reading at i * stepDeg degrees. Returns false (table unchanged)
+    // unless the readings move steadily one way and span under half a turn.
+    bool fit(const uint16_t *raw, uint8_t n, uint8_t stepDeg);
+
+    // Angle in hundredths of a degree (not clamped)
+    int32_t toCentiDeg(uint16_t raw) const;
+
+private:
+    uint16_t _rawZero;
+    int8_t _dir;       // +1: raw grows with the angle, -1: raw falls
+    uint8_t _shift;
+    int32_t _nodeCd[ANGLE_TABLE_SEGMENTS + 1]; // Centidegrees at k << _shift counts
+};
+
+#endif // ANGLECALIBRATION_H
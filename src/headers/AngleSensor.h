@@ -2,35 +2,58 @@
 #define ANGLESENSOR_H
 
 #include <Arduino.h>
-#include <Wire.h>
 #include "Config.h"
 #include "Storage.h"
+#include "AngleCalibration.h"
+#include "As5600.h"
 
+// ============================================================================
+// AS5600 ANGLE SENSOR (sampled in the background)
+// ============================================================================
+// The tick ISR marks a sample due every SYSTEM_TICK_HZ / ANGLE_SAMPLE_HZ
+// ticks; update() (main loop, outside the screens) does the one I2C read and
+// runs the filter chain:
+//   chip filters (As5600) -> median of 3 -> EMA (1/2^ANGLE_EMA_SHIFT) -> calibration table -> 0.2 deg deadband
+// Both filter stages work modulo 4096, so a magnet sitting on the raw 0/4095
+// seam doesn't average to 2048. Readers get the last published value and
+// never touch the bus.
 class AngleSensor {
 public:
     AngleSensor();
     
-    bool init();
-    bool isConnected();
+    bool init();        // Finds and configures the chip
+    bool isConnected(); // Chip answers and sees a usable magnet
     
-    // Main function to get current angle in degrees
-    // Returns negative value if error or not connected
-    float getAngleDegrees();
+    void tickISR(); // Call at SYSTEM_TICK_HZ
+    void update();  // Call every loop pass: samples when due
+
+    // Filtered angle in degrees (0-90), from the last sample
+    float getAngleDegrees() const { return _lastDegrees; }
     
-    // Raw access for calibration
-    uint16_t getRawAngle();
+    // Filtered raw angle (0-4095) for calibration
+    uint16_t getRawAngle() const { return (uint16_t)(_emaQ4 >> 4); }
+    uint32_t getSampleErrors() const { return _sampleErrors; }
     
-    // Calibration helpers
-    void setZeroPoint(uint16_t rawVal);
-    void set45Point(uint16_t rawVal);
+    // Calibration: raw[i] read at i * ANGLE_CALIB_STEP_DEG degrees, n >= 2.
+    // False (calibration unchanged) if the points can't be fitted.
+    bool setCalibration(const uint16_t *raw, uint8_t n);
 
 private:
-    uint16_t readRegister12(uint8_t reg);
+    As5600 _chip;
+    float toDegrees(uint16_t raw) const;
     float _lastDegrees;
+
+    // Pacing (tick ISR -> loop)
+    volatile bool _sampleDue;
+    uint16_t _tickDiv;
+
+    // Filter state
+    uint16_t _history[3];   // Last raw samples for the median
+    uint8_t _historyCount;
+    uint16_t _emaQ4;        // Raw x16, wraps with the raw angle
+    uint32_t _sampleErrors;
     
-    // Calibration data (cached from settings)
-    uint16_t _rawZero;
-    uint16_t _raw45;
+    AngleCalibration _calib; // Raw -> degrees (cached from settings)
 };
 
 #endif // ANGLESENSOR_H
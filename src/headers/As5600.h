@@ -0,0 +1,73 @@
+#ifndef AS5600_H
+#define AS5600_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// Registers (16-bit values are high byte first)
+#define AS5600_REG_CONF      0x07
+#define AS5600_REG_RAW_ANGLE 0x0C
+#define AS5600_REG_STATUS    0x0B
+#define AS5600_REG_ANGLE     0x0E
+#define AS5600_REG_AGC       0x1A
+
+// STATUS bits
+#define AS5600_STATUS_MH 0x08 // Magnet too strong
+#define AS5600_STATUS_ML 0x10 // Magnet too weak
+#define AS5600_STATUS_MD 0x20 // Magnet detected
+
+// CONF fields
+#define AS5600_CONF_PM_MASK   0x0003
+#define AS5600_CONF_HYST_MASK 0x000C
+#define AS5600_CONF_HYST_POS  2
+#define AS5600_CONF_SF_MASK   0x0300
+#define AS5600_CONF_SF_POS    8
+#define AS5600_CONF_FTH_MASK  0x1C00
+#define AS5600_CONF_FTH_POS   10
+#define AS5600_CONF_WD        0x2000
+
+enum As5600Magnet {
+    AS5600_MAGNET_OK = 0,
+    AS5600_MAGNET_MISSING,
+    AS5600_MAGNET_WEAK,
+    AS5600_MAGNET_STRONG,
+    AS5600_NO_RESPONSE // Chip didn't answer
+};
+
+// ============================================================================
+// AS5600 DRIVER (I2C, via i2cBus)
+// ============================================================================
+// begin() sets the chip's own filters from Config.h (slow filter, fast filter
+// threshold, hysteresis) at normal power and without the watchdog. CONF is
+// RAM, so this is redone every boot and nothing is burned to OTP.
+//
+// The chip keeps its register pointer between transactions, and for ANGLE /
+// RAW ANGLE it steps from the low byte back to the high byte rather than on.
+// So readAngle() sets the pointer once; after that each sample is a bare
+// 2-byte read with no write phase (3 bytes on the bus instead of 5). Any
+// other register access, or a failed transaction, forgets the pointer and the
+// next sample sets it again.
+class As5600 {
+public:
+    As5600();
+
+    bool begin(); // False if the chip doesn't answer or CONF doesn't stick
+
+    // Filtered, hysteresis-applied angle (0-4095). False on bus error.
+    bool readAngle(uint16_t *value);
+
+    bool readStatus(uint8_t *status);
+    As5600Magnet readMagnet(); // STATUS decoded, worst condition first
+    bool readAgc(uint8_t *agc);  // Gain: mid-range is a well-placed magnet
+
+    uint16_t getConf() const { return _conf; }
+
+private:
+    uint8_t _pointer; // Register the chip will read next, or 0xFF if unknown
+    uint16_t _conf;   // As written by begin()
+
+    bool readRegs(uint8_t reg, uint8_t *data, uint8_t n);
+    bool writeConf(uint16_t conf);
+};
+
+#endif // AS5600_H
@@ -0,0 +1,68 @@
+#ifndef AUTOZEROSYS_H
+#define AUTOZEROSYS_H
+
+#include <Arduino.h>
+#include "Position.h"
+
+// Defaults (overridable from settings)
+#define AZ_DEFAULT_ARM_MS 500         // Stillness needed before arming
+#define AZ_DEFAULT_BAND_UM 2000L      // Position may wander this much while "still"
+#define AZ_STILL_ENTER_UMS 1000L      // Classified still below 1 mm/s...
+#define AZ_STILL_EXIT_UMS 3000L       // ...and moving again above 3 mm/s (hysteresis)
+
+// ============================================================================
+// AUTO-ZERO ENGINE
+// ============================================================================
+// Evaluated at a fixed rate from the tick ISR with the encoder's shared motion
+// signal, so arming latency is the arm delay plus one tick - not one superloop.
+//
+//   MEASURING --(still for armDelay)--> ARMED --(moved > trigger)--> CUT_PENDING
+//       ^                                                                 |
+//       +---------------------- takeCut() (main loop) --------------------+
+//
+// The engine never touches the encoder: main consumes the latched cut, registers
+// it and applies the re-zero, keeping the offset single-writer.
+class AutoZeroSys {
+public:
+    enum State : uint8_t {
+        AZ_DISABLED,
+        AZ_MEASURING,
+        AZ_ARMED,
+        AZ_CUT_PENDING
+    };
+
+    AutoZeroSys();
+
+    // Main loop side
+    void configure(uint16_t armDelayMs, PositionUM bandUM, PositionUM triggerUM);
+    void setEnabled(bool enabled);    // Disabling drops an unconsumed cut
+    void disarm();                      // Manual zero / mode change: restart stillness timing
+    bool takeCut(PositionUM *lengthUM); // True once per auto-cut; caller re-zeroes by lengthUM
+
+    State getState() const { return _state; }
+    PositionUM getLockedPosition() const { return _lockedUM; }
+
+    // ISR side - call at a fixed rate
+    void sampleISR(PositionUM positionUM, int32_t velocityUMs, uint32_t nowMs);
+
+private:
+    // Configuration (written by main, read by the ISR; each field is atomic)
+    volatile uint16_t _armDelayMs;
+    volatile PositionUM _bandUM;
+    volatile PositionUM _triggerUM;
+    volatile bool _enabled;
+    volatile bool _disarmRequest;
+
+    // Engine state (written by the ISR; only main moves it out of CUT_PENDING)
+    volatile State _state;
+    volatile bool _needAnchor;
+    volatile PositionUM _lockedUM;
+    PositionUM _anchorUM;
+    uint32_t _stillSinceMs;
+    bool _still;
+
+    void restart();
+    bool classifyStill(int32_t velocityUMs);
+};
+
+#endif // AUTOZEROSYS_H
@@ -0,0 +1,31 @@
+#ifndef BIGFONT_H
+#define BIGFONT_H
+
+#include <Arduino.h>
+#include "LcdGlyphs.h"
+
+#define BIG_FONT_ROWS 2
+#define BIG_FONT_MAX_WIDTH 3
+
+// ============================================================================
+// BIG-DIGIT FONT (3x2 cells)
+// ============================================================================
+// Seven-segment style digits built from seven 2-pixel bar glyphs. Each
+// glyph is a fixed pattern of cell codes: drawing a number is table lookups
+// into the LCD frame, which then only sends the cells that changed.
+//
+// A digit's right strokes sit on the left edge of its third column, so the
+// rest of that column is the gap to the next digit.
+struct BigGlyph {
+    char ch;
+    uint8_t width;                                   // Columns used (1..3)
+    uint8_t cells[BIG_FONT_ROWS][BIG_FONT_MAX_WIDTH]; // Glyph code or ROM character
+};
+
+// Glyph for '0'-'9', '-', '.' or ' '; nullptr for anything else
+const BigGlyph *bigFontGlyph(char c);
+
+// Columns a string takes (characters without a glyph take none)
+uint8_t bigFontWidth(const char *s);
+
+#endif // BIGFONT_H
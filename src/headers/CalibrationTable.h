@@ -0,0 +1,48 @@
+#ifndef CALIBRATIONTABLE_H
+#define CALIBRATIONTABLE_H
+
+#include <Arduino.h>
+
+#define CALIB_TABLE_SEGMENTS 16 // Power of two not required, segment LENGTH is
+
+// ============================================================================
+// DISTANCE-INDEXED CORRECTION TABLE
+// ============================================================================
+// Corrects what a single wheel diameter can't: eccentricity and load-dependent
+// compression make the error grow non-linearly along a long bar.
+//
+// Built from a few reference cuts (raw counts + real length). The table holds
+// the correction in micrometres at evenly spaced nodes, 2^shift counts apart,
+// and is linearly interpolated between them:
+//   seg  = counts >> shift
+//   frac = counts & (2^shift - 1)
+// One shift, one multiply, no search - O(1) on the hot path.
+// Beyond the last node the last segment's slope is extended.
+//
+// fit() rewrites the table in place, so a table that an ISR reads must not be
+// refitted: fit a spare one and swap it in (EncoderSys keeps two).
+//
+// Pure integer lookup, no HAL: fit and lookup can be exercised off-target.
+class CalibrationTable {
+public:
+    CalibrationTable();
+
+    void clear();
+
+    // counts: raw counts from zero to each reference cut (sign ignored)
+    // errorUM: real length - nominal (diameter-based) length for that cut
+    // Returns false (table cleared) if there is nothing usable to fit.
+    bool fit(const int32_t *counts, const int32_t *errorUM, uint8_t n);
+
+    // Correction to add to the nominal length, odd-symmetric in counts
+    int32_t correctionUM(int64_t counts) const;
+
+    bool isActive() const { return _active; }
+
+private:
+    int32_t _nodeUM[CALIB_TABLE_SEGMENTS + 1];
+    uint8_t _shift;
+    bool _active;
+};
+
+#endif // CALIBRATIONTABLE_H
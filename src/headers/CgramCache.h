@@ -0,0 +1,51 @@
+#ifndef CGRAMCACHE_H
+#define CGRAMCACHE_H
+
+#include <Arduino.h>
+#include "LcdGlyphs.h"
+#include "LcdFrame.h"
+#include "LcdTransport.h"
+
+#define CGRAM_SLOTS 8
+
+// ============================================================================
+// CGRAM SLOT MANAGER
+// ============================================================================
+// The HD44780 has 8 user-defined characters; the firmware has 16 glyphs
+// (big-digit bars and menu icons). Instead of reloading all 8 slots when the
+// screen changes, prepare() runs before each frame goes out:
+// - a glyph is referenced while any cell of the frame uses it (per-glyph
+//   count over the target frame)
+// - referenced glyphs that are not resident get a slot: a free one first,
+//   else one whose glyph the frame no longer references
+// - only those glyphs are uploaded (9 LCD bytes each), queued ahead of the
+//   cells that use them
+//
+// A replaced glyph can still be on the glass in cells the same frame is about
+// to rewrite, so they may show the new pattern for the length of one frame.
+// If a screen ever references more than 8 glyphs, the extra ones are drawn as
+// spaces until a slot frees up.
+class CgramCache {
+public:
+    CgramCache();
+
+    void reset(); // CGRAM content unknown (LCD re-initialised): all slots free
+
+    // Makes the frame's glyphs resident. False if the transport had no room
+    // for an upload; the rest is retried on the next call.
+    bool prepare(LcdFrame *frame, LcdTransport *out);
+
+    // Character to send for each glyph code (index: code - GLYPH_BASE)
+    const uint8_t *slotMap() const { return _sendAs; }
+
+    uint32_t getUploads() const { return _uploads; } // Glyphs written to CGRAM since boot
+
+private:
+    uint8_t _slotGlyph[CGRAM_SLOTS]; // Glyph code held by each slot, 0 = free
+    uint8_t _sendAs[GLYPH_COUNT];    // Slot number, or ' ' while not resident
+    uint32_t _uploads;
+
+    int8_t findVictim(const uint8_t *refs) const;
+};
+
+#endif // CGRAMCACHE_H
@@ -6,30 +6,97 @@
 // ============================================================================
 // HARDWARE DEFINITIONS (STM32F4 Black Pill)
 // ============================================================================
-// Encoder (TIM4)
+// Encoder (hardware quadrature timer)
+// ENCODER_TIMER selects the backend at compile time:
+//   4 = TIM4 on PB6/PB7  (16-bit, wraps tracked by ISR) - default wiring
+//   2 = TIM2 on PA15/PB3 (32-bit, no wrap tracking)     - requires rewiring
+//   5 = TIM5 on PA0/PA1  (32-bit, no wrap tracking)     - requires rewiring
+// Falls back to TIM4 if the selected timer does not exist on the MCU.
+#define ENCODER_TIMER 4
+
+#if (ENCODER_TIMER == 2)
+#define PIN_ENCODER_A PA15
+#define PIN_ENCODER_B PB3
+#elif (ENCODER_TIMER == 5)
+#define PIN_ENCODER_A PA0
+#define PIN_ENCODER_B PA1
+#else
 #define PIN_ENCODER_A PB6
 #define PIN_ENCODER_B PB7
+#endif
+#define ENCODER_INPUT_FILTER 0x0F // Timer input filter (0-15) on both channels
+
+// Feed profile capture (TIM1-paced DMA ring of encoder counts, STM32 only)
+#define FEED_RING_SIZE 1024   // Samples, power of two (102 ms at 10 kHz)
+#define FEED_CAPTURE_HZ 10000
+#define FEED_LOG_SERIAL 0     // 1 = stream "timestamp_us,count" on Serial1
+#define FEED_LOG_DECIMATE 20  // Print every Nth sample (UART can't carry 10 kHz)
 
-// Menu Encoder (KY-040)
+// Menu Encoder (KY-040) - all three pins must share one GPIO port (read in one go)
 #define PIN_MENU_CLK PB12
 #define PIN_MENU_DT PB13
 #define PIN_MENU_SW PB14
+#define MENU_KNOB_EXTI 1 // 1 = decode CLK/DT on pin-change interrupts (STM32), 0 = poll in the tick
+
+// Knob acceleration for value editors: detents closer together step further
+#define KNOB_ACCEL_FAST_MS 35   // Gap below this (fast spin)...
+#define KNOB_ACCEL_FAST_STEPS 10 // ...counts as this many steps
+#define KNOB_ACCEL_MED_MS 80
+#define KNOB_ACCEL_MED_STEPS 4
+
+// Target-approach alarm output (buzzer / LED / relay driver), active HIGH
+#define PIN_TARGET_ALARM PB10
+#define TARGET_ALARM_REARM_UM 2000L // Back off this far past the trip point to re-arm
+
+// I2C1 bus: LCD backpack, AS5600, planned AT24C256 (see I2CBus)
+#define PIN_I2C_SDA PB9
+#define PIN_I2C_SCL PB8
+// The PCF8574 on the LCD backpack is specified to 100 kHz. The AS5600 and most
+// backpacks take 400 kHz: I2C_FAST_MODE 1 opts in (4x the display throughput),
+// go back to 0 if the display shows garbage (see docs/WIRING.md).
+#define I2C_FAST_MODE 0
+#if I2C_FAST_MODE
+#define I2C_CLOCK_HZ 400000
+#else
+#define I2C_CLOCK_HZ 100000
+#endif
+#define I2C_PASS_BUDGET_BYTES (I2C_CLOCK_HZ / 4000) // Bus bytes per loop pass for display/EEPROM traffic (~2.2 ms)
+#define I2C_AGING_PASSES 20      // A client denied this many passes in a row goes first
+#define I2C_RECOVER_AFTER 3      // Failed transactions in a row before checking for a stuck SDA
 
 // Display Settings
+// DISPLAY_TYPE selects the backend at compile time (the screen layout stays 20x4):
+//   0 = 20x4 HD44780 LCD, PCF8574 I2C backpack on PB8/PB9 - default wiring
+//   1 = 128x64 SSD1306/SH1106 OLED on SPI1 (SCK PA5, MOSI PA7) - 3.3V module
+//   2 = host framebuffer writing PGM images ([env:native] tests only)
+#ifndef DISPLAY_TYPE
+#define DISPLAY_TYPE 0
+#endif
 #define LCD_COLS 20
 #define LCD_ROWS 4
 #define LCD_ADDR 0x27
-#define PIN_LCD_SDA PB9
-#define PIN_LCD_SCL PB8
+#define LCD_TX_QUEUE_BYTES 512  // Expander bytes queued for the LCD (4 per character), power of two
+#define LCD_TX_CHUNK 32         // Expander bytes per Wire transaction (AVR Wire buffer size)
+#define LCD_TX_SLICE_BYTES (I2C_CLOCK_HZ / 6250) // Expander bytes sent per DisplaySys::update() (~1.5 ms)
+#define DISPLAY_FRAME_MS 40     // Render scheduler: at most one new frame per 40 ms (25 FPS)
+#define PIN_OLED_CS PA4
+#define PIN_OLED_DC PB0
+#define PIN_OLED_RST PB1
+#define OLED_SPI_HZ 8000000
+#define OLED_COL_OFFSET 0       // 2 for SH1106 (132-column RAM, 1.3" modules)
+#define OLED_SLICE_BYTES 256    // Pixel bytes sent per DisplaySys::update() (~0.3 ms at 8 MHz)
 
 // Measurement Settings
 #define DEFAULT_WHEEL_DIA_MM 50.0
 #define ENCODER_PPR 1024
 #define PULSES_PER_REV (ENCODER_PPR * 4) // Quadrature decoding
+#define CALIB_MAX_POINTS 4                // Reference cuts for the multi-point correction table
 
 // ============================================================================
 // EEPROM ADDRESS MAP
 // ============================================================================
+// Byte layout for the planned AT24C256. Settings currently persist as whole
+// records in internal flash (SETTINGS LOG below), so nothing uses these yet.
 #define EEPROM_ADDR_MAGIC 0         // Byte: Magic number (0x42)
 #define EEPROM_ADDR_DIA 4           // Float: Wheel Diameter
 #define EEPROM_ADDR_UNITS 8         // Byte: 0=MM, 1=INCH
@@ -50,12 +117,31 @@
 #define EEPROM_ADDR_PROJ_SEC 47     // Long: Project Seconds
 #define EEPROM_ADDR_TOT_SEC 51      // Long: Total Seconds
 
+// ============================================================================
+// SETTINGS LOG (internal flash, see SettingsLog)
+// ============================================================================
+// Sectors 6 and 7 of the F411: the firmware is capped below them with
+// board_upload.maximum_size in platformio.ini.
+#define STORAGE_SECTOR_A 6               // 0x08040000
+#define STORAGE_SECTOR_B 7               // 0x08060000
+#define STORAGE_SECTOR_A_ADDR 0x08040000UL
+#define STORAGE_SECTOR_B_ADDR 0x08060000UL
+#define STORAGE_SECTOR_SIZE 0x20000UL    // 128 KB each
+#define STORAGE_MAX_PAYLOAD 256          // Bytes per record (SystemSettings)
+#define STORAGE_WORDS_PER_STEP 8         // Flash words programmed per loop pass (~16 us each)
+#define STORAGE_ERASE_AHEAD_BYTES (STORAGE_SECTOR_SIZE / 2) // Spare erased once this little is left...
+#define STORAGE_ERASE_STILL_MS 5000      // ...at the first idle spell this long (wheel still, no input)
+
 // ============================================================================
 // SYSTEM SETTINGS
 // ============================================================================
 #define FIRMWARE_VERSION "1.0.0"
 #define SERIAL_BAUD_RATE 115200
 #define WATCHDOG_TIMEOUT_MS 2000
+#define WATCHDOG_ERASE_TIMEOUT_MS 8000 // Stretched around a flash sector erase (2 s max on the F411)
+#define SYSTEM_TICK_HZ 1000 // TIM3 tick: input debounce + encoder motion sampling + angle pacing
+#define TIMER_IRQ_PRIORITY 14 // TIM3 tick and encoder timer share it: neither may preempt the other (EncoderSys.h)
+#define INPUT_QUEUE_SIZE 16 // Pending input events (power of two) between tick ISR and loop
 
 // ============================================================================
 // STOCK LIBRARY (Metric)
@@ -92,5 +178,13 @@ extern const uint8_t STOCK_CYL_IN_COUNT;
 // ============================================================================
 #define USE_ANGLE_SENSOR     // Uncomment to enable AS5600 sensor
 #define AS5600_I2C_ADDR 0x36 // AS5600 magnetic angle sensor
+// On-chip filters (AS5600 CONF, set at every boot)
+#define AS5600_SLOW_FILTER 1 // SF: 0 = 16x, 1 = 8x, 2 = 4x, 3 = 2x (lower = quieter, slower)
+#define AS5600_FAST_FILTER 2 // FTH: 0 = slow only, 1..6 = 6/7/9/18/21/24 LSB, 7 = 10 LSB
+#define AS5600_HYSTERESIS 1  // HYST: 0 = off, 1..3 LSB (1 LSB = 0.088 deg)
+#define ANGLE_SAMPLE_HZ 50   // Background reads (divides SYSTEM_TICK_HZ)
+#define ANGLE_EMA_SHIFT 2    // EMA weight 1/4: ~80 ms time constant at 50 Hz
+#define ANGLE_CALIB_POINTS 5    // Angle wizard captures 0, 15, 30, 45, 60 degrees (at least 2)
+#define ANGLE_CALIB_STEP_DEG 15
 
 #endif // CONFIG_H
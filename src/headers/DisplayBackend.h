@@ -0,0 +1,33 @@
+#ifndef DISPLAYBACKEND_H
+#define DISPLAYBACKEND_H
+
+#include "Config.h"
+
+// ============================================================================
+// DISPLAY BACKEND (compile-time selection, see DISPLAY_TYPE)
+// ============================================================================
+// DisplaySys composes every screen into a 20x4 LcdFrame of characters and
+// glyph codes; the backend gets it onto the glass. All backends have the
+// same shape:
+//   begin()                 hardware init, screen cleared
+//   clearScreen()           blocking clear (DisplaySys then marks the frame cleared)
+//   beginFrame(LcdFrame*)   take the frame's dirty cells, queue their bytes
+//   pump()                  send one bounded slice of the queue
+//   isIdle()                nothing left to send
+//   getErrors()             failed bus transactions (screen state unknown)
+//   getGlyphUploads()       custom-character uploads (0 where not applicable)
+#if (DISPLAY_TYPE == 1)
+#include "Ssd1306Backend.h"
+typedef Ssd1306Backend DisplayBackend;
+#elif (DISPLAY_TYPE == 2)
+#ifdef ARDUINO
+#error "DISPLAY_TYPE 2 is the host test backend"
+#endif
+#include "PgmBackend.h"
+typedef PgmBackend DisplayBackend;
+#else
+#include "Hd44780Backend.h"
+typedef Hd44780Backend DisplayBackend;
+#endif
+
+#endif // DISPLAYBACKEND_H
@@ -2,52 +2,65 @@
 #define DISPLAYSYS_H
 
 #include <Arduino.h>
-#include <LiquidCrystal_I2C.h>
 #include "Config.h"
-
-// Forward declaration for LCDBigNumbers
-class LCDBigNumbers;
+#include "Position.h"
+#include "EncoderDiag.h"
+#include "LcdFrame.h"
+#include "DisplayBackend.h"
+#include "LineBuf.h"
 
 class DisplaySys {
 public:
     DisplaySys();
     void init();
-    void update(); // Call in main loop
+    void update(); // Call in main loop: render scheduler, bounded bus work per call
+
+    // Render statistics
+    uint8_t getFps() const { return _fps; }                          // Frames completed in the last second
+    uint32_t getFrameDrawUs() const { return _lastFrameDrawUs; }     // update() time spent on the last frame
+    uint32_t getCgramUploads() const { return _out.getGlyphUploads(); } // Custom characters written since boot
+    const DisplayBackend &getBackend() const { return _out; } // Host tests look at the glass
     
-    void showMeasurement(float mm, bool isInch);
-    void showIdle(float currentMM, float targetMM, uint8_t cutMode, uint8_t stockType, const char* stockStr, uint8_t faceVal, bool isInch, bool reverseDir);
-    void showHiddenInfo(float kerfMM, float diameter, bool reverseDir, bool autoZeroEnabled);
-    void showMenu(const char* title, String value, bool isEditMode);
-    void showMenu4(String l0, String l1, String l2, String l3);
+    void showIdle(PositionUM currentUM, int32_t velocityUMs, float targetMM, uint8_t cutMode, uint8_t stockType, const char* stockStr, uint8_t faceVal, bool isInch, bool reverseDir);
+    void showHiddenInfo(float kerfMM, float diameter, bool reverseDir, bool autoZeroEnabled,
+                        const EncoderDiag *diag, unsigned long rejectedCuts);
+    void setUnsaved(bool unsaved) { _unsaved = unsaved; } // Idle separator warns: settings/stats not in flash
+    void showMenu(const char* title, const char* value, bool isEditMode);
+    void showMenu4(const char* l0, const char* l1, const char* l2, const char* l3);
     void showError(const char* msg);
     
-    // Clears the screen and resets the display cache to force a full redraw
+    // Clears the screen and resets the display cache to force a full redraw.
+    // Not needed between screens: every screen writes all four rows.
     void clear();
 
 private:
-    LiquidCrystal_I2C* _lcd;
-    LCDBigNumbers* _bigNumbers;
+    LcdFrame _frame;      // Shadow of the 20x4 screen, flushed as changed cells only
+    DisplayBackend _out;  // HD44780, OLED or host PGM (DISPLAY_TYPE), pumped from update()
+    uint32_t _outErrors;  // Backend errors already handled
+
+    // Render scheduler
+    bool _frameInFlight;
+    unsigned long _frameStartMs;
+    uint32_t _frameDrawUs;
+    uint32_t _lastFrameDrawUs;
+    uint8_t _framesThisSecond;
+    uint8_t _fps;
+    unsigned long _fpsWindowStartMs;
     
-    // Cache to prevent flickering
-    float _lastMM;
+    // Big number cache (display values are integer tenths of CM or IN)
+    int32_t _lastBigValue;
     bool _lastIsInch;
-    String _lastLine[4];  // Cache all 4 lines for 20x4 LCD
-    
-    // Big number cache
-    float _lastBigValue;
-    String _lastBigUnit;
     
     // Temporal filtering for smooth updates
-    unsigned long _lastValueChangeMillis;
-    float _lastRawValue;
+    unsigned long _lastValueChangeMillis;  // Last time the wheel was moving
     bool _wasSettled;  // Track if we just transitioned to settled state
-    float _lastVelocity;  // Track rate of change (cm/s or in/s)
     
-    // Display mode tracking for proper custom char management
+    // Display mode tracking: the big number is recomposed when idle is entered
     bool _inIdleMode;  // Track if we're displaying idle screen
+    bool _unsaved;
     
-    void printLine(int row, String text);
-    void createCustomChars();
+    void printLine(int row, const char* text); // Into the frame, padded to the full row
+    void drawBigNumber(const char* text); // Rows 0-1 of the frame, left of the unit label
 };
 
 #endif // DISPLAYSYS_H
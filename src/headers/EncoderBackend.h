@@ -0,0 +1,284 @@
+#ifndef ENCODERBACKEND_H
+#define ENCODERBACKEND_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================================================
+// COUNT MATH (hardware independent - compiles anywhere)
+// ============================================================================
+// 16-bit timers wrap every 65536 counts and need wrap tracking.
+// 32-bit timers are read directly as a signed value: 2^31 counts is ~80 km of
+// feed on a 50 mm wheel, so no wrap can happen between power cycles.
+template <typename CounterT>
+struct EncoderCountMath {
+    static const bool TRACK_WRAPS = (sizeof(CounterT) < 4);
+    static const uint32_t MAX_COUNT = (CounterT)~(CounterT)0;
+    static const uint32_t HALF_COUNT = (MAX_COUNT >> 1) + 1;
+
+    // Update event direction, judged from the counter value right after the wrap:
+    // overflow leaves it near 0, underflow near MAX.
+    static int8_t wrapDirection(CounterT cnt) {
+        return (cnt < HALF_COUNT) ? 1 : -1;
+    }
+
+    static int64_t toCount(int32_t wraps, CounterT cnt) {
+        if (!TRACK_WRAPS) {
+            return (int64_t)(int32_t)cnt; // Sign-extend: underflow below 0 reads as negative
+        }
+        return ((int64_t)wraps * ((int64_t)MAX_COUNT + 1)) + cnt;
+    }
+
+    // Extend a captured counter value to 64 bits, given a count read shortly after
+    static int64_t extendCapture(CounterT captured, int64_t nowCount) {
+        CounterT back = (CounterT)((CounterT)nowCount - captured);
+        int64_t delta = back;
+        if (back >= HALF_COUNT) delta -= (int64_t)MAX_COUNT + 1; // Capture is "ahead": moving backwards
+        return nowCount - delta;
+    }
+};
+
+#if defined(STM32F4xx)
+#include <HardwareTimer.h>
+
+// ============================================================================
+// PIN / CHANNEL MAPPINGS
+// ============================================================================
+// TIM4 CH1/CH2 on PB6/PB7 (AF2) - 16-bit, original wiring, always available
+struct EncoderPinsTIM4 {
+    static TIM_TypeDef *instance() { return TIM4; }
+    static const char *name() { return "TIM4 PB6/PB7 16-bit"; }
+    static GPIO_TypeDef *portA() { return GPIOB; }
+    static GPIO_TypeDef *portB() { return GPIOB; }
+    static const uint16_t PIN_A = GPIO_PIN_6;
+    static const uint16_t PIN_B = GPIO_PIN_7;
+    static const uint8_t AF = GPIO_AF2_TIM4;
+    static void enableGpioClocks() { __HAL_RCC_GPIOB_CLK_ENABLE(); }
+};
+
+#if defined(TIM2)
+// TIM2 CH1/CH2 on PA15/PB3 (AF1) - 32-bit. PB3 is SWO, free when flashing over SWD.
+struct EncoderPinsTIM2 {
+    static TIM_TypeDef *instance() { return TIM2; }
+    static const char *name() { return "TIM2 PA15/PB3 32-bit"; }
+    static GPIO_TypeDef *portA() { return GPIOA; }
+    static GPIO_TypeDef *portB() { return GPIOB; }
+    static const uint16_t PIN_A = GPIO_PIN_15;
+    static const uint16_t PIN_B = GPIO_PIN_3;
+    static const uint8_t AF = GPIO_AF1_TIM2;
+    static void enableGpioClocks() { __HAL_RCC_GPIOA_CLK_ENABLE(); __HAL_RCC_GPIOB_CLK_ENABLE(); }
+};
+#endif
+
+#if defined(TIM5)
+// TIM5 CH1/CH2 on PA0/PA1 (AF2) - 32-bit
+struct EncoderPinsTIM5 {
+    static TIM_TypeDef *instance() { return TIM5; }
+    static const char *name() { return "TIM5 PA0/PA1 32-bit"; }
+    static GPIO_TypeDef *portA() { return GPIOA; }
+    static GPIO_TypeDef *portB() { return GPIOA; }
+    static const uint16_t PIN_A = GPIO_PIN_0;
+    static const uint16_t PIN_B = GPIO_PIN_1;
+    static const uint8_t AF = GPIO_AF2_TIM5;
+    static void enableGpioClocks() { __HAL_RCC_GPIOA_CLK_ENABLE(); }
+};
+#endif
+
+// ============================================================================
+// QUADRATURE TIMER BACKEND
+// ============================================================================
+template <typename CounterT, typename Pins>
+class EncoderTimerBackend {
+public:
+    typedef EncoderCountMath<CounterT> Math;
+    typedef CounterT Counter;
+
+    EncoderTimerBackend() : _timer(nullptr), _wrapCount(0) {}
+
+    static const char *name() { return Pins::name(); }
+    HardwareTimer *timer() { return _timer; }
+    TIM_TypeDef *instance() { return Pins::instance(); }
+
+    void init(uint8_t inputFilter) {
+        // Pins straight to Alternate Function with pull-ups. Do NOT use pinMode()
+        // afterwards: it switches them to plain input and disconnects the timer.
+        Pins::enableGpioClocks();
+        configurePin(Pins::portA(), Pins::PIN_A);
+        configurePin(Pins::portB(), Pins::PIN_B);
+
+        _timer = new HardwareTimer(Pins::instance());
+        _timer->pause();
+        _timer->setInterruptPriority(TIMER_IRQ_PRIORITY, 0); // Same as the tick: see EncoderSys.h
+
+        // HardwareTimer doesn't expose encoder mode directly, so we configure via HAL
+        TIM_HandleTypeDef *halTimer = _timer->getHandle();
+
+        // Configure encoder mode (both TI1 and TI2 on both edges)
+        TIM_Encoder_InitTypeDef encoderConfig;
+        encoderConfig.EncoderMode = TIM_ENCODERMODE_TI12;
+        encoderConfig.IC1Polarity = TIM_ICPOLARITY_RISING;
+        encoderConfig.IC1Selection = TIM_ICSELECTION_DIRECTTI;
+        encoderConfig.IC1Prescaler = TIM_ICPSC_DIV1;
+        encoderConfig.IC1Filter = inputFilter;
+        encoderConfig.IC2Polarity = TIM_ICPOLARITY_RISING;
+        encoderConfig.IC2Selection = TIM_ICSELECTION_DIRECTTI;
+        encoderConfig.IC2Prescaler = TIM_ICPSC_DIV1;
+        encoderConfig.IC2Filter = inputFilter;
+
+        if (HAL_TIM_Encoder_Init(halTimer, &encoderConfig) != HAL_OK) {
+            // Error handling if needed
+        }
+
+        // Full counter range. Written directly: HardwareTimer defaults to a 16-bit
+        // period and setOverflow(N) loads N-1.
+        __HAL_TIM_SET_AUTORELOAD(halTimer, Math::MAX_COUNT);
+
+        // 16-bit only: wraps counted by the update interrupt. Attached before
+        // resume() so the timer starts with UIE enabled.
+        _wrapCount = 0;
+        if (Math::TRACK_WRAPS) {
+            _isrInstance = this;
+            _timer->attachInterrupt(updateISR);
+        }
+
+        HAL_TIM_Encoder_Start(halTimer, TIM_CHANNEL_ALL);
+        _timer->setCount(0);
+        __HAL_TIM_CLEAR_FLAG(halTimer, TIM_FLAG_UPDATE); // Init UG event must not count as a wrap
+        _timer->resume();
+    }
+
+    // Lock-free 64-bit count, safe from main loop and ISRs
+    int64_t readCount(uint32_t *timestampUs) {
+        if (_timer == nullptr) {
+            *timestampUs = micros();
+            return 0;
+        }
+
+        TIM_TypeDef *tim = Pins::instance();
+
+        if (!Math::TRACK_WRAPS) {
+            // 32-bit: single register read, nothing to reconcile
+            CounterT cnt = (CounterT)tim->CNT;
+            *timestampUs = micros();
+            return Math::toCount(0, cnt);
+        }
+
+        int32_t wrapsBefore;
+        int32_t wrapsAfter;
+        CounterT cnt;
+        bool wrapPending;
+        bool wrapPendingAfter;
+
+        // Retry if the ISR ran, or the counter wrapped, while we were sampling
+        // (seqlock style, no IRQ masking)
+        do {
+            wrapsBefore = _wrapCount;
+            wrapPending = (tim->SR & TIM_SR_UIF) != 0;
+            cnt = (CounterT)tim->CNT;
+            wrapPendingAfter = (tim->SR & TIM_SR_UIF) != 0;
+            *timestampUs = micros();
+            wrapsAfter = _wrapCount;
+        } while (wrapsBefore != wrapsAfter || wrapPending != wrapPendingAfter);
+
+        // Called with the update IRQ blocked (same/higher priority ISR or masked):
+        // a wrap may have happened that the ISR has not counted yet. Account for it here.
+        int32_t wraps = wrapsBefore;
+        if (wrapPending) {
+            wraps += Math::wrapDirection(cnt);
+        }
+        return Math::toCount(wraps, cnt);
+    }
+
+    // CH1 input capture: CCR1 latches the count on every A edge (encoder mode
+    // keeps CC1 enabled). The interrupt gives the edge its timestamp.
+    void attachCapture(void (*callback)()) {
+        if (_timer != nullptr) {
+            _timer->attachInterrupt(1, callback);
+        }
+    }
+
+    int64_t readCapture(int64_t nowCount) {
+        return Math::extendCapture((CounterT)Pins::instance()->CCR1, nowCount);
+    }
+
+    // Capture every edge at low speed, every 8th at high speed (bounds IRQ load).
+    // Only affects capture - the encoder counter still sees every edge.
+    void setCapturePrescaler(bool divideBy8) {
+        if (_timer != nullptr) {
+            __HAL_TIM_SET_ICPRESCALER(_timer->getHandle(), TIM_CHANNEL_1,
+                                      divideBy8 ? TIM_ICPSC_DIV8 : TIM_ICPSC_DIV1);
+        }
+    }
+
+    // CH3 as a pin-less output compare: CC3IF is set whenever CNT == CCR3, in
+    // either counting direction. Used for count-exact events (target alarm).
+    void attachCompare(void (*callback)()) {
+        if (_timer != nullptr) {
+            _timer->attachInterrupt(3, callback);
+            enableCompare(false);
+        }
+    }
+
+    void setCompare(CounterT value) {
+        Pins::instance()->CCR3 = value;
+    }
+
+    bool isCompareEnabled() {
+        return (Pins::instance()->DIER & TIM_DIER_CC3IE) != 0;
+    }
+
+    void enableCompare(bool enable) {
+        if (_timer == nullptr) return;
+        TIM_HandleTypeDef *halTimer = _timer->getHandle();
+        __HAL_TIM_CLEAR_FLAG(halTimer, TIM_FLAG_CC3);
+        if (enable) {
+            __HAL_TIM_ENABLE_IT(halTimer, TIM_IT_CC3);
+        } else {
+            __HAL_TIM_DISABLE_IT(halTimer, TIM_IT_CC3);
+        }
+    }
+
+private:
+    HardwareTimer *_timer;
+    volatile int32_t _wrapCount; // Written ONLY by the update ISR
+
+    static EncoderTimerBackend *_isrInstance;
+
+    static void updateISR() {
+        if (_isrInstance != nullptr) {
+            CounterT cnt = (CounterT)Pins::instance()->CNT;
+            _isrInstance->_wrapCount = _isrInstance->_wrapCount + Math::wrapDirection(cnt);
+        }
+    }
+
+    static void configurePin(GPIO_TypeDef *port, uint16_t pin) {
+        GPIO_InitTypeDef GPIO_InitStruct = {0};
+        GPIO_InitStruct.Pin = pin;
+        GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+        GPIO_InitStruct.Pull = GPIO_PULLUP; // Keep pull-ups enabled!
+        GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+        GPIO_InitStruct.Alternate = Pins::AF;
+        HAL_GPIO_Init(port, &GPIO_InitStruct);
+    }
+};
+
+template <typename CounterT, typename Pins>
+EncoderTimerBackend<CounterT, Pins> *EncoderTimerBackend<CounterT, Pins>::_isrInstance = nullptr;
+
+// ============================================================================
+// COMPILE-TIME SELECTION (see ENCODER_TIMER in Config.h)
+// ============================================================================
+#if (ENCODER_TIMER == 5) && defined(TIM5)
+typedef EncoderTimerBackend<uint32_t, EncoderPinsTIM5> EncoderBackend;
+#elif (ENCODER_TIMER == 2) && defined(TIM2)
+typedef EncoderTimerBackend<uint32_t, EncoderPinsTIM2> EncoderBackend;
+#else
+#if (ENCODER_TIMER != 4)
+#warning "ENCODER_TIMER not available on this MCU - falling back to TIM4 (PB6/PB7)"
+#endif
+typedef EncoderTimerBackend<uint16_t, EncoderPinsTIM4> EncoderBackend;
+#endif
+
+#endif // STM32F4xx
+
+#endif // ENCODERBACKEND_H
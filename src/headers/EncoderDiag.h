@@ -0,0 +1,86 @@
+#ifndef ENCODERDIAG_H
+#define ENCODERDIAG_H
+
+#include <Arduino.h>
+
+// Physical limits of the feed: anything beyond these is not real motion
+#define DIAG_MAX_SPEED_UMS 3000000L   // 3 m/s
+#define DIAG_MAX_ACCEL_UMS2 100000000L // 100 m/s^2 (~10 g), above a hard stop on the fence
+#define DIAG_CHATTER_WINDOW_MS 20     // Two reversals closer than this = chatter
+#define DIAG_EVENT_HOLDOFF_MS 50      // One physical event counts once
+#define DIAG_SLIP_CONFIRM_MS 250      // Over-limit braking that hasn't come to rest by then = slip
+
+// ============================================================================
+// ENCODER DIAGNOSTICS
+// ============================================================================
+// Watches the same signals the motion estimator uses and flags what a wheel on
+// real stock can't do:
+// - Glitch: edge faster than max speed, count jump in one tick, or a speed
+//   step-up beyond max acceleration (noise from the saw motor, bad cable)
+// - Chatter: direction reversals in quick succession (vibration on an edge)
+// - Slip: speed collapsing faster than max deceleration while the wheel keeps
+//   turning (skidding while the stock kept moving). Braking that ends at rest
+//   within DIAG_SLIP_CONFIRM_MS is a stop, however hard: the fence, a hand.
+//
+// Acceleration is judged per edge-pair estimate (onEstimate), never from
+// sample-to-sample velocity steps: those carry the sample clock's
+// quantisation and would flag a steady feed.
+//
+// Counters are lifetime totals. A glitch or slip since the last zero makes the
+// current reading suspect; chatter only costs health. Each counted event is
+// counted once, in its counter and in the window alike (DIAG_EVENT_HOLDOFF_MS
+// merges the rest). Health is 0-100, drops per event and recovers 1 point
+// per clean second.
+// All inputs are in counts: limits are converted by EncoderSys on calibration.
+class EncoderDiag {
+public:
+    EncoderDiag();
+
+    void setLimits(uint32_t maxCountsPerSec, uint32_t maxCountsPerSec2);
+
+    // ISR side
+    void onEdge(uint32_t edgeTimeUs, uint8_t edgesPerCapture, uint32_t nowMs);
+    void onEstimate(int32_t velocityQ8, int32_t edgeAccel, uint32_t nowMs); // MotionEstimator made one
+    void onSample(int64_t count, int32_t velocityQ8, uint32_t sampleHz, uint32_t nowMs);
+
+    // Main loop side
+    bool isMeasurementSuspect() const { return _windowEvents != 0; }
+    void startWindow() { _windowEvents = 0; } // Call on every zero / cut
+
+    uint8_t getHealth() const { return _health; }
+    uint16_t getGlitches() const { return _glitches; }
+    uint16_t getChatter() const { return _chatter; }
+    uint16_t getSlips() const { return _slips; }
+
+private:
+    // Set by the main loop, read by the ISRs: filled in the spare slot, then
+    // _limitSlot flips (a tick never mixes old and new limits)
+    struct Limits {
+        uint32_t maxCountsPerSec;
+        uint32_t maxCountsPerSec2;
+        uint32_t minEdgeUs;
+    };
+    Limits _limits[2];
+    volatile uint8_t _limitSlot;
+
+    volatile uint16_t _glitches;
+    volatile uint16_t _chatter;
+    volatile uint16_t _slips;
+    volatile uint8_t _windowEvents;
+    volatile uint8_t _health;
+
+    uint32_t _lastEdgeUs;
+    int64_t _lastCount;
+    int8_t _lastDir;
+    bool _slipPending;
+    uint32_t _slipPendingMs;
+    uint32_t _lastReversalMs;
+    uint32_t _lastEventMs;
+    uint32_t _cleanSinceMs;
+    bool _primed;
+
+    void flag(volatile uint16_t &counter, uint8_t penalty, bool suspect, uint32_t nowMs);
+    void prime(int64_t count, uint32_t nowMs);
+};
+
+#endif // ENCODERDIAG_H
@@ -3,43 +3,169 @@
 
 #include <Arduino.h>
 #include "Config.h"
+#include "Position.h"
+#include "MotionEstimator.h"
+#include "CalibrationTable.h"
+#include "EncoderDiag.h"
 
 // STM32 Hardware Timer for Encoder
 #if defined(STM32F4xx)
-  #include <HardwareTimer.h>
+  #include "EncoderBackend.h"
+  #include "FeedCapture.h"
 #else
   #include <Encoder.h> // Fallback for AVR
 #endif
 
+#if !defined(STM32F4xx)
+struct FeedSample {
+    int64_t count;
+    uint32_t timestampUs;
+};
+#endif
+
+// Consistent view of the encoder: full 64-bit count plus the micros() time it was taken.
+// Count is absolute (since init), not affected by reset()/zeroing.
+struct EncoderSnapshot {
+    int64_t count;
+    uint32_t timestampUs;
+};
+
 class EncoderSys {
 public:
     EncoderSys();
-    
+
     void init();
-    void update(); // Call in main loop to handle overflow tracking
-    
+    void update(); // Call in main loop (overflow tracking is interrupt-driven on STM32)
+
     void reset();
     long getRawCount();
-    float getDistanceMM();
-    
+
+    // Distance since last reset(), minus offset. Pure integer math, includes the
+    // multi-point correction when one is loaded.
+    PositionUM getDistanceUM();
+
+    // Exact count -> micrometre conversion (32.32 fixed-point scale, no drift)
+    int64_t countsToUM(int64_t counts);
+    int64_t umToCounts(int64_t um); // Inverse, rounded (not for ISRs: uses double)
+
+    // Lock-free: safe from main loop and from ISRs, never loses a wrap
+    EncoderSnapshot getSnapshot();
+
     void setWheelDiameter(float diameterMM);
     float getWheelDiameter();
-    void setOffset(float offsetMM);
+
+    // Multi-point correction from reference cuts (raw counts since zero, real length).
+    // Refitted automatically when the wheel diameter changes. n = 0 clears it.
+    bool setCorrectionPoints(const int32_t *counts, const int32_t *realUM, uint8_t n);
+    bool hasCorrection();
+    void setOffsetUM(PositionUM offsetUM);
+    PositionUM getOffsetUM();
+
+    // Human readable backend description for the boot log
+    const char* getBackendName();
+
+    // Motion sampling - call at SYSTEM_TICK_HZ from the tick timer ISR
+    void sampleISR();
+
+    // Shared motion signal (M/T estimate, updated at SYSTEM_TICK_HZ)
+    int32_t getVelocityUMs();   // um/s, signed
+    int32_t getAccelUMs2();     // um/s^2, smoothed
+
+    // Target-approach alarm: drives PIN_TARGET_ALARM when the position reaches
+    // targetUM minus the distance covered in leadMs at the current speed.
+    // On STM32 it fires from a timer compare match at the exact count.
+    void setTargetAlarm(PositionUM targetUM, uint16_t leadMs);
+    void clearTargetAlarm();
+    bool isTargetAlarmActive();
+
+    // Feed profile capture: hardware-paced (count, time) samples, drained in batches.
+    // Returns false where there is no DMA backend.
+    bool startFeedCapture(uint32_t sampleHz);
+    void stopFeedCapture();
+    uint16_t drainFeed(FeedSample *out, uint16_t maxSamples);
+    uint32_t getFeedOverruns();
+
+    // Signal diagnostics. Suspect = glitch or slip since the last zero/cut.
+    bool isMeasurementSuspect();
+    void startMeasurement(); // New cut window (reset() does this implicitly)
+    const EncoderDiag *getDiag();
+
+    // Trip point for an approach, in counts (pure math, no hardware)
+    static int64_t predictTripCount(int64_t target, int64_t count, int32_t velocityQ8, uint16_t leadMs);
 
 private:
 #if defined(STM32F4xx)
-    HardwareTimer* _timer;
-    volatile long _overflowCount;
-    uint16_t _lastTimerCount;
+    EncoderBackend _hw; // TIM2/TIM5 (32-bit) or TIM4 (16-bit), see ENCODER_TIMER
+    FeedCaptureRing<EncoderBackend::Counter, FEED_RING_SIZE> _feed;
+    bool _captureDiv8;
+
+    static EncoderSys* _isrInstance;
+    static void captureISR();
+    static void compareISR();
+    void onCapture();
+    void onCompare();
 #else
     Encoder* _encoder;
 #endif
 
-    long _lastCount;
+    // Software zero (absolute count at reset()) and display offset. Written
+    // only by the main loop, read by the tick ISR too: the loop fills the
+    // unpublished slot and then flips _zeroSlot, so the ISR always reads a
+    // matching pair. (A seqlock can't be used here: the ISR could never wait
+    // out a writer it has interrupted.)
+    volatile int64_t _zeroCount[2];
+    volatile PositionUM _offsetUM[2];
+    volatile uint8_t _zeroSlot;
+    void publishZero(int64_t zeroCount, PositionUM offsetUM);
+
+    // Latest captured edge, written by the capture ISR (seq guards the 64-bit read)
+    volatile uint32_t _edgeSeq;
+    volatile int64_t _edgeCount;
+    volatile uint32_t _edgeTimeUs;
+    MotionEstimator _motion;
+
+    // Target alarm. Main writes target/lead with _alarmEnabled cleared; the
+    // ISRs own the rest. Two of them change _alarmFired/_alarmTrip: onCompare()
+    // (encoder timer IRQ) fires, serviceAlarm() (TIM3 tick) moves the trip point,
+    // fires late and re-arms. That is only safe because neither can preempt the
+    // other: both timers run at TIMER_IRQ_PRIORITY, set explicitly in init()
+    // and main.cpp rather than left to the core's default. (AVR: ISRs don't nest.)
+    volatile bool _alarmEnabled;
+    volatile bool _alarmFired;
+    int64_t _alarmTarget;       // Absolute count
+    int64_t _alarmTrip;         // Absolute count the output switches at
+    int8_t _alarmSide;          // Sign of (target - count) at the last sample
+    int64_t _alarmRearmCounts;
+    uint16_t _alarmLeadMs;
+    PositionUM _alarmTargetUM;  // Last requested target, to skip redundant re-arms
+    PositionUM _alarmOffsetUM;
+    int64_t _alarmZeroCount;
+
+    void setAlarmOutput(bool on);
+    void fireAlarm(int64_t count);
+    void serviceAlarm(int64_t count);
+
+    EncoderDiag _diag;
+    int32_t _corrCounts[CALIB_MAX_POINTS];
+    int32_t _corrRealUM[CALIB_MAX_POINTS];
+    uint8_t _corrPoints;
+
     float _wheelDiameter;
-    float _mmPerPulse;
-    float _offsetMM;
-    
+
+    // Count -> micrometre conversion, read by the tick ISR. Rebuilt by the
+    // main loop in the spare slot and published by flipping _scaleSlot, like
+    // the zero above: a tick sees the old scale and table or the new ones,
+    // never a torn 32.32 value or a table mid-fit.
+    struct CountScale {
+        uint32_t umPerCountInt;  // Micrometres per count as 32.32 fixed point:
+        uint32_t umPerCountFrac; // integer part + Q32 fraction
+        CalibrationTable correction;
+    };
+    CountScale _scale[2];
+    volatile uint8_t _scaleSlot;
+
+    static int64_t scaleToUM(const CountScale &scale, int64_t counts);
+    void publishScale(uint32_t umPerCountInt, uint32_t umPerCountFrac);
     void recalculateCalibration();
 };
 
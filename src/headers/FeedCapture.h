@@ -0,0 +1,229 @@
+#ifndef FEEDCAPTURE_H
+#define FEEDCAPTURE_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "EncoderBackend.h"
+
+// One point of the feed profile
+struct FeedSample {
+    int64_t count;        // Absolute encoder count (same scale as EncoderSnapshot)
+    uint32_t timestampUs; // micros() time base
+};
+
+#if defined(STM32F4xx)
+
+// ============================================================================
+// DMA FEED CAPTURE RING
+// ============================================================================
+// TIM1 runs as a pure pacer: every update event raises a DMA request and DMA2
+// Stream5 (channel 6 = TIM1_UP) copies the encoder timer's CNT register into a
+// circular buffer. No interrupt per sample - the CPU only touches the ring when
+// a consumer drains it.
+//
+// Samples are evenly spaced in hardware, so the timestamp is implicit:
+//   t(k) = t0 + k * period
+// and is filled in on drain together with the 64-bit count (16-bit counters are
+// unwrapped against the previous sample: at 300 RPM and 10 kHz that is ~2
+// counts per sample, nowhere near half the counter range).
+//
+// The period is what the pacer actually runs at, (PSC+1)(ARR+1) timer clocks,
+// not 1 s / sampleHz: the two differ whenever sampleHz doesn't divide the
+// clock. It is kept as whole microseconds plus a remainder over the timer
+// clock, so k * period is exact for any k and timestamps don't drift from the
+// samples however long the capture runs.
+//
+// Overrun detection: poll() (from the 1 kHz tick) counts buffer laps from the
+// DMA's remaining-transfer register, giving a total write index. If the writer
+// gets more than one buffer ahead of the reader, the oldest samples are skipped
+// and counted in getOverruns().
+// DMA2 is used because DMA1's peripheral port only reaches APB1 - DMA2 reaches
+// every encoder timer option.
+template <typename CounterT, uint16_t N>
+class FeedCaptureRing {
+public:
+    typedef EncoderCountMath<CounterT> Math;
+    static_assert((N & (N - 1)) == 0, "Ring size must be a power of two (index wraps with the 32-bit totals)");
+
+    FeedCaptureRing() : _pacer(nullptr), _running(false), _laps(0), _lastRemaining(N), _readTotal(0),
+                        _overruns(0), _periodUs(0), _periodRem(0), _periodDen(1), _t0Us(0), _lastCount(0) {}
+
+    bool start(TIM_TypeDef *encoderTimer, uint32_t sampleHz, int64_t nowCount) {
+        if (_running || sampleHz == 0 || sampleHz > 1000000) return false;
+
+        // Pacer: TIM1 update at sampleHz, update DMA request only
+        if (_pacer == nullptr) {
+            _pacer = new HardwareTimer(TIM1);
+        }
+        _pacer->pause();
+        _pacer->setOverflow(sampleHz, HERTZ_FORMAT);
+
+        __HAL_RCC_DMA2_CLK_ENABLE();
+        _dma.Instance = DMA2_Stream5;
+        _dma.Init.Channel = DMA_CHANNEL_6;
+        _dma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+        _dma.Init.PeriphInc = DMA_PINC_DISABLE;
+        _dma.Init.MemInc = DMA_MINC_ENABLE;
+        _dma.Init.PeriphDataAlignment = (sizeof(CounterT) == 2) ? DMA_PDATAALIGN_HALFWORD : DMA_PDATAALIGN_WORD;
+        _dma.Init.MemDataAlignment = (sizeof(CounterT) == 2) ? DMA_MDATAALIGN_HALFWORD : DMA_MDATAALIGN_WORD;
+        _dma.Init.Mode = DMA_CIRCULAR;
+        _dma.Init.Priority = DMA_PRIORITY_HIGH;
+        _dma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        if (HAL_DMA_Init(&_dma) != HAL_OK) return false;
+
+        // Polling start (no DMA interrupts): laps are tracked in poll()
+        if (HAL_DMA_Start(&_dma, (uintptr_t)&encoderTimer->CNT, (uintptr_t)_buf, N) != HAL_OK) return false;
+
+        _laps = 0;
+        _lastRemaining = N;
+        _readTotal = 0;
+        _overruns = 0;
+        setPeriod();
+        _lastCount = nowCount;
+
+        TIM1->DIER |= TIM_DIER_UDE;
+        _t0Us = micros() + _periodUs; // First request comes one period after resume
+        _pacer->resume();
+        _running = true;
+        return true;
+    }
+
+    void stop() {
+        if (!_running) return;
+        _running = false;
+        _pacer->pause();
+        TIM1->DIER &= ~TIM_DIER_UDE;
+        HAL_DMA_Abort(&_dma);
+    }
+
+    bool isRunning() const { return _running; }
+
+    // Call at least once per buffer period (N / sampleHz) - the 1 kHz tick does
+    void poll() {
+        if (!_running) return;
+        uint16_t remaining = (uint16_t)__HAL_DMA_GET_COUNTER(&_dma);
+        if (remaining > _lastRemaining) {
+            _laps = _laps + 1; // NDTR reloaded: DMA wrapped to the start
+        }
+        _lastRemaining = remaining;
+    }
+
+    // Samples written so far (monotonic)
+    uint32_t writeTotal() {
+        uint32_t laps;
+        uint16_t last;
+        uint16_t remaining;
+        do {
+            laps = _laps;
+            last = _lastRemaining;
+            remaining = (uint16_t)__HAL_DMA_GET_COUNTER(&_dma);
+        } while (laps != _laps || last != _lastRemaining);
+        // Wrapped since the last poll() but not yet counted
+        if (remaining > last) laps++;
+        return laps * N + (N - remaining);
+    }
+
+    uint16_t available() {
+        if (!_running) return 0;
+        skipOverrun();
+        return (uint16_t)(writeTotal() - _readTotal);
+    }
+
+    // Zero-copy view: contiguous raw counter values starting at the read index.
+    // Returns how many are valid (may be less than available() at the ring end).
+    const volatile CounterT *peek(uint16_t *count) {
+        uint16_t avail = available();
+        uint16_t idx = _readTotal % N;
+        uint16_t contiguous = N - idx;
+        *count = (avail < contiguous) ? avail : contiguous;
+        return &_buf[idx];
+    }
+
+    // Release n samples obtained from peek() (unwraps them to keep the 64-bit base)
+    void consume(uint16_t n) {
+        for (uint16_t i = 0; i < n; i++) {
+            extend(_buf[(_readTotal + i) % N]);
+        }
+        _readTotal += n;
+    }
+
+    // Batch drain into full samples. Returns how many were written to out.
+    uint16_t drain(FeedSample *out, uint16_t maxSamples) {
+        uint16_t avail = available();
+        uint16_t n = (avail < maxSamples) ? avail : maxSamples;
+        // One division for the first timestamp, then step by the period
+        uint32_t t = _t0Us + _readTotal * _periodUs +
+                     (uint32_t)((uint64_t)_readTotal * _periodRem / _periodDen);
+        uint32_t frac = (uint32_t)((uint64_t)_readTotal * _periodRem % _periodDen);
+        for (uint16_t i = 0; i < n; i++) {
+            out[i].count = extend(_buf[(_readTotal + i) % N]);
+            out[i].timestampUs = t;
+            t += _periodUs;
+            frac += _periodRem;
+            if (frac >= _periodDen) {
+                frac -= _periodDen;
+                t++;
+            }
+        }
+        _readTotal += n;
+        return n;
+    }
+
+    uint32_t getOverruns() const { return _overruns; }
+    uint32_t getPeriodUs() const { return _periodUs; } // Whole microseconds (see above)
+
+private:
+    volatile CounterT _buf[N];
+    DMA_HandleTypeDef _dma;
+    HardwareTimer *_pacer;
+    bool _running;
+
+    volatile uint32_t _laps;
+    volatile uint16_t _lastRemaining;
+    uint32_t _readTotal;
+    uint32_t _overruns;
+    uint32_t _periodUs;  // Period = _periodUs + _periodRem / _periodDen
+    uint32_t _periodRem;
+    uint32_t _periodDen;
+    uint32_t _t0Us;
+    int64_t _lastCount;
+
+    // From the pacer's registers as setOverflow() left them
+    void setPeriod() {
+        uint64_t num = (uint64_t)_pacer->getPrescaleFactor() * _pacer->getOverflow(TICK_FORMAT) * 1000000ULL;
+        uint32_t den = _pacer->getTimerClkFreq();
+        // Reduce, so k * _periodRem can't overflow (TIM1 at 100 MHz: den = 100)
+        uint64_t a = num, b = den;
+        while (b) {
+            uint64_t r = a % b;
+            a = b;
+            b = r;
+        }
+        num /= a;
+        _periodDen = (uint32_t)(den / a);
+        _periodUs = (uint32_t)(num / _periodDen);
+        _periodRem = (uint32_t)(num % _periodDen);
+    }
+
+    void skipOverrun() {
+        // Keep a little slack: the slot DMA writes next may be mid-update
+        uint32_t total = writeTotal();
+        if (total - _readTotal > N - 1) {
+            uint32_t skip = (total - _readTotal) - (N - 1);
+            _readTotal += skip;
+            _overruns += skip;
+            // Unwrap base continues from the oldest survivor (exact unless the
+            // gap covered more than half the counter range)
+            _lastCount = Math::extendCapture(_buf[_readTotal % N], _lastCount);
+        }
+    }
+
+    int64_t extend(CounterT raw) {
+        _lastCount = Math::extendCapture(raw, _lastCount);
+        return _lastCount;
+    }
+};
+
+#endif // STM32F4xx
+
+#endif // FEEDCAPTURE_H
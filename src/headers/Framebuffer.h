@@ -0,0 +1,51 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "LcdFrame.h"
+
+#define OLED_WIDTH 128
+#define OLED_PAGES 8   // 64 rows, 8 pixels per page byte
+#define OLED_CELL_W 6  // 5x7 character + 1 column gap
+#define OLED_CELL_H 16 // Character doubled vertically: 2 pages per text row
+#define OLED_X0 ((OLED_WIDTH - LCD_COLS * OLED_CELL_W) / 2)
+
+static_assert(LCD_COLS * OLED_CELL_W <= OLED_WIDTH, "Text columns don't fit the panel");
+static_assert(LCD_ROWS * OLED_CELL_H <= OLED_PAGES * 8, "Text rows don't fit the panel");
+
+// ============================================================================
+// 128x64 MONOCHROME FRAMEBUFFER (PAGE LAYOUT)
+// ============================================================================
+// The 20x4 screen rasterised for a graphic panel, with 6x16 cells: the 5x7
+// font (or the 5x8 glyph pattern) doubled vertically, so the big-digit bars
+// join into solid 4-row-high digits readable from across the shop.
+//
+// Laid out like SSD1306 RAM: 8 pages of 128 column bytes, bit 0 = top pixel.
+// draw() only rasterises the frame's dirty cells and widens a dirty column
+// window per page; the panel backend takes those windows in slices.
+class Framebuffer {
+public:
+    Framebuffer();
+
+    void clear();                 // All pixels off, every page dirty
+    void draw(LcdFrame *frame);   // Takes the frame's dirty cells
+    bool isClean() const;         // No dirty window left
+
+    // Start of a page's dirty window, at most budget bytes, removed from the
+    // window. Returns the byte count (0 when the page is clean); *x0 = column.
+    uint16_t takeWindow(uint8_t page, uint16_t budget, uint8_t *x0);
+
+    const uint8_t *page(uint8_t p) const { return _fb[p]; }
+    bool pixel(uint8_t x, uint8_t y) const { return (_fb[y >> 3][x] >> (y & 7)) & 1; }
+
+private:
+    uint8_t _fb[OLED_PAGES][OLED_WIDTH];
+    uint8_t _dirtyLo[OLED_PAGES]; // Column window still to send per page,
+    uint8_t _dirtyHi[OLED_PAGES]; // empty when lo > hi
+
+    void drawCell(uint8_t col, uint8_t row, uint8_t c);
+    void markDirty(uint8_t page, uint8_t x0, uint8_t x1);
+};
+
+#endif // FRAMEBUFFER_H
@@ -0,0 +1,38 @@
+#ifndef HD44780BACKEND_H
+#define HD44780BACKEND_H
+
+#include <Arduino.h>
+#include <LiquidCrystal_I2C.h>
+#include "Config.h"
+#include "LcdFrame.h"
+#include "LcdTransport.h"
+#include "CgramCache.h"
+#include "I2CBus.h"
+
+// ============================================================================
+// 20x4 HD44780 CHARACTER LCD (PCF8574 I2C BACKPACK)
+// ============================================================================
+// The library only initialises the controller and clears it; everything
+// else goes through the queued transport. Glyph codes in the frame become
+// CGRAM slots uploaded on demand.
+class Hd44780Backend {
+public:
+    Hd44780Backend();
+
+    void begin();
+    void clearScreen(); // Blocking; caller marks the frame cleared
+
+    void beginFrame(LcdFrame *frame); // Queue the frame's dirty cells
+    void pump(); // One slice, within the I2C bus budget
+    bool isIdle() const { return _tx.isIdle(); }
+
+    uint32_t getErrors() const { return _tx.getErrors(); }   // Failed I2C transactions
+    uint32_t getGlyphUploads() const { return _cgram.getUploads(); }
+
+private:
+    LiquidCrystal_I2C *_lcd;
+    LcdTransport _tx;   // Queued expander writes
+    CgramCache _cgram;  // Which glyph sits in which of the 8 custom characters
+};
+
+#endif // HD44780BACKEND_H
@@ -0,0 +1,74 @@
+#ifndef I2CBUS_H
+#define I2CBUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "Config.h"
+
+// Bus users, highest priority first
+enum I2CClient {
+    I2C_CLIENT_ANGLE = 0, // AS5600 samples: never wait
+    I2C_CLIENT_LCD,       // Display text
+    I2C_CLIENT_EEPROM,    // Reserved for the AT24C256 (docs/TODO.md)
+    I2C_CLIENT_COUNT
+};
+
+// ============================================================================
+// SHARED I2C1 BUS (PB8/PB9)
+// ============================================================================
+// The LCD backpack, the AS5600 and the planned EEPROM share one bus, and the
+// Wire library blocks for the length of a transaction. Every transaction goes
+// through here so they are counted and a stuck bus is recovered; bulk traffic
+// also asks grant() first so one loop pass never spends more than
+// I2C_PASS_BUDGET_BYTES on the bus:
+// - the angle sensor is always granted (a few bytes, latency matters)
+// - the others share what is left of the pass budget in priority order
+// - a client denied for I2C_AGING_PASSES passes in a row is served first on
+//   the next pass, so the EEPROM can't be starved by a busy display
+//
+// Recovery: after I2C_RECOVER_AFTER failed transactions in a row with SDA
+// held low, the slave is stuck mid-byte. SCL is clocked by hand until it lets
+// go, a STOP is sent and Wire restarted.
+class I2CBus {
+public:
+    I2CBus();
+
+    void begin(); // Pins, clock, stuck-bus check; before any client
+    void startPass(); // Once per loop pass: new byte budget
+
+    // Bytes (of want) the client may put on the bus this pass
+    uint16_t grant(I2CClient who, uint16_t want);
+
+    // Blocking transactions. False on NACK / bus error / short read.
+    bool probe(I2CClient who, uint8_t addr);
+    bool write(I2CClient who, uint8_t addr, const uint8_t *data, uint8_t n);
+    bool read(I2CClient who, uint8_t addr, uint8_t *in, uint8_t n); // From the slave's current register
+    bool writeRead(I2CClient who, uint8_t addr, const uint8_t *out, uint8_t outLen, uint8_t *in, uint8_t inLen);
+
+    // Diagnostics
+    uint32_t getTransactions(I2CClient who) const { return _transactions[who]; }
+    uint32_t getErrors(I2CClient who) const { return _errors[who]; }
+    uint32_t getMaxWaitMs(I2CClient who) const { return _maxWaitMs[who]; } // Longest run of denied grants
+    uint16_t getRecoveries() const { return _recoveries; }
+
+private:
+    uint16_t _passUsed;
+    uint8_t _failStreak;
+    uint16_t _recoveries;
+
+    uint32_t _transactions[I2C_CLIENT_COUNT];
+    uint32_t _errors[I2C_CLIENT_COUNT];
+    bool _waiting[I2C_CLIENT_COUNT];
+    uint8_t _waitPasses[I2C_CLIENT_COUNT];
+    unsigned long _waitStartMs[I2C_CLIENT_COUNT];
+    uint32_t _maxWaitMs[I2C_CLIENT_COUNT];
+
+    void startWire();
+    bool finish(I2CClient who, bool ok, uint16_t bytes);
+    bool isStuck() const;
+    void recover();
+};
+
+extern I2CBus i2cBus; // The one I2C1 bus, like Wire
+
+#endif // I2CBUS_H
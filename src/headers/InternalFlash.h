@@ -0,0 +1,24 @@
+#ifndef INTERNALFLASH_H
+#define INTERNALFLASH_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================================================
+// INTERNAL FLASH (settings log sectors)
+// ============================================================================
+// The only code that drives the flash controller. SettingsLog reads its
+// sectors through the memory map at flashSectorBase() and changes them only
+// through these calls, so the native tests link a RAM model in place of
+// InternalFlash.cpp.
+//
+// flashErase() blocks: the F411 has one bank, so a 128 KB erase (1-2 s)
+// stalls every flash fetch, ISRs included. Call it only where nothing is
+// being measured: at boot, or on entering the menu. It stretches the watchdog
+// to WATCHDOG_ERASE_TIMEOUT_MS around the erase if the watchdog runs.
+
+uintptr_t flashSectorBase(uint8_t sector); // 0 = no settings flash on this board
+bool flashProgram(uintptr_t addr, uint32_t word); // False if it doesn't read back
+bool flashErase(uint8_t sector);
+
+#endif // INTERNALFLASH_H
@@ -0,0 +1,68 @@
+#ifndef LCDFRAME_H
+#define LCDFRAME_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "LcdTransport.h"
+#include "LcdGlyphs.h"
+
+static_assert(LCD_COLS <= 32, "Dirty masks are one 32-bit word per row");
+static_assert(LCD_ROWS <= 4, "HD44780 addresses at most 4 rows");
+
+// ============================================================================
+// LCD SHADOW FRAMEBUFFER
+// ============================================================================
+// Screens write the characters they want into the frame; flush() queues only
+// the cells that differ from what the LCD is showing.
+//
+// Every cell costs one data byte (4 PCF8574 writes) and every cursor move one
+// command byte, so flush() walks dirty cells in DDRAM address order and only
+// moves the cursor when auto-increment doesn't already land on the next dirty
+// cell. On a 20x4 the DDRAM runs row 0 -> row 2 and row 1 -> row 3, so a run
+// continues across those row ends without a cursor command.
+//
+// Cells written behind the frame's back (another library, a clear()) must be
+// reported with invalidate() / cleared() so the next flush doesn't trust them.
+class LcdFrame {
+public:
+    LcdFrame();
+
+    // Target content
+    void put(uint8_t col, uint8_t row, uint8_t c);
+    // Copies s (no mapping) and pads with spaces up to width cells
+    void write(uint8_t col, uint8_t row, const char *s, uint8_t width);
+    void fill(uint8_t col, uint8_t row, uint8_t c, uint8_t n);
+    uint8_t get(uint8_t col, uint8_t row) const { return _want[row][col]; }
+
+    // What the LCD shows
+    void invalidate(uint8_t col, uint8_t row, uint8_t n); // Overwritten externally: resend
+    void invalidateAll();
+    void invalidateCode(uint8_t c); // Cells showing c (a redefined glyph)
+    void cleared();    // LCD was just clear()ed: all spaces, cursor home
+    void cursorLost(); // Cursor moved externally
+
+    bool isDirty() const;
+    void countGlyphs(uint8_t counts[GLYPH_COUNT]) const; // Target cells per glyph code
+
+    // Queues the dirty cells of the rows in rowMask (bit per row). Returns LCD
+    // bytes queued (data + cursor commands). Stops when the transport is full:
+    // the rest stay dirty for the next call. Glyph codes are sent as
+    // glyphMap[code - GLYPH_BASE] (see CgramCache).
+    uint16_t flush(LcdTransport *out, uint8_t rowMask, const uint8_t *glyphMap);
+
+    // For backends that draw cells themselves: takes the row's dirty cells as
+    // sent and returns them (bit per column).
+    uint32_t commitRow(uint8_t row);
+
+private:
+    uint8_t _want[LCD_ROWS][LCD_COLS];
+    uint8_t _shown[LCD_ROWS][LCD_COLS];
+    uint32_t _dirty[LCD_ROWS]; // Bit per column: want != shown, or shown unknown
+    uint32_t _stale[LCD_ROWS]; // Bit per column: shown unknown
+    uint8_t _cursor;           // DDRAM address the next data byte lands on
+    bool _cursorValid;
+
+    void updateDirty(uint8_t col, uint8_t row);
+};
+
+#endif // LCDFRAME_H
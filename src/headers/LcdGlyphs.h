@@ -0,0 +1,45 @@
+#ifndef LCDGLYPHS_H
+#define LCDGLYPHS_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// CUSTOM GLYPHS
+// ============================================================================
+// Every custom character the firmware draws, addressed by a frame code in
+// 0x10-0x1F (blank in the A00 ROM, so never meaningful on their own). Screens
+// put these codes into the LCD frame; CgramCache decides which of the 8 CGRAM
+// slots each one lives in.
+#define GLYPH_BASE 0x10
+#define GLYPH_COUNT 16
+
+// Big-digit bars (2-pixel strokes)
+#define GLYPH_BAR_UP     0x10 // Upper bar
+#define GLYPH_BAR_LO     0x11 // Lower bar
+#define GLYPH_BAR_UL     0x12 // Upper and lower bar
+#define GLYPH_BAR_VL     0x13 // Left bar, full height
+#define GLYPH_BAR_CL     0x14 // Left lower corner
+#define GLYPH_BAR_CUL    0x15 // Left upper and lower corners
+#define GLYPH_DOT        0x16 // Decimal point
+#define GLYPH_COLON      0x17
+
+// Menu icons (menu strings use \x01-\x08, see glyphForMenuChar())
+#define GLYPH_ICON_STATS    0x18
+#define GLYPH_ICON_RECT     0x19
+#define GLYPH_ICON_ANGLE    0x1A // Angle iron
+#define GLYPH_ICON_GEAR     0x1B
+#define GLYPH_ICON_BLADE    0x1C
+#define GLYPH_ICON_SETTINGS 0x1D
+#define GLYPH_ICON_ARROWS   0x1E
+#define GLYPH_ICON_ANGLESYM 0x1F
+
+inline bool isGlyphCode(uint8_t c) { return c >= GLYPH_BASE && c < GLYPH_BASE + GLYPH_COUNT; }
+
+// 5x8 pattern of a glyph code
+const uint8_t *glyphPattern(uint8_t code);
+
+// Menu text marks icons with \x01-\x07 (and \x08 for icon 0): the legacy
+// CGRAM slot numbers. Returns the glyph code, or c unchanged.
+uint8_t glyphForMenuChar(uint8_t c);
+
+#endif // LCDGLYPHS_H
@@ -0,0 +1,73 @@
+#ifndef LCDTRANSPORT_H
+#define LCDTRANSPORT_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+static_assert((LCD_TX_QUEUE_BYTES & (LCD_TX_QUEUE_BYTES - 1)) == 0, "LCD queue size must be a power of two");
+static_assert((LCD_TX_CHUNK & 3) == 0, "LCD chunks must hold whole characters (4 expander bytes)");
+
+// ============================================================================
+// QUEUED HD44780-OVER-PCF8574 TRANSPORT
+// ============================================================================
+// The backpack's PCF8574 drives the LCD in 4-bit mode:
+//   P0 = RS, P1 = RW, P2 = EN, P3 = backlight, P4-P7 = D4-D7
+// One LCD byte = 2 nibbles x (EN high, EN low) = 4 expander bytes. The LCD
+// latches on the falling edge, and the 4 bytes take ~360 us at 100 kHz (~90 us
+// with I2C_FAST_MODE), well past the 37 us a character or cursor command
+// needs to execute.
+//
+// Callers queue LCD bytes and return at once; pump() streams the queue in
+// multi-byte I2C transactions (one address byte per chunk instead of per
+// expander write), never more than its byte budget per call, rounded down to
+// whole LCD bytes. A full queue rejects new bytes - the caller keeps them
+// dirty and retries later.
+//
+// A failed transaction may have latched part of its bytes, leaving the LCD
+// half way through a byte: everything after it would be decoded a nibble
+// out. So on error the queue is dropped and the controller is put back into
+// 4-bit mode from any state (0x3, 0x3, 0x3, 0x2, then function set, display
+// on, entry mode: ~5 ms, blocking). If that fails too (display unplugged),
+// the next pump() tries again before sending anything. Either way the screen
+// content is unknown: getErrors() moves and the owner redraws.
+//
+// Slow commands (clear, home: 1.5 ms) are not queued: use the library
+// directly after drain().
+class LcdTransport {
+public:
+    LcdTransport(uint8_t addr);
+
+    void setBacklight(bool on) { _backlight = on ? 0x08 : 0x00; }
+
+    // Queue side. False (nothing queued) if the queue is full.
+    bool command(uint8_t cmd);
+    bool data(uint8_t c);
+    bool setCursor(uint8_t col, uint8_t row);
+
+    uint16_t room() const; // LCD bytes that still fit
+    bool isIdle() const { return _head == _tail; }
+
+    // Sends up to maxBytes expander bytes. Returns how many went out.
+    uint16_t pump(uint16_t maxBytes);
+    void drain(); // Blocking: until the queue is empty
+
+    uint32_t getErrors() const { return _errors; }   // Failed I2C transactions
+    uint32_t getBytesSent() const { return _bytesSent; }
+
+private:
+    uint8_t _addr;
+    uint8_t _backlight;
+    uint8_t _buf[LCD_TX_QUEUE_BYTES];
+    uint16_t _head; // Free-running, masked on access
+    uint16_t _tail;
+    uint32_t _errors;
+    uint32_t _bytesSent;
+    bool _resyncPending; // Last resync failed: retried before the next send
+
+    void encode(uint8_t value, uint8_t mode, uint8_t *out) const;
+    bool queueByte(uint8_t value, uint8_t mode);
+    bool writeNibble(uint8_t nibble);
+    bool resync(); // Blocking, ~5 ms: back to a known nibble phase
+};
+
+#endif // LCDTRANSPORT_H
@@ -0,0 +1,43 @@
+#ifndef LINEBUF_H
+#define LINEBUF_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+#define LINEBUF_CAPACITY LCD_COLS // One display line; longer text is cut off
+
+// ============================================================================
+// FIXED-CAPACITY LINE BUFFER
+// ============================================================================
+// Stack-allocated replacement for String when building display lines: no heap,
+// no reallocation, appends past the capacity are dropped (the LCD would cut
+// them off anyway). Always NUL-terminated.
+//
+// Numbers are formatted from integers: addFixed(1234, 1) -> "123.4". Floats
+// are rounded to a scaled integer first, so there is no dtostrf and the output
+// matches String(x, n) for the values a menu shows.
+class LineBuf {
+public:
+    LineBuf() { clear(); }
+    explicit LineBuf(const char *s) { clear(); add(s); }
+
+    void clear() { _len = 0; _buf[0] = '\0'; }
+
+    LineBuf &add(const char *s);
+    LineBuf &add(char c);
+    LineBuf &addInt(int32_t v);
+    LineBuf &addUInt(uint32_t v);
+    LineBuf &addFixed(int32_t scaled, uint8_t decimals); // scaled / 10^decimals
+    LineBuf &addFloat(float v, uint8_t decimals);
+    LineBuf &pad(char c, uint8_t width); // Append c up to width characters
+
+    const char *c_str() const { return _buf; }
+    uint8_t length() const { return _len; }
+    bool isEmpty() const { return _len == 0; }
+
+private:
+    char _buf[LINEBUF_CAPACITY + 1];
+    uint8_t _len;
+};
+
+#endif // LINEBUF_H
@@ -22,8 +22,8 @@ enum MenuState
     MENU_CALIBRATION_SUBMENU, // NEW: Calibration submenu
     MENU_SETTINGS_SUBMENU,    // NEW: Settings submenu
     MENU_AUTO_CALIB,
-    MENU_CALIB_ANGLE_0,
-    MENU_CALIB_ANGLE_45
+    MENU_CALIB_ANGLE,
+    MENU_MULTI_CALIB
 };
 
 enum MenuItem
@@ -46,6 +46,10 @@ public:
     // Returns true if menu is still active, false if exited
     bool update(InputEvent e, DisplaySys *display, EncoderSys *encoder);
 
+    // Apply one event without rendering (drain a burst, then update() once).
+    // steps: knob acceleration multiplier for value editors (InputRecord::steps)
+    bool handleEvent(InputEvent e, DisplaySys *display, EncoderSys *encoder, uint8_t steps = 1);
+
 private:
     SystemSettings *_settings;
     StatsSys *_stats;
@@ -61,16 +65,27 @@ private:
     int8_t _statsSubItem; // For Stats Select menu
 
     // Calibration state
-    int8_t _calibSubItem; // 0-4 (Wheel Wizard, Angle Wizard, Wheel Dia, Kerf, Back)
+    int8_t _calibSubItem; // 0-5 (Wheel Wizard, Angle Wizard, Wheel Dia, Kerf, Multi-Point, Back)
     int8_t _calibScrollOffset;
     int8_t _calibStep; // For auto-calib wizard
     long _calibPulses;
     float _calibRealLen;
-    unsigned long _lastCalibAdjustTime; // For acceleration
-    uint8_t _calibAdjustSpeed;          // 0=slow, 1=medium, 2=fast
+
+    // Multi-point wizard: reference cuts collected so far
+    uint8_t _multiCount;
+    int32_t _multiCounts[CALIB_MAX_POINTS];
+    int32_t _multiRealUM[CALIB_MAX_POINTS];
+    bool _multiSaveSelected; // Step 3 choice: false = next point, true = save
+
+    // Angle wizard: raw readings at 0, 15, 30 ... degrees collected so far
+    uint8_t _angleCount;
+    uint16_t _angleRaw[ANGLE_CALIB_POINTS];
+    bool _angleSaveSelected; // Step 1 choice: false = next point, true = save
+
+    uint8_t _editSteps; // Knob acceleration of the event being handled (1 = single step)
 
     // Settings state
-    int8_t _settingsSubItem; // 0-5 (Units, Angle Src, Auto-Zero, Thresh, Dir, Back)
+    int8_t _settingsSubItem; // 0-6 (Units, Angle Src, Auto-Zero, Thresh, Arm, Dir, Back)
     int8_t _settingsScrollOffset;
 
     // Stock selection state
@@ -80,6 +95,7 @@ private:
     float _tempDia;
     float _tempKerf;
     float _tempAZThresh;
+    uint16_t _tempAZArm;
     uint8_t _tempCutMode;
     float _tempRate; // For editing hourly rate
 
@@ -97,6 +113,7 @@ private:
     void handleCalibrationSubmenu(InputEvent e);
     void handleSettingsSubmenu(InputEvent e);
     void handleAutoCalib(InputEvent e, EncoderSys *encoder);
+    void handleMultiCalib(InputEvent e, EncoderSys *encoder);
     void handleAngleWizard(InputEvent e);
     void handleStockSelect(InputEvent e);
     void handleEdit(InputEvent e);
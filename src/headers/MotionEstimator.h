@@ -0,0 +1,67 @@
+#ifndef MOTIONESTIMATOR_H
+#define MOTIONESTIMATOR_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// M/T VELOCITY ESTIMATOR
+// ============================================================================
+// Runs at a fixed rate from an ISR. Each sample it gets the current count and
+// the most recent input-capture edge (count at the edge + its timestamp).
+//
+// Velocity = counts between two captured edges / exact time between them.
+// - Low speed: one edge per several samples -> pure T-method (edge period).
+// - High speed: many edges per sample -> count difference over the time between
+//   the last edges of consecutive windows (M/T), no sample-clock quantization.
+// - Only captured edges are reference points. A sample time is never used as
+//   one: the count there lies anywhere inside a count period, and the next
+//   M/T step would be measured from a false position.
+// - Between edges the edge estimate stands while the counter agrees with it.
+//   Starting from rest or reversing inside one capture period has no edge
+//   pair yet: the sample-window count difference stands in until there is.
+// - No edge: velocity is bounded by "one edge could have happened just now" and
+//   decays to zero after MOTION_STOP_US.
+// - Acceleration comes from consecutive edge estimates (their interval
+//   midpoints), so sample-clock steps never show up as acceleration.
+//
+// Units: velocity in counts/s as Q8 (x256), acceleration in counts/s^2.
+// Pure integer math, no HAL: test/test_motion feeds it synthetic pulse trains.
+class MotionEstimator {
+public:
+    static const uint32_t MOTION_STOP_US = 200000; // No edge for 200 ms = stopped
+
+    MotionEstimator();
+
+    void reset(int64_t count, uint32_t nowUs, uint32_t edgeSeq);
+
+    // edgeSeq increments on every capture; edge* describe the latest one.
+    // True when this sample produced a new edge-pair estimate.
+    bool update(int64_t count, uint32_t nowUs, uint32_t sampleHz,
+                uint32_t edgeSeq, int64_t edgeCount, uint32_t edgeTimeUs);
+
+    int32_t getVelocityQ8() const { return _velocityQ8; }
+    int32_t getAccel() const { return _accel; }              // Smoothed
+    int32_t getEdgeAccel() const { return _edgeAccel; }      // Last two edge estimates, unsmoothed
+
+private:
+    // Reference point: the last captured edge (position/time known exactly)
+    int64_t _refCount;
+    uint32_t _refTimeUs;
+    bool _refValid;      // False until the first edge after reset()
+    uint32_t _edgeSeq;
+    int64_t _lastCount;
+    int32_t _refSpacing; // Counts between the last two reference points
+
+    volatile int32_t _velocityQ8;
+    volatile int32_t _accel;
+    int32_t _edgeAccel;
+
+    // Last edge estimate, for the acceleration
+    int32_t _edgeVelocityQ8;
+    uint32_t _edgeMidUs; // Midpoint of the interval it was measured over
+    bool _edgeVelocityValid;
+
+    void edgeVelocity(int32_t velocityQ8, uint32_t midUs);
+};
+
+#endif // MOTIONESTIMATOR_H
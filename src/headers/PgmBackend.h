@@ -0,0 +1,39 @@
+#ifndef PGMBACKEND_H
+#define PGMBACKEND_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "LcdFrame.h"
+#include "Framebuffer.h"
+
+// ============================================================================
+// HOST FRAMEBUFFER WITH PGM DUMPS (DISPLAY_TYPE 2, [env:native] only)
+// ============================================================================
+// The OLED backend without the panel: pump() moves the framebuffer's dirty
+// windows, in the same OLED_SLICE_BYTES slices, into a copy of panel RAM
+// (the glass). writePgm() saves the glass as a binary PGM, so screens can be
+// compared with golden images under test/ and looked at in any image viewer.
+class PgmBackend {
+public:
+    PgmBackend();
+
+    void begin();
+    void clearScreen(); // Blocking; caller marks the frame cleared
+
+    void beginFrame(LcdFrame *frame);
+    void pump();
+    bool isIdle() const { return _fb.isClean(); }
+
+    uint32_t getErrors() const { return 0; }
+    uint32_t getGlyphUploads() const { return 0; }
+
+    // What the panel would show: 128x64, lit pixels 255, dark 0
+    uint8_t getPixel(uint8_t x, uint8_t y) const { return ((_glass[y >> 3][x] >> (y & 7)) & 1) ? 255 : 0; }
+    bool writePgm(const char *path) const; // False if the file can't be written
+
+private:
+    Framebuffer _fb;
+    uint8_t _glass[OLED_PAGES][OLED_WIDTH];
+};
+
+#endif // PGMBACKEND_H
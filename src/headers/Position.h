@@ -0,0 +1,30 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// FIXED-POINT POSITION
+// ============================================================================
+// All measured lengths are integer micrometres. int32 covers +/-2147 m, far more
+// than a reading that is re-zeroed on every cut. Long-running totals use int64.
+// Floats only appear at the edges (user-entered settings, menu text).
+typedef int32_t PositionUM;
+
+#define UM_PER_MM 1000L
+#define UM_PER_INCH 25400L
+
+inline PositionUM mmToUM(float mm) {
+    return (PositionUM)lroundf(mm * (float)UM_PER_MM);
+}
+
+inline float umToMM(PositionUM um) {
+    return um / (float)UM_PER_MM;
+}
+
+// Integer division rounded half away from zero (b > 0)
+inline int32_t divRound(int32_t a, int32_t b) {
+    return (a >= 0) ? (a + b / 2) / b : -((-a + b / 2) / b);
+}
+
+#endif // POSITION_H
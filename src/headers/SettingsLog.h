@@ -0,0 +1,94 @@
+#ifndef SETTINGSLOG_H
+#define SETTINGSLOG_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+#define SETTINGS_LOG_RECORD_WORDS (2 + STORAGE_MAX_PAYLOAD / 4 + 1) // Header, seq, payload, CRC
+
+// ============================================================================
+// APPEND-ONLY SETTINGS LOG (two internal flash sectors)
+// ============================================================================
+// Every save appends a full snapshot as a record; the newest record that
+// checks out wins. Flash bits only go 1 -> 0, so nothing is rewritten in
+// place and a record is only erased with its whole sector.
+//
+// Sector:  [SECTOR_MAGIC][generation] record record record ... 0xFF...
+// Record:  [RECORD_MAGIC | version << 16 | length][sequence][payload][CRC32]
+//
+// The CRC covers header, sequence and payload and is programmed last, so a
+// record cut short by power loss fails it and the previous one is used. A
+// header that makes no sense ends the scan: the rest of that sector is
+// treated as used.
+//
+// When the active sector is full the newest record is copied to the other
+// (blank) sector, and that sector's header is written last with the next
+// generation: until then the old sector stays the active one.
+//
+// Timing: the loop programs STORAGE_WORDS_PER_STEP words per pass, so a save
+// never holds the loop for long; save() itself only copies. Erasing a sector
+// blocks for 1-2 s with every ISR frozen (see InternalFlash.h), so it is never
+// done from update(): begin() clears the spare before the watchdog runs, and
+// after a compaction the owner calls eraseSpare() at a quiet moment once
+// isEraseDue() says the active sector is past STORAGE_ERASE_AHEAD_BYTES -
+// about 450 saves before the spare is needed. Should it still be dirty when
+// the active sector fills, the save waits in RAM and isStalled() reports it.
+class SettingsLog {
+public:
+    SettingsLog();
+
+    // Boot (blocking, before the watchdog): finds the newest record, copies it
+    // to data if it is exactly len bytes of this version. False = keep defaults.
+    bool begin(void *data, uint16_t len, uint8_t version);
+
+    void save(const void *data); // Snapshot of len bytes; written by update()
+    void update();               // Every loop pass
+    void eraseSpare();           // Blocking; only with nothing to measure (menu entry)
+
+    bool isIdle() const { return _phase == LOG_IDLE && !_pending; }
+    bool isEraseDue() const; // eraseSpare() would erase, and the active sector is filling
+    bool isStalled() const;  // Saves are not reaching flash (waiting for an erase, or no log)
+    uint32_t getSequence() const { return _sequence; }
+    uint32_t getErrors() const { return _errors; }
+    uint16_t getCompactions() const { return _compactions; }
+
+private:
+    enum Phase { LOG_IDLE, LOG_PROGRAM };
+
+    uint16_t _len;
+    uint8_t _version;
+    bool _ready;        // begin() found or made a usable sector
+
+    uint8_t _active;    // 0 = sector A, 1 = sector B
+    uint32_t _generation;
+    uint32_t _writeOffset; // Next free byte in the active sector
+    bool _spareBlank;
+    bool _spareNeeded;  // Spare holds the only good record (boot found it there)
+    bool _eraseFailed;  // Run-time erase gave up until the next boot
+
+    uint32_t _sequence; // Last record written or found
+    uint8_t _latest[STORAGE_MAX_PAYLOAD];
+    bool _pending;
+
+    // Words being programmed: a record, then (compaction) the sector header
+    Phase _phase;
+    uint32_t _words[SETTINGS_LOG_RECORD_WORDS + 2];
+    uintptr_t _addr[SETTINGS_LOG_RECORD_WORDS + 2];
+    uint8_t _wordCount;
+    uint8_t _wordNext;
+    bool _compacting;
+    uint32_t _compactEnd; // Write offset in the new sector once done
+
+    uint32_t _errors;
+    uint16_t _compactions;
+
+    uint16_t recordBytes() const { return (uint16_t)((3 + (_len + 3) / 4) * 4); }
+    uintptr_t sectorAddr(uint8_t which) const;
+    uint8_t sectorNumber(uint8_t which) const;
+    bool sectorHeader(uint8_t which, uint32_t *generation) const;
+    uint32_t scan(uint8_t which, uint32_t *bestSeq, uintptr_t *bestAddr) const;
+    bool isBlank(uint8_t which) const;
+    void startRecord();
+};
+
+#endif // SETTINGSLOG_H
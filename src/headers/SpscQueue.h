@@ -0,0 +1,74 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <Arduino.h>
+
+// Compiler barrier: keeps the slot write/read on the right side of the index
+// update. Single core (M4 / AVR), so no hardware fence is needed between an
+// ISR and the main loop.
+#define SPSC_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+// Reading the other side's index / publishing our own. Plain volatile accesses
+// on the target; host tests run the two sides as threads on separate cores,
+// where they have to be acquire / release.
+#if defined(ARDUINO)
+#define SPSC_ACQUIRE(index) (index)
+#define SPSC_RELEASE(index, value) ((index) = (value))
+#else
+#define SPSC_ACQUIRE(index) __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+#define SPSC_RELEASE(index, value) __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
+#endif
+
+// ============================================================================
+// SINGLE-PRODUCER / SINGLE-CONSUMER QUEUE
+// ============================================================================
+// Lock-free ring between exactly one writer (an ISR) and one reader (the main
+// loop). Head is only written by push(), tail only by pop(), both free-running
+// 8-bit counters: fill = head - tail, wrap is implicit.
+// A full queue rejects the new item (the oldest events stay in order) and the
+// caller counts the loss.
+template <typename T, uint8_t N>
+class SpscQueue {
+public:
+    static_assert(N > 0 && N <= 128 && (N & (N - 1)) == 0, "Queue size must be a power of two up to 128");
+
+    SpscQueue() : _head(0), _tail(0) {}
+
+    // Producer side
+    bool push(const T &item) {
+        uint8_t head = _head;
+        if ((uint8_t)(head - SPSC_ACQUIRE(_tail)) >= N) {
+            return false;
+        }
+        _buf[head & (N - 1)] = item;
+        SPSC_BARRIER();
+        SPSC_RELEASE(_head, (uint8_t)(head + 1));
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T *item) {
+        uint8_t tail = _tail;
+        if (tail == SPSC_ACQUIRE(_head)) {
+            return false;
+        }
+        SPSC_BARRIER();
+        *item = _buf[tail & (N - 1)];
+        SPSC_BARRIER();
+        SPSC_RELEASE(_tail, (uint8_t)(tail + 1));
+        return true;
+    }
+
+    uint8_t size() const { return (uint8_t)(SPSC_ACQUIRE(_head) - SPSC_ACQUIRE(_tail)); }
+    bool isEmpty() const { return SPSC_ACQUIRE(_head) == SPSC_ACQUIRE(_tail); }
+
+    // Consumer side only
+    void clear() { SPSC_RELEASE(_tail, SPSC_ACQUIRE(_head)); }
+
+private:
+    T _buf[N];
+    volatile uint8_t _head;
+    volatile uint8_t _tail;
+};
+
+#endif // SPSCQUEUE_H
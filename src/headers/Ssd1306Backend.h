@@ -0,0 +1,38 @@
+#ifndef SSD1306BACKEND_H
+#define SSD1306BACKEND_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "LcdFrame.h"
+#include "Framebuffer.h"
+
+// ============================================================================
+// 128x64 SSD1306 / SH1106 OLED (SPI1)
+// ============================================================================
+// Shows the same 20x4 screen as the character LCD, rasterised by Framebuffer.
+//
+// Partial updates: beginFrame() only rasterises the frame's dirty cells, and
+// pump() sends the framebuffer's dirty column windows in page addressing mode
+// (supported by both controllers), at most OLED_SLICE_BYTES per call.
+class Ssd1306Backend {
+public:
+    Ssd1306Backend();
+
+    void begin();
+    void clearScreen(); // Blocking; caller marks the frame cleared
+
+    void beginFrame(LcdFrame *frame);
+    void pump();
+    bool isIdle() const { return _fb.isClean(); }
+
+    uint32_t getErrors() const { return 0; } // SPI has no acknowledge to fail
+    uint32_t getGlyphUploads() const { return 0; }
+
+private:
+    Framebuffer _fb;
+
+    void sendCommands(const uint8_t *cmds, uint8_t n);
+    uint16_t sendWindow(uint8_t page, uint16_t budget);
+};
+
+#endif // SSD1306BACKEND_H
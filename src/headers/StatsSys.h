@@ -3,9 +3,10 @@
 
 #include <Arduino.h>
 #include "Storage.h"
+#include "Position.h"
 
 // Minimum length to register a cut (prevent false positives)
-#define MIN_CUT_LENGTH_MM 20.0
+#define MIN_CUT_LENGTH_UM 20000L // 20 mm
 
 class StatsSys {
 public:
@@ -13,8 +14,10 @@ public:
     void init(SystemSettings* settings);
     void update(); // Call in main loop for time tracking
     
-    // Call this when user ZEROs the system
-    void registerCut(float lengthMM);
+    // Call this when user ZEROs the system. Returns false if the cut was not
+    // counted (too short, or rejected because the measurement is suspect).
+    bool registerCut(PositionUM lengthUM, bool suspect = false);
+    unsigned long getRejectedCuts();
     
     void resetProject();
     
@@ -40,7 +43,8 @@ public:
 
 private:
     SystemSettings* _settings;
-    float _lastCutLen; // Store last cut length
+    PositionUM _lastCutUM; // Store last cut length
+    unsigned long _rejectedCuts; // Suspect measurements refused since boot
 };
 
 #endif // STATSSYS_H
@@ -2,6 +2,11 @@
 #define STORAGE_H
 
 #include <Arduino.h>
+#include "Config.h"
+
+// Bump when a SystemSettings field changes meaning: records saved by older
+// firmware are then ignored (a size change is caught anyway)
+#define SETTINGS_LAYOUT_VERSION 1
 
 struct SystemSettings
 {
@@ -9,14 +14,22 @@ struct SystemSettings
     bool isInch = false;
     bool reverseDirection = false;
     unsigned long totalCuts = 0;
-    float totalLengthMeters = 0.0;
+    int64_t totalLengthUM = 0;   // Micrometres, integer so totals never drift
     unsigned long projectCuts = 0;
-    float projectLengthMeters = 0.0;
+    int64_t projectLengthUM = 0;
 
     // Phase 2 Settings
     float kerfMM = 0.0;
     bool autoZeroEnabled = false;
     float autoZeroThresholdMM = 5.0;
+    uint16_t autoZeroArmMs = 500;   // Stillness time before arming
+    float autoZeroBandMM = 2.0;     // Stillness band (hysteresis)
+    uint16_t targetLeadMs = 20;     // Target alarm look-ahead (actuator + reaction latency)
+
+    // Multi-point wheel correction: raw counts and real length of each reference cut
+    uint8_t calibPointCount = 0;
+    int32_t calibCounts[CALIB_MAX_POINTS] = {0};
+    int32_t calibRealUM[CALIB_MAX_POINTS] = {0};
     uint8_t cutMode = 0;
     float cutAngle = 45.0;
     uint8_t stockType = 0;
@@ -25,8 +38,8 @@ struct SystemSettings
 
     // Phase 3 Settings (Angle Sensor)
     uint8_t lastAngle = 45;
-    uint16_t angleRawZero = 0;
-    uint16_t angleRaw45 = 512;
+    uint8_t angleCalibCount = 0;                        // 0 = uncalibrated (512 counts per 45 deg)
+    uint16_t angleCalibRaw[ANGLE_CALIB_POINTS] = {0};   // Raw reading at i * ANGLE_CALIB_STEP_DEG
     bool useAngleSensor = false;
 
     // Time & Cost
@@ -37,4 +50,18 @@ struct SystemSettings
 
 };
 
+// ============================================================================
+// PERSISTENCE (internal flash log, see SettingsLog)
+// ============================================================================
+class Storage {
+public:
+    static bool load(SystemSettings &settings);       // Boot, before the watchdog. False = defaults kept
+    static void save(const SystemSettings &settings); // Instant: a snapshot, written by update()
+    static void update();                             // Every loop pass: a few flash words
+    static void eraseSpare();                         // Blocks 1-2 s for a sector erase: only when idle
+    static bool isEraseDue();                         // eraseSpare() has work, better done now than later
+    static bool isStalled();                          // Saves are held in RAM, not reaching flash
+    static bool isIdle();                             // Nothing left to write
+};
+
 #endif // STORAGE_H
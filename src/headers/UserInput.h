@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "Config.h"
+#include "SpscQueue.h"
 
 enum InputEvent {
     EVENT_NONE,
@@ -24,6 +25,13 @@ inline InputEvent toSemanticEvent(InputEvent raw) {
     return raw;  // CLICK, LONG_PRESS, etc. pass through unchanged
 }
 
+// One queued input event
+struct InputRecord {
+    InputEvent event;
+    uint32_t timeMs; // millis() when the ISR detected it
+    uint8_t steps;   // Knob acceleration: how many value steps this detent is worth (1 = none)
+};
+
 class UserInput {
 public:
     UserInput();
@@ -32,13 +40,32 @@ public:
     // Called from Timer1 ISR (1kHz)
     void isrTick();
     
-    // Called from Main Loop to get latest event
+    // Called from Main Loop: oldest queued event, EVENT_NONE when empty
     InputEvent getEvent();
 
+    // Called from Main Loop: pop the oldest event with its timestamp.
+    // Returns false when the queue is empty - loop until then to drain it.
+    bool pollEvent(InputRecord *record);
+
+    // Events dropped because the queue was full (loop stalled too long)
+    uint32_t getOverflowCount() const { return _overflows; }
+
 private:
     // Rotary Encoder State
-    volatile uint8_t _lastEncoded;
-    volatile int _encoderValue;
+    volatile uint8_t _lastEncoded;   // (DT << 1) | CLK at the last decoded transition
+    volatile int16_t _knobSteps;     // Free-running quarter steps, written by the decoder only
+    int16_t _knobConsumed;           // Steps already turned into events (tick side)
+    bool _knobExti;                  // Decoder runs on pin change instead of in the tick
+    uint32_t _lastDetentMs;          // Acceleration: time and direction of the last detent
+    InputEvent _lastDetentEvent;
+
+    // Direct port access: CLK/DT/SW in a single input register read
+#if defined(STM32F4xx)
+    GPIO_TypeDef *_knobPort;
+    uint32_t _clkMask;
+    uint32_t _dtMask;
+    uint32_t _swMask;
+#endif
     
     // Button Debounce State
     volatile uint16_t _btnState; // Shift register for debounce
@@ -47,11 +74,19 @@ private:
     volatile bool _longPressHandled;
     volatile bool _superLongPressHandled;
     
-    // Event Buffer (Simple 1-item buffer for now)
-    volatile InputEvent _pendingEvent;
+    // Event queue: ISR produces, main loop consumes
+    SpscQueue<InputRecord, INPUT_QUEUE_SIZE> _queue;
+    volatile uint32_t _overflows;
     
+    static UserInput* _isrInstance;
+    static void knobISR();
+
+    uint8_t readPins(); // bit0 = CLK, bit1 = DT, bit2 = SW
+    void decodeKnob(uint8_t pins);
     void handleEncoder();
-    void handleButton();
+    void handleButton(bool pinVal);
+    void postDetent(InputEvent e);
+    void postEvent(InputEvent e, uint8_t steps = 1);
 };
 
 #endif // USERINPUT_H
@@ -14,7 +14,9 @@
 #include "headers/Storage.h"
 #include "headers/MenuSys.h"
 #include "headers/StatsSys.h"
+#include "headers/AutoZeroSys.h"
 #include "headers/AngleSensor.h" // Added
+#include "headers/I2CBus.h"
 
 // ============================================================================
 // GLOBAL OBJECTS
@@ -24,22 +26,12 @@ DisplaySys displaySys;
 UserInput userInput;
 MenuSys menuSys;
 StatsSys statsSys;
+AutoZeroSys autoZeroSys;
 AngleSensor angleSensor; // Added
 SystemSettings settings;
 
 SystemState currentState = STATE_IDLE;
 
-// Auto-Zero State Machine
-enum AutoZeroState
-{
-    AZ_DISABLED,
-    AZ_MEASURING,
-    AZ_ARMED
-};
-AutoZeroState azState = AZ_DISABLED;
-float lockedPosition = 0.0;
-unsigned long stillnessStartTime = 0;
-
 // Double-click detection
 unsigned long lastClickTime = 0;
 const unsigned long DOUBLE_CLICK_WINDOW = 500; // 500ms
@@ -47,6 +39,9 @@ const unsigned long DOUBLE_CLICK_WINDOW = 500; // 500ms
 // Hidden menu state
 bool hiddenMenuActive = false;
 
+// Last input, motion or alarm in the idle screen (spare sector erase timing)
+unsigned long lastActivityMs = 0;
+
 // ============================================================================
 // INTERRUPT SERVICE ROUTINES
 // ============================================================================
@@ -56,6 +51,9 @@ bool hiddenMenuActive = false;
 void Timer1_Callback()
 {
     userInput.isrTick();
+    encoderSys.sampleISR();
+    autoZeroSys.sampleISR(encoderSys.getDistanceUM(), encoderSys.getVelocityUMs(), millis());
+    angleSensor.tickISR();
 }
 HardwareTimer *tickTimer = nullptr;
 #else
@@ -63,6 +61,9 @@ HardwareTimer *tickTimer = nullptr;
 ISR(TIMER1_COMPA_vect)
 {
     userInput.isrTick();
+    encoderSys.sampleISR();
+    autoZeroSys.sampleISR(encoderSys.getDistanceUM(), encoderSys.getVelocityUMs(), millis());
+    angleSensor.tickISR();
 }
 #endif
 
@@ -148,6 +149,75 @@ uint8_t getFaceValue()
     }
 }
 
+// Idle-screen reaction to one queued input event
+void handleIdleEvent(const InputRecord &input)
+{
+    if (input.event == EVENT_SUPER_LONG_PRESS)
+    {
+        hiddenMenuActive = true;
+    }
+    else if (input.event == EVENT_CLICK)
+    {
+        // Double-click detection (on ISR timestamps: a late loop can't stretch the gap)
+        unsigned long now = input.timeMs;
+        if (now - lastClickTime < DOUBLE_CLICK_WINDOW)
+        {
+            // Double-click! Toggle mode (Straight <-> Angle)
+
+            if (settings.cutMode == 0)
+            {
+                settings.cutMode = settings.lastAngle;
+                if (settings.cutMode == 0)
+                    settings.cutMode = 45;
+            }
+            else
+            {
+                settings.lastAngle = settings.cutMode;
+                settings.cutMode = 0;
+            }
+            lastClickTime = 0;
+        }
+        else
+        {
+            // Single click: Register Cut + Zero
+            statsSys.registerCut(encoderSys.getDistanceUM(), encoderSys.isMeasurementSuspect());
+            encoderSys.reset();
+
+            if (settings.cutMode > 0)
+            {
+                float faceVal = (float)getFaceValue();
+                if (faceVal > 0)
+                {
+                    // One-off per click, float trig is fine here
+                    float rad = settings.cutMode * PI / 180.0;
+                    float offset = faceVal * tan(rad);
+                    encoderSys.setOffsetUM(mmToUM(offset));
+                }
+            }
+            lastClickTime = now;
+            autoZeroSys.disarm();
+        }
+    }
+    else if (input.event == EVENT_LONG_PRESS)
+    {
+        autoZeroSys.setEnabled(false); // Wheel moves freely in the menu (calibration)
+        encoderSys.clearTargetAlarm();
+        if (Storage::isStalled())
+        {
+            Storage::eraseSpare(); // Last resort, a save is waiting on it: nothing is measured in the menu
+        }
+        menuSys.init(&settings, &statsSys, &angleSensor);
+        currentState = STATE_MENU;
+    }
+    else if (input.event == EVENT_CW || input.event == EVENT_CCW)
+    {
+        if (!settings.useAngleSensor && settings.cutMode > 0 && settings.stockType == 0)
+        {
+            settings.faceIdx = (settings.faceIdx == 0) ? 1 : 0;
+        }
+    }
+}
+
 // ============================================================================
 // SETUP
 // ============================================================================
@@ -185,12 +255,20 @@ void setup()
 
     // 2. Initialize Subsystems (ORDER MATTERS FOR I2C)
 
-    // Display starts Wire.begin(), so it must be first!
-    Serial1.println("Initializing Display (20x4 LCD I2C)...");
+    // Shared I2C bus first: display and angle sensor both use it
+    i2cBus.begin();
+    if (i2cBus.getRecoveries() > 0)
+        Serial1.println("I2C bus was stuck - recovered");
+
+    Serial1.println("Initializing Display...");
     displaySys.init();
-    Serial1.println("Display OK (I2C Started)");
+    Serial1.println("Display OK");
 
-    Serial1.println("Settings initialized with defaults (no persistence)");
+    // Settings log: may erase its spare flash sector, so before the watchdog
+    if (Storage::load(settings))
+        Serial1.println("Settings loaded from flash");
+    else
+        Serial1.println("Settings initialized with defaults");
 
     Serial1.println("Initializing Angle Sensor...");
     if (settings.useAngleSensor)
@@ -198,6 +276,10 @@ void setup()
         if (angleSensor.init())
         {
             Serial1.println("Angle Sensor FOUND");
+            if (!angleSensor.isConnected())
+            {
+                Serial1.println("Angle Sensor MAGNET MISSING/WEAK/STRONG - Check Placement");
+            }
         }
         else
         {
@@ -209,14 +291,26 @@ void setup()
     {
         Serial1.println("Angle Sensor DISABLED (Manual Mode)");
     }
+    if (settings.angleCalibCount >= 2)
+        angleSensor.setCalibration(settings.angleCalibRaw, settings.angleCalibCount);
 
-    Serial1.println("Initializing Encoder (TIM4 Hardware)...");
+    Serial1.print("Initializing Encoder (");
+    Serial1.print(encoderSys.getBackendName());
+    Serial1.println(")...");
     encoderSys.init();
     Serial1.println("Encoder init OK");
 
     encoderSys.setWheelDiameter(settings.wheelDiameter);
+    encoderSys.setCorrectionPoints(settings.calibCounts, settings.calibRealUM, settings.calibPointCount);
     Serial1.println("Encoder calibrated");
 
+#if FEED_LOG_SERIAL
+    if (encoderSys.startFeedCapture(FEED_CAPTURE_HZ))
+        Serial1.println("Feed capture logging ON");
+    else
+        Serial1.println("Feed capture unavailable");
+#endif
+
     Serial1.println("Initializing User Input (KY-040)...");
     userInput.init();
     Serial1.println("UserInput OK");
@@ -233,7 +327,8 @@ void setup()
     Serial1.println("Configuring TIM3 for 1kHz tick...");
 #if defined(STM32F4xx)
     tickTimer = new HardwareTimer(TIM3);
-    tickTimer->setOverflow(1000, HERTZ_FORMAT);
+    tickTimer->setInterruptPriority(TIMER_IRQ_PRIORITY, 0); // Same as the encoder timer
+    tickTimer->setOverflow(SYSTEM_TICK_HZ, HERTZ_FORMAT);
     tickTimer->attachInterrupt(Timer1_Callback);
     tickTimer->resume();
     Serial1.println("TIM3 OK");
@@ -252,7 +347,7 @@ void setup()
     // 4. Enable Watchdog Timer (2 Seconds)
     Serial1.println("Enabling Watchdog (2s timeout)...");
 #if defined(STM32F4xx)
-    IWatchdog.begin(2000000);
+    IWatchdog.begin(WATCHDOG_TIMEOUT_MS * 1000UL);
     Serial1.println("Watchdog OK");
 #else
     wdt_enable(WDTO_2S);
@@ -263,6 +358,37 @@ void setup()
     Serial1.println("========================================");
 }
 
+#if FEED_LOG_SERIAL
+// Drain the feed capture ring in batches and stream a decimated profile
+void logFeed()
+{
+    static FeedSample batch[32];
+    static uint32_t sampleIndex = 0;
+    static uint32_t lastOverruns = 0;
+
+    uint16_t n;
+    while ((n = encoderSys.drainFeed(batch, 32)) > 0)
+    {
+        for (uint16_t i = 0; i < n; i++, sampleIndex++)
+        {
+            if (sampleIndex % FEED_LOG_DECIMATE != 0)
+                continue;
+            Serial1.print(batch[i].timestampUs);
+            Serial1.print(',');
+            Serial1.println((long)batch[i].count);
+        }
+    }
+
+    uint32_t overruns = encoderSys.getFeedOverruns();
+    if (overruns != lastOverruns)
+    {
+        Serial1.print("# feed overrun, lost ");
+        Serial1.println(overruns - lastOverruns);
+        lastOverruns = overruns;
+    }
+}
+#endif
+
 // ============================================================================
 // MAIN LOOP
 // ============================================================================
@@ -274,15 +400,14 @@ void loop()
     wdt_reset();
 #endif
 
-    // 1. Handle User Input
-    InputEvent event = userInput.getEvent();
+    i2cBus.startPass(); // Fresh bus budget for this pass
 
-    // 2. State Machine
+    // State Machine (each state drains the input queue itself)
     switch (currentState)
     {
     case STATE_IDLE:
     {
-        // Angle Sensor Logic
+        // Angle Sensor Logic (filtered value from the background sampler, no I2C here)
         if (settings.useAngleSensor)
         {
             float deg = angleSensor.getAngleDegrees();
@@ -294,134 +419,102 @@ void loop()
             }
         }
 
-        // Get current measurement
-        float currentMM = encoderSys.getDistanceMM();
-        const char *stockStr = getStockString();
-        uint8_t faceVal = getFaceValue();
-
-        // Handle events
-        if (event == EVENT_SUPER_LONG_PRESS)
+        // Handle events: everything queued since the last pass, in order
+        InputRecord input;
+        bool anyInput = false;
+        while (currentState == STATE_IDLE && userInput.pollEvent(&input))
         {
-            hiddenMenuActive = true;
+            anyInput = true;
+            handleIdleEvent(input);
         }
-        else if (hiddenMenuActive && event == EVENT_NONE)
+        if (currentState != STATE_IDLE)
         {
-            hiddenMenuActive = false;
+            break; // Entered the menu: the rest of the queue belongs to it
         }
-        else if (event == EVENT_CLICK)
+        if (hiddenMenuActive && !anyInput)
         {
-            // Double-click detection
-            unsigned long now = millis();
-            if (now - lastClickTime < DOUBLE_CLICK_WINDOW)
-            {
-                // Double-click! Toggle mode (Straight <-> Angle)
-
-                if (settings.cutMode == 0)
-                {
-                    settings.cutMode = settings.lastAngle;
-                    if (settings.cutMode == 0)
-                        settings.cutMode = 45;
-                }
-                else
-                {
-                    settings.lastAngle = settings.cutMode;
-                    settings.cutMode = 0;
-                }
-                lastClickTime = 0;
-            }
-            else
-            {
-                // Single click: Register Cut + Zero
-                statsSys.registerCut(currentMM);
-                encoderSys.reset();
-
-                if (settings.cutMode > 0)
-                {
-                    float faceVal = (float)getFaceValue();
-                    if (faceVal > 0)
-                    {
-                        float rad = settings.cutMode * PI / 180.0;
-                        float offset = faceVal * tan(rad);
-                        encoderSys.setOffset(offset);
-                    }
-                }
-                lastClickTime = now;
-                azState = AZ_DISABLED;
-            }
+            hiddenMenuActive = false;
         }
-        else if (event == EVENT_LONG_PRESS)
+
+        // Spare sector erase: every ISR stops for 1-2 s, so only once the saw
+        // has been left alone for a while - long before a save needs the sector
+        unsigned long nowMs = millis();
+        if (anyInput || abs(encoderSys.getVelocityUMs()) > AZ_STILL_ENTER_UMS || encoderSys.isTargetAlarmActive())
         {
-            menuSys.init(&settings, &statsSys, &angleSensor);
-            currentState = STATE_MENU;
+            lastActivityMs = nowMs;
         }
-        else if (event == EVENT_CW || event == EVENT_CCW)
+        if (Storage::isEraseDue() && nowMs - lastActivityMs >= STORAGE_ERASE_STILL_MS)
         {
-            if (!settings.useAngleSensor && settings.cutMode > 0 && settings.stockType == 0)
-            {
-                settings.faceIdx = (settings.faceIdx == 0) ? 1 : 0;
-            }
+            Storage::eraseSpare();
+            lastActivityMs = millis();
         }
 
-        // Auto-Zero Logic
-        if (settings.autoZeroEnabled && settings.cutMode == 0 && !hiddenMenuActive)
+        // Get current measurement (after any zeroing above)
+        PositionUM currentUM = encoderSys.getDistanceUM();
+        const char *stockStr = getStockString();
+        uint8_t faceVal = getFaceValue();
+
+        // Auto-Zero: the engine arms/fires in the tick ISR, we only apply the cut
+        autoZeroSys.configure(settings.autoZeroArmMs, mmToUM(settings.autoZeroBandMM), mmToUM(settings.autoZeroThresholdMM));
+        autoZeroSys.setEnabled(settings.autoZeroEnabled && settings.cutMode == 0 && !hiddenMenuActive);
+
+        PositionUM autoCutUM;
+        if (autoZeroSys.takeCut(&autoCutUM))
         {
-            if (azState == AZ_DISABLED || azState == AZ_MEASURING)
-            {
-                if (abs(currentMM - lockedPosition) < 2.0)
-                {
-                    if (millis() - stillnessStartTime > 5000)
-                    {
-                        lockedPosition = currentMM;
-                        azState = AZ_ARMED;
-                    }
-                }
-                else
-                {
-                    stillnessStartTime = millis();
-                    lockedPosition = currentMM;
-                    azState = AZ_MEASURING;
-                }
-            }
-            else if (azState == AZ_ARMED)
-            {
-                if (abs(currentMM - lockedPosition) > settings.autoZeroThresholdMM)
-                {
-                    statsSys.registerCut(lockedPosition);
-                    long rawCount = encoderSys.getRawCount();
-                    float mmPerPulse = encoderSys.getWheelDiameter() * PI / PULSES_PER_REV;
-                    float absolutePosition = rawCount * mmPerPulse;
-                    float currentOffset = absolutePosition - currentMM;
-                    float newOffset = currentOffset + lockedPosition;
-                    encoderSys.setOffset(newOffset);
-                    azState = AZ_MEASURING;
-                    stillnessStartTime = millis();
-                }
-            }
+            statsSys.registerCut(autoCutUM, encoderSys.isMeasurementSuspect());
+            // Shift the zero to the locked position: exact, no count round-trip
+            encoderSys.setOffsetUM(encoderSys.getOffsetUM() + autoCutUM);
+            encoderSys.startMeasurement();
+            currentUM = encoderSys.getDistanceUM();
         }
 
         // Update display
-        float displayMM = (azState == AZ_ARMED) ? lockedPosition : currentMM;
+        PositionUM displayUM = (autoZeroSys.getState() == AutoZeroSys::AZ_ARMED) ? autoZeroSys.getLockedPosition() : currentUM;
         float targetMM = getTargetMM();
+
+        // Target-approach alarm (angle mode): fires from the encoder timer, not from here
+        if (targetMM > 0 && !hiddenMenuActive)
+        {
+            PositionUM targetUM = settings.isInch ? (PositionUM)lroundf(targetMM * UM_PER_INCH) : mmToUM(targetMM);
+            encoderSys.setTargetAlarm(targetUM, settings.targetLeadMs);
+        }
+        else
+        {
+            encoderSys.clearTargetAlarm();
+        }
         
         if (hiddenMenuActive)
         {
-            displaySys.showHiddenInfo(settings.kerfMM, settings.wheelDiameter, settings.reverseDirection, settings.autoZeroEnabled);
+            displaySys.showHiddenInfo(settings.kerfMM, settings.wheelDiameter, settings.reverseDirection, settings.autoZeroEnabled,
+                                      encoderSys.getDiag(), statsSys.getRejectedCuts());
         }
         else
         {
-            displaySys.showIdle(displayMM, targetMM, settings.cutMode, settings.stockType, stockStr, faceVal, settings.isInch, settings.reverseDirection);
+            displaySys.setUnsaved(Storage::isStalled());
+            displaySys.showIdle(displayUM, encoderSys.getVelocityUMs(), targetMM, settings.cutMode, settings.stockType, stockStr, faceVal, settings.isInch, settings.reverseDirection);
         }
         break;
     }
 
     case STATE_MENU:
     {
-        InputEvent semanticEvent = toSemanticEvent(event);
-        if (!menuSys.update(semanticEvent, &displaySys, &encoderSys))
+        // Apply the whole burst, then render once (fast scrolling keeps up)
+        bool menuActive = true;
+        InputRecord input;
+        while (menuActive && userInput.pollEvent(&input))
+        {
+            menuActive = menuSys.handleEvent(toSemanticEvent(input.event), &displaySys, &encoderSys, input.steps);
+        }
+        if (menuActive)
+        {
+            menuActive = menuSys.update(EVENT_NONE, &displaySys, &encoderSys); // Timeout + redraw
+        }
+        if (!menuActive)
         {
             currentState = STATE_IDLE;
             encoderSys.setWheelDiameter(settings.wheelDiameter);
-            azState = AZ_DISABLED;
+            autoZeroSys.disarm();
+            Storage::save(settings); // Menu edits
         }
         break;
     }
@@ -440,6 +533,12 @@ void loop()
 
     // 3. Update Hardware Wrappers
     encoderSys.update();
+    angleSensor.update(); // One I2C read when a sample is due
     displaySys.update();
     statsSys.update();
+    Storage::update(); // A few flash words per pass
+
+#if FEED_LOG_SERIAL
+    logFeed();
+#endif
 }
@@ -0,0 +1,83 @@
+#include "headers/AngleCalibration.h"
+
+#define ANGLE_FIT_MAX_POINTS 8
+
+AngleCalibration::AngleCalibration() {
+    // Until fitted: 512 counts per 45 degrees from raw 0 (the old defaults)
+    uint16_t raw[2] = { 0, 512 };
+    fit(raw, 2, 45);
+}
+
+bool AngleCalibration::fit(const uint16_t *raw, uint8_t n, uint8_t stepDeg) {
+    if (n < 2 || n > ANGLE_FIT_MAX_POINTS || stepDeg == 0) {
+        return false;
+    }
+
+    int16_t first = angleWrapDiff(raw[0], raw[1]);
+    if (first == 0) {
+        return false;
+    }
+    int8_t dir = (first > 0) ? 1 : -1;
+
+    // Unwrap: distance from the 0-degree reading, strictly increasing
+    int32_t px[ANGLE_FIT_MAX_POINTS];
+    px[0] = 0;
+    for (uint8_t i = 1; i < n; i++) {
+        px[i] = px[i - 1] + dir * angleWrapDiff(raw[i - 1], raw[i]);
+        if (px[i] <= px[i - 1]) {
+            return false; // Out of order, or two captures at the same reading
+        }
+    }
+    if (px[n - 1] >= ANGLE_RAW_COUNTS / 2) {
+        return false; // Half a turn or more: distances would alias
+    }
+
+    // Smallest power-of-two segment length that spans the captured range
+    uint8_t shift = 0;
+    while (((int32_t)ANGLE_TABLE_SEGMENTS << shift) < px[n - 1]) {
+        shift++;
+    }
+
+    // Sample the piecewise-linear fit at every node
+    uint8_t seg = 1;
+    for (uint8_t k = 0; k <= ANGLE_TABLE_SEGMENTS; k++) {
+        int32_t x = (int32_t)k << shift;
+        while (seg < n - 1 && x > px[seg]) {
+            seg++;
+        }
+        // Last segment is extended past the last capture
+        int32_t x0 = px[seg - 1], x1 = px[seg];
+        int32_t y0 = (int32_t)(seg - 1) * stepDeg * 100;
+        int32_t y1 = (int32_t)seg * stepDeg * 100;
+        _nodeCd[k] = y0 + ((y1 - y0) * (x - x0)) / (x1 - x0);
+    }
+
+    _rawZero = raw[0];
+    _dir = dir;
+    _shift = shift;
+    return true;
+}
+
+int32_t AngleCalibration::toCentiDeg(uint16_t raw) const {
+    int32_t pos = _dir * angleWrapDiff(_rawZero, raw);
+    int32_t span = (int32_t)1 << _shift;
+
+    if (pos < 0) {
+        // Below 0 degrees: keep the first slope
+        return _nodeCd[0] + ((_nodeCd[1] - _nodeCd[0]) * pos) / span;
+    }
+
+    int32_t idx = pos >> _shift;
+    int32_t frac = pos & (span - 1);
+    if (idx < ANGLE_TABLE_SEGMENTS) {
+        int32_t y0 = _nodeCd[idx];
+        int32_t y1 = _nodeCd[idx + 1];
+        return y0 + ((y1 - y0) * frac) / span;
+    }
+
+    // Past the table: keep the last slope
+    int32_t y0 = _nodeCd[ANGLE_TABLE_SEGMENTS];
+    int32_t slope = y0 - _nodeCd[ANGLE_TABLE_SEGMENTS - 1]; // per segment
+    int32_t beyond = pos - ((int32_t)ANGLE_TABLE_SEGMENTS << _shift);
+    return y0 + (slope * beyond) / span;
+}
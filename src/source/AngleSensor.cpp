@@ -1,96 +1,89 @@
 #include "headers/AngleSensor.h"
 
-#define AS5600_ADDR 0x36
-#define REG_RAW_ANGLE 0x0C
-#define REG_STATUS 0x0B
-
 AngleSensor::AngleSensor() {
     _lastDegrees = 0.0;
-    _rawZero = 0;
-    _raw45 = 512;
+    _sampleDue = false;
+    _tickDiv = 0;
+    _historyCount = 0;
+    _emaQ4 = 0;
+    _sampleErrors = 0;
 }
 
 bool AngleSensor::init() {
 #ifdef USE_ANGLE_SENSOR
-    Wire.beginTransmission(AS5600_ADDR);
-    if (Wire.endTransmission() == 0) {
-        // Sensor found - using default calibration values
-        return true;
-    }
-#endif
+    return _chip.begin();
+#else
     return false;
+#endif
 }
 
 bool AngleSensor::isConnected() {
 #ifdef USE_ANGLE_SENSOR
-    Wire.beginTransmission(AS5600_ADDR);
-    return (Wire.endTransmission() == 0);
+    return _chip.readMagnet() == AS5600_MAGNET_OK;
 #else
     return false;
 #endif
 }
 
-uint16_t AngleSensor::readRegister12(uint8_t reg) {
-    Wire.beginTransmission(AS5600_ADDR);
-    Wire.write(reg);
-    Wire.endTransmission();
-    
-    Wire.requestFrom(AS5600_ADDR, 2);
-    if (Wire.available() >= 2) {
-        uint8_t high = Wire.read();
-        uint8_t low = Wire.read();
-        return (high << 8) | low;
+void AngleSensor::tickISR() {
+    if (++_tickDiv >= SYSTEM_TICK_HZ / ANGLE_SAMPLE_HZ) {
+        _tickDiv = 0;
+        _sampleDue = true;
     }
-    return 0;
 }
 
-uint16_t AngleSensor::getRawAngle() {
+void AngleSensor::update() {
 #ifdef USE_ANGLE_SENSOR
-    return readRegister12(REG_RAW_ANGLE);
-#else
-    return 0;
-#endif
-}
+    if (!_sampleDue) return;
+    _sampleDue = false;
 
-float AngleSensor::getAngleDegrees() {
-#ifdef USE_ANGLE_SENSOR
-    uint16_t raw = getRawAngle();
-    
-    // Handle wrap-around if needed (not implemented for simple pivot)
-    // Assuming sensor range is within 0-4095 without crossing 0
-    
-    // Map raw to degrees based on calibration
-    // Formula: Deg = (Raw - Zero) * (45 / (Raw45 - Zero))
-    
-    int32_t deltaRaw = (int32_t)raw - (int32_t)_rawZero;
-    int32_t rangeRaw = (int32_t)_raw45 - (int32_t)_rawZero;
-    
-    if (rangeRaw == 0) rangeRaw = 1; // Prevent divide by zero
-    
-    float degrees = (float)deltaRaw * 45.0 / (float)rangeRaw;
-    
-    // Clamp to reasonable values
-    if (degrees < 0) degrees = 0;
-    if (degrees > 90) degrees = 90;
-    
-    // Hysteresis / Smoothing
-    // Only update if change is > 0.2 degrees to prevent jitter
+    uint16_t raw;
+    if (!_chip.readAngle(&raw)) {
+        _sampleErrors++; // Keep the last value
+        return;
+    }
+
+    // Median of the last 3, unwrapped around the newest sample
+    _history[2] = _history[1];
+    _history[1] = _history[0];
+    _history[0] = raw;
+    if (_historyCount < 3) _historyCount++;
+
+    uint16_t median = raw;
+    if (_historyCount == 3) {
+        int16_t a = 0;
+        int16_t b = angleWrapDiff(raw, _history[1]);
+        int16_t c = angleWrapDiff(raw, _history[2]);
+        int16_t mid = max(min(a, b), min(max(a, b), c));
+        median = (uint16_t)(raw + mid) & 0x0FFF;
+    }
+
+    // EMA in x16 fixed point; the first sample seeds it
+    if (_historyCount == 1) {
+        _emaQ4 = median << 4;
+    } else {
+        int32_t step = (int32_t)angleWrapDiff(_emaQ4 >> 4, median) * 16 - (_emaQ4 & 0x0F);
+        _emaQ4 = (uint16_t)(_emaQ4 + step / (1 << ANGLE_EMA_SHIFT)); // uint16 wrap = 4096 x16
+    }
+
+    // Deadband: only publish moves over 0.2 degrees (cut mode rounds to whole degrees)
+    float degrees = toDegrees(getRawAngle());
     if (abs(degrees - _lastDegrees) > 0.2) {
         _lastDegrees = degrees;
     }
-    
-    return _lastDegrees;
-#else
-    return 0.0;
 #endif
 }
 
-void AngleSensor::setZeroPoint(uint16_t rawVal) {
-    _rawZero = rawVal;
-    // No persistence - calibration stored in RAM only
+float AngleSensor::toDegrees(uint16_t raw) const {
+    float degrees = _calib.toCentiDeg(raw) / 100.0;
+    
+    // Clamp to reasonable values
+    if (degrees < 0) degrees = 0;
+    if (degrees > 90) degrees = 90;
+    return degrees;
 }
 
-void AngleSensor::set45Point(uint16_t rawVal) {
-    _raw45 = rawVal;
-    // No persistence - calibration stored in RAM only
+bool AngleSensor::setCalibration(const uint16_t *raw, uint8_t n) {
+    // No persistence here - the caller keeps the points in SystemSettings
+    return _calib.fit(raw, n, ANGLE_CALIB_STEP_DEG);
 }
@@ -0,0 +1,73 @@
+#include "headers/As5600.h"
+#include "headers/I2CBus.h"
+
+#define POINTER_UNKNOWN 0xFF
+
+As5600::As5600() {
+    _pointer = POINTER_UNKNOWN;
+    _conf = 0;
+}
+
+bool As5600::readRegs(uint8_t reg, uint8_t *data, uint8_t n) {
+    // Leaves the pointer wherever the chip's auto-increment put it
+    _pointer = POINTER_UNKNOWN;
+    return i2cBus.writeRead(I2C_CLIENT_ANGLE, AS5600_I2C_ADDR, &reg, 1, data, n);
+}
+
+bool As5600::writeConf(uint16_t conf) {
+    uint8_t out[3] = { AS5600_REG_CONF, (uint8_t)(conf >> 8), (uint8_t)(conf & 0xFF) };
+    _pointer = POINTER_UNKNOWN;
+    return i2cBus.write(I2C_CLIENT_ANGLE, AS5600_I2C_ADDR, out, 3);
+}
+
+bool As5600::begin() {
+    uint8_t data[2];
+    if (!readRegs(AS5600_REG_CONF, data, 2)) return false;
+
+    // Keep the output stage bits (OUT pin unused here), set the rest
+    uint16_t conf = ((uint16_t)data[0] << 8) | data[1];
+    conf &= ~(AS5600_CONF_PM_MASK | AS5600_CONF_HYST_MASK | AS5600_CONF_SF_MASK |
+              AS5600_CONF_FTH_MASK | AS5600_CONF_WD);
+    conf |= (AS5600_HYSTERESIS << AS5600_CONF_HYST_POS) & AS5600_CONF_HYST_MASK;
+    conf |= (AS5600_SLOW_FILTER << AS5600_CONF_SF_POS) & AS5600_CONF_SF_MASK;
+    conf |= (AS5600_FAST_FILTER << AS5600_CONF_FTH_POS) & AS5600_CONF_FTH_MASK;
+
+    if (!writeConf(conf)) return false;
+    if (!readRegs(AS5600_REG_CONF, data, 2)) return false;
+    _conf = (((uint16_t)data[0] << 8) | data[1]) & 0x3FFF;
+    return _conf == conf;
+}
+
+bool As5600::readAngle(uint16_t *value) {
+    uint8_t data[2];
+    bool ok;
+    if (_pointer == AS5600_REG_ANGLE) {
+        ok = i2cBus.read(I2C_CLIENT_ANGLE, AS5600_I2C_ADDR, data, 2);
+    } else {
+        uint8_t reg = AS5600_REG_ANGLE;
+        ok = i2cBus.writeRead(I2C_CLIENT_ANGLE, AS5600_I2C_ADDR, &reg, 1, data, 2);
+    }
+    // A failed read may have left the chip mid-byte or reset it
+    _pointer = ok ? AS5600_REG_ANGLE : POINTER_UNKNOWN;
+    if (!ok) return false;
+
+    *value = ((data[0] << 8) | data[1]) & 0x0FFF;
+    return true;
+}
+
+bool As5600::readStatus(uint8_t *status) {
+    return readRegs(AS5600_REG_STATUS, status, 1);
+}
+
+As5600Magnet As5600::readMagnet() {
+    uint8_t status;
+    if (!readStatus(&status)) return AS5600_NO_RESPONSE;
+    if (!(status & AS5600_STATUS_MD)) return AS5600_MAGNET_MISSING;
+    if (status & AS5600_STATUS_ML) return AS5600_MAGNET_WEAK;
+    if (status & AS5600_STATUS_MH) return AS5600_MAGNET_STRONG;
+    return AS5600_MAGNET_OK;
+}
+
+bool As5600::readAgc(uint8_t *agc) {
+    return readRegs(AS5600_REG_AGC, agc, 1);
+}
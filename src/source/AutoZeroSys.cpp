@@ -0,0 +1,114 @@
+#include "headers/AutoZeroSys.h"
+
+AutoZeroSys::AutoZeroSys() {
+    _armDelayMs = AZ_DEFAULT_ARM_MS;
+    _bandUM = AZ_DEFAULT_BAND_UM;
+    _triggerUM = 5000;
+    _enabled = false;
+    _disarmRequest = false;
+
+    _state = AZ_DISABLED;
+    _lockedUM = 0;
+    restart();
+}
+
+void AutoZeroSys::configure(uint16_t armDelayMs, PositionUM bandUM, PositionUM triggerUM) {
+    _armDelayMs = armDelayMs;
+    _bandUM = bandUM;
+    _triggerUM = triggerUM;
+}
+
+void AutoZeroSys::setEnabled(bool enabled) {
+    _enabled = enabled;
+    if (!enabled && _state == AZ_CUT_PENDING) {
+        _state = AZ_DISABLED; // Drop an unconsumed cut
+    }
+}
+
+void AutoZeroSys::disarm() {
+    _disarmRequest = true;
+    if (_state == AZ_CUT_PENDING) {
+        _state = AZ_MEASURING; // Manual zero wins over an unconsumed auto-cut
+    }
+}
+
+bool AutoZeroSys::takeCut(PositionUM *lengthUM) {
+    if (_state != AZ_CUT_PENDING) {
+        return false;
+    }
+
+    // The ISR leaves CUT_PENDING alone, so main-side transitions out of it are race free
+    *lengthUM = _lockedUM;
+    _needAnchor = true;
+    _state = AZ_MEASURING;
+    return true;
+}
+
+void AutoZeroSys::restart() {
+    _needAnchor = true;
+    _anchorUM = 0;
+    _stillSinceMs = 0;
+    _still = false;
+}
+
+bool AutoZeroSys::classifyStill(int32_t velocityUMs) {
+    int32_t speed = (velocityUMs < 0) ? -velocityUMs : velocityUMs;
+    if (_still) {
+        _still = (speed <= AZ_STILL_EXIT_UMS);
+    } else {
+        _still = (speed < AZ_STILL_ENTER_UMS);
+    }
+    return _still;
+}
+
+void AutoZeroSys::sampleISR(PositionUM positionUM, int32_t velocityUMs, uint32_t nowMs) {
+    if (!_enabled) {
+        if (_state != AZ_CUT_PENDING) {
+            _state = AZ_DISABLED;
+        }
+        return;
+    }
+
+    if (_disarmRequest) {
+        _disarmRequest = false;
+        if (_state != AZ_CUT_PENDING) {
+            _state = AZ_MEASURING;
+            restart();
+        }
+    }
+
+    switch (_state) {
+        case AZ_DISABLED:
+            _state = AZ_MEASURING;
+            restart();
+            // fall through
+        case AZ_MEASURING: {
+            bool still = classifyStill(velocityUMs);
+            int32_t drift = positionUM - _anchorUM;
+            if (drift < 0) drift = -drift;
+
+            if (_needAnchor || !still || drift >= _bandUM) {
+                // (Re)start the stillness window here
+                _anchorUM = positionUM;
+                _stillSinceMs = nowMs;
+                _needAnchor = false;
+            } else if ((uint32_t)(nowMs - _stillSinceMs) >= _armDelayMs) {
+                _lockedUM = positionUM;
+                _state = AZ_ARMED;
+            }
+            break;
+        }
+
+        case AZ_ARMED: {
+            int32_t moved = positionUM - _lockedUM;
+            if (moved < 0) moved = -moved;
+            if (moved > _triggerUM) {
+                _state = AZ_CUT_PENDING; // Main loop picks it up via takeCut()
+            }
+            break;
+        }
+
+        case AZ_CUT_PENDING:
+            break;
+    }
+}
@@ -0,0 +1,56 @@
+#include "headers/BigFont.h"
+
+// Glyph codes (2-pixel bars throughout)
+#define BF_UP  GLYPH_BAR_UP  // Upper bar
+#define BF_LO  GLYPH_BAR_LO  // Lower bar
+#define BF_UL  GLYPH_BAR_UL  // Upper and lower bar
+#define BF_VL  GLYPH_BAR_VL  // Left bar, full height
+#define BF_CL  GLYPH_BAR_CL  // Left lower corner
+#define BF_CUL GLYPH_BAR_CUL // Left upper and lower corners
+#define BF_DP  GLYPH_DOT     // Decimal point
+#define BF__   ' '           // Blank (ROM space)
+
+// Top row carries the upper bar, the middle bar (bottom of the top cell) and
+// the upper verticals; bottom row the lower verticals and the bottom bar.
+// Const data stays in flash on the STM32.
+//
+// This is not LCDBigNumbers' VARIANT_2 cell table. The original init() loaded
+// these eight 2-pixel bars over the library's set, but the library's begin()
+// put its own set back on every return from the menu, so the digits changed
+// shape after the first menu visit. The table draws every digit from the bars
+// the original chose, the same way every time. test_bigfont pins each glyph
+// pixel for pixel.
+static const BigGlyph GLYPHS[] = {
+    { '0', 3, { { BF_VL, BF_UP, BF_VL }, { BF_VL, BF_LO, BF_VL } } },
+    { '1', 3, { { BF__,  BF__,  BF_VL }, { BF__,  BF__,  BF_VL } } },
+    { '2', 3, { { BF_UL, BF_UL, BF_VL }, { BF_VL, BF_LO, BF_CL } } },
+    { '3', 3, { { BF_UL, BF_UL, BF_VL }, { BF_LO, BF_LO, BF_VL } } },
+    { '4', 3, { { BF_VL, BF_LO, BF_VL }, { BF__,  BF__,  BF_VL } } },
+    { '5', 3, { { BF_VL, BF_UL, BF_CUL }, { BF_LO, BF_LO, BF_VL } } },
+    { '6', 3, { { BF_VL, BF_UL, BF_CUL }, { BF_VL, BF_LO, BF_VL } } },
+    { '7', 3, { { BF_UP, BF_UP, BF_VL }, { BF__,  BF__,  BF_VL } } },
+    { '8', 3, { { BF_VL, BF_UL, BF_VL }, { BF_VL, BF_LO, BF_VL } } },
+    { '9', 3, { { BF_VL, BF_UL, BF_VL }, { BF_LO, BF_LO, BF_VL } } },
+    { '-', 3, { { BF_LO, BF_LO, BF__  }, { BF__,  BF__,  BF__  } } },
+    { '.', 1, { { BF__ }, { BF_DP } } },
+    { ' ', 3, { { BF__,  BF__,  BF__  }, { BF__,  BF__,  BF__  } } },
+};
+
+const BigGlyph *bigFontGlyph(char c) {
+    if (c >= '0' && c <= '9') {
+        return &GLYPHS[c - '0'];
+    }
+    for (uint8_t i = 10; i < sizeof(GLYPHS) / sizeof(GLYPHS[0]); i++) {
+        if (GLYPHS[i].ch == c) return &GLYPHS[i];
+    }
+    return nullptr;
+}
+
+uint8_t bigFontWidth(const char *s) {
+    uint8_t width = 0;
+    for (; *s; s++) {
+        const BigGlyph *g = bigFontGlyph(*s);
+        if (g) width += g->width;
+    }
+    return width;
+}
@@ -0,0 +1,114 @@
+#include "headers/CalibrationTable.h"
+
+#define CALIB_FIT_MAX_POINTS 8
+
+CalibrationTable::CalibrationTable() {
+    clear();
+}
+
+void CalibrationTable::clear() {
+    _active = false;
+    for (uint8_t i = 0; i <= CALIB_TABLE_SEGMENTS; i++) {
+        _nodeUM[i] = 0;
+    }
+    _shift = 0;
+}
+
+bool CalibrationTable::fit(const int32_t *counts, const int32_t *errorUM, uint8_t n) {
+    _active = false;
+
+    // Collect usable points, sorted by distance (tiny n: insertion sort)
+    int64_t px[CALIB_FIT_MAX_POINTS + 1];
+    int64_t py[CALIB_FIT_MAX_POINTS + 1];
+    uint8_t m = 0;
+    px[m] = 0; // Zero distance, zero error
+    py[m] = 0;
+    m++;
+
+    for (uint8_t i = 0; i < n && m <= CALIB_FIT_MAX_POINTS; i++) {
+        int64_t c = (counts[i] < 0) ? -(int64_t)counts[i] : counts[i];
+        if (c == 0) continue;
+        int64_t e = (counts[i] < 0) ? -(int64_t)errorUM[i] : errorUM[i];
+
+        uint8_t j = m;
+        while (j > 1 && px[j - 1] > c) {
+            px[j] = px[j - 1];
+            py[j] = py[j - 1];
+            j--;
+        }
+        if (px[j - 1] == c) {
+            // Same distance twice: average the two readings
+            py[j - 1] = (py[j - 1] + e) / 2;
+            for (uint8_t k = j; k < m; k++) {
+                px[k] = px[k + 1];
+                py[k] = py[k + 1];
+            }
+            continue;
+        }
+        px[j] = c;
+        py[j] = e;
+        m++;
+    }
+
+    if (m < 2) {
+        clear();
+        return false;
+    }
+
+    // Smallest power-of-two segment length that spans the longest reference
+    int64_t maxC = px[m - 1];
+    uint8_t shift = 0;
+    while (((int64_t)CALIB_TABLE_SEGMENTS << shift) < maxC && shift < 30) {
+        shift++;
+    }
+
+    // Sample the piecewise-linear fit at every node
+    uint8_t seg = 1;
+    for (uint8_t k = 0; k <= CALIB_TABLE_SEGMENTS; k++) {
+        int64_t x = (int64_t)k << shift;
+        while (seg < m - 1 && x > px[seg]) {
+            seg++;
+        }
+        // Last segment is extended past the longest reference
+        int64_t x0 = px[seg - 1], y0 = py[seg - 1];
+        int64_t x1 = px[seg], y1 = py[seg];
+        int64_t y = y0 + ((y1 - y0) * (x - x0)) / (x1 - x0);
+
+        if (y > INT32_MAX) y = INT32_MAX;
+        if (y < -INT32_MAX) y = -INT32_MAX;
+        _nodeUM[k] = (int32_t)y;
+    }
+    _shift = shift;
+
+    _active = true;
+    return true;
+}
+
+int32_t CalibrationTable::correctionUM(int64_t counts) const {
+    if (!_active) {
+        return 0;
+    }
+
+    bool negative = counts < 0;
+    uint64_t c = negative ? (uint64_t)(-counts) : (uint64_t)counts;
+
+    uint64_t idx = c >> _shift;
+    int64_t frac = (int64_t)(c & ((1ULL << _shift) - 1));
+    int64_t y;
+
+    if (idx < CALIB_TABLE_SEGMENTS) {
+        int64_t y0 = _nodeUM[idx];
+        int64_t y1 = _nodeUM[idx + 1];
+        y = y0 + (((y1 - y0) * frac) >> _shift);
+    } else {
+        // Past the table: keep the last slope
+        int64_t y0 = _nodeUM[CALIB_TABLE_SEGMENTS];
+        int64_t slope = y0 - _nodeUM[CALIB_TABLE_SEGMENTS - 1]; // per segment
+        int64_t beyond = (int64_t)(c - ((uint64_t)CALIB_TABLE_SEGMENTS << _shift));
+        y = y0 + ((slope * beyond) >> _shift);
+    }
+
+    if (y > INT32_MAX) y = INT32_MAX;
+    if (y < -INT32_MAX) y = -INT32_MAX;
+    return negative ? -(int32_t)y : (int32_t)y;
+}
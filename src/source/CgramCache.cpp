@@ -0,0 +1,60 @@
+#include "headers/CgramCache.h"
+
+#define LCD_CMD_SETCGRAMADDR 0x40
+
+CgramCache::CgramCache() {
+    _uploads = 0;
+    reset();
+}
+
+void CgramCache::reset() {
+    for (uint8_t s = 0; s < CGRAM_SLOTS; s++) {
+        _slotGlyph[s] = 0;
+    }
+    for (uint8_t g = 0; g < GLYPH_COUNT; g++) {
+        _sendAs[g] = ' ';
+    }
+}
+
+int8_t CgramCache::findVictim(const uint8_t *refs) const {
+    for (uint8_t s = 0; s < CGRAM_SLOTS; s++) {
+        if (_slotGlyph[s] == 0) return s;
+    }
+    for (uint8_t s = 0; s < CGRAM_SLOTS; s++) {
+        if (refs[_slotGlyph[s] - GLYPH_BASE] == 0) return s;
+    }
+    return -1;
+}
+
+bool CgramCache::prepare(LcdFrame *frame, LcdTransport *out) {
+    uint8_t refs[GLYPH_COUNT];
+    frame->countGlyphs(refs);
+
+    for (uint8_t g = 0; g < GLYPH_COUNT; g++) {
+        if (refs[g] == 0 || _sendAs[g] != ' ') continue; // Unused or resident
+
+        int8_t slot = findVictim(refs);
+        if (slot < 0) continue; // More than 8 glyphs on screen: stays a space
+        if (out->room() < 9) return false;
+
+        if (_slotGlyph[slot] != 0) {
+            _sendAs[_slotGlyph[slot] - GLYPH_BASE] = ' ';
+        }
+        uint8_t code = GLYPH_BASE + g;
+        _slotGlyph[slot] = code;
+        _sendAs[g] = slot;
+
+        const uint8_t *pattern = glyphPattern(code);
+        out->command(LCD_CMD_SETCGRAMADDR | (slot << 3));
+        for (uint8_t i = 0; i < 8; i++) {
+            out->data(pattern[i]);
+        }
+        _uploads++;
+
+        // Address counter now points into CGRAM; cells already showing this
+        // code (drawn as spaces while it had no slot) must be resent
+        frame->cursorLost();
+        frame->invalidateCode(code);
+    }
+    return true;
+}
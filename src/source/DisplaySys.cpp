@@ -1,77 +1,80 @@
 #include "headers/DisplaySys.h"
+#include "headers/BigFont.h"
 
-// LCDBigNumbers library configuration
-#define USE_SERIAL_2004_LCD
-#include <LCDBigNumbers.hpp>
-#include <Wire.h>
-
-// Helper to print string with custom char 0 support
-static void printStr(LiquidCrystal_I2C* lcd, String s) {
-    for (unsigned int i = 0; i < s.length(); i++) {
-        char c = s[i];
-        if (c == '\x08') lcd->write((uint8_t)0); // Map \x08 backspace char to Custom Char 0 (Gear)
-        else lcd->write((uint8_t)c);
-    }
-}
+// Big number area on rows 0-1: anchored at column 4, never into the unit label
+static const uint8_t BIG_NUM_COL = 4;
+static const uint8_t BIG_NUM_END_COL = 18; // Unit label owns 18-19
 
 DisplaySys::DisplaySys() {
-    _lcd = new LiquidCrystal_I2C(LCD_ADDR, LCD_COLS, LCD_ROWS);
-    // Using LCDBigNumbers 3x2 VARIANT_2 (no 0xFF blocks, all custom chars)
-    _bigNumbers = new LCDBigNumbers(_lcd, BIG_NUMBERS_FONT_3_COLUMN_2_ROWS_VARIANT_2);
-    _lastMM = -999.9;
     _lastIsInch = false;
-    _lastBigValue = -999.9;
-    _lastBigUnit = "";
+    _lastBigValue = INT32_MIN;
     _lastValueChangeMillis = 0;
-    _lastRawValue = -999.9;
     _wasSettled = false;
-    _lastVelocity = 0.0;
     _inIdleMode = false;
-    for (int i = 0; i < 4; i++) {
-        _lastLine[i] = "";
-    }
+    _unsaved = false;
+    _outErrors = 0;
+    _frameInFlight = false;
+    _frameStartMs = 0;
+    _frameDrawUs = 0;
+    _lastFrameDrawUs = 0;
+    _framesThisSecond = 0;
+    _fps = 0;
+    _fpsWindowStartMs = 0;
 }
 
 void DisplaySys::init() {
-#if defined(STM32F4xx)
-    Wire.setSDA(PIN_LCD_SDA);
-    Wire.setSCL(PIN_LCD_SCL);
-    Wire.begin(); 
-#endif
-    _lcd->begin();  // fdebrabander begin() takes no arguments
-    _lcd->backlight();
-    
-    // Initialize big numbers font
-    _bigNumbers->begin();
-    
-    // Override library's custom characters with consistent 2-pixel versions
-    // VARIANT_2 uses 8 custom characters (0-7) with NO 0xFF blocks
-    uint8_t customChar0[8] = { 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }; // Upper bar (2 rows)
-    uint8_t customChar1[8] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F }; // Lower bar (2 rows)
-    uint8_t customChar2[8] = { 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F }; // Upper and lower bar (2+2 rows)
-    uint8_t customChar3[8] = { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 }; // Left bar (2 pixels wide, full height)
-    uint8_t customChar4[8] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x18 }; // Left lower bar (2 pixels)
-    uint8_t customChar5[8] = { 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x18, 0x18 }; // Left upper and lower (2 pixels)
-    uint8_t customChar6[8] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E }; // Decimal point
-    uint8_t customChar7[8] = { 0x00, 0x00, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00 }; // Colon
-    
-    _lcd->createChar(0, customChar0);
-    _lcd->createChar(1, customChar1);
-    _lcd->createChar(2, customChar2);
-    _lcd->createChar(3, customChar3);
-    _lcd->createChar(4, customChar4);
-    _lcd->createChar(5, customChar5);
-    _lcd->createChar(6, customChar6);
-    _lcd->createChar(7, customChar7);
-    
-    _lcd->clear();
+    // I2C displays expect i2cBus.begin() to have run
+    _out.begin(); // Leaves the screen blank
+    _frame.cleared();
 }
 
+// ==========================================
+// RENDER SCHEDULER
+// ==========================================
+// Screens only compose into the frame; this decides when it goes out.
+// - A new frame starts at most every DISPLAY_FRAME_MS, and only once the
+//   previous one is fully on the glass. Whatever the screens composed in
+//   between is sent as one diff: intermediate frames are dropped, not queued.
+// - Rows 0-1 (the big number) are queued ahead of the info rows (HD44780).
+// - Each call sends one backend slice (LCD_TX_SLICE_BYTES / OLED_SLICE_BYTES),
+//   so one loop pass never spends more than ~1.5 ms on the bus however much
+//   changed.
 void DisplaySys::update() {
-    // Placeholder
+    unsigned long startUs = micros();
+    unsigned long nowMs = millis();
+
+    if (!_frameInFlight && _frame.isDirty() && (nowMs - _frameStartMs) >= DISPLAY_FRAME_MS) {
+        _frameStartMs = nowMs;
+        _frameInFlight = true;
+        _frameDrawUs = 0;
+        _out.beginFrame(&_frame);
+    }
+
+    _out.pump();
+
+    // A failed transaction leaves the screen unknown: resend everything
+    if (_out.getErrors() != _outErrors) {
+        _outErrors = _out.getErrors();
+        _frame.invalidateAll();
+    }
+
+    if (_frameInFlight) {
+        _frameDrawUs += micros() - startUs;
+        if (_out.isIdle()) {
+            _frameInFlight = false;
+            _lastFrameDrawUs = _frameDrawUs;
+            _framesThisSecond++;
+        }
+    }
+
+    if (nowMs - _fpsWindowStartMs >= 1000) {
+        _fps = _framesThisSecond;
+        _framesThisSecond = 0;
+        _fpsWindowStartMs = nowMs;
+    }
 }
 
-void DisplaySys::showIdle(float currentMM, float targetMM, uint8_t cutMode, uint8_t stockType, const char* stockStr, uint8_t faceVal, bool isInch, bool reverseDir) {
+void DisplaySys::showIdle(PositionUM currentUM, int32_t velocityUMs, float targetMM, uint8_t cutMode, uint8_t stockType, const char* stockStr, uint8_t faceVal, bool isInch, bool reverseDir) {
     // ==========================================
     // BIG NUMBER LAYOUT (2x2 INDUSTRIAL on rows 0-1)
     // ==========================================
@@ -81,77 +84,61 @@ void DisplaySys::showIdle(float currentMM, float targetMM, uint8_t cutMode, uint
     // Row 3:   █ 20x40 ANG 45° F:20
     // ==========================================
 
-    // CRITICAL: Reload library characters when returning from menu
+    // Returning from another screen: every cell is recomposed below and the
+    // frame sends only what differs (bar glyphs are loaded as they are needed)
     if (!_inIdleMode) {
-        _bigNumbers->begin();  // Reload big number custom characters
         _inIdleMode = true;
-        
-        // FIX: Clear screen to remove menu artifacts
-        _lcd->clear();
+        _frame.fill(18, 0, ' ', 2); // Above the unit label
         
         // Force full redraw
-        _lastBigValue = -999.9;
-        _lastBigUnit = "";
-        
-        // Reset all line caches to force redraw
-        for (int i = 0; i < 4; i++) {
-            _lastLine[i] = "";
-        }
+        _lastBigValue = INT32_MIN;
     }
 
-    // Convert measurement to display value
-    float rawValue;
-    String unitStr;
+    // Convert measurement to display value (integer tenths: 1234 = 123.4)
+    int32_t rawValue;
     
     if (isInch) {
-        rawValue = currentMM / 25.4;  // mm to inches
-        unitStr = "IN";
+        rawValue = divRound(currentUM, UM_PER_INCH / 10);  // um to 0.1 in
     } else {
-        rawValue = currentMM / 10.0;  // mm to cm
-        unitStr = "CM";
+        rawValue = divRound(currentUM, UM_PER_MM);  // um to 0.1 cm (= mm)
     }
     
     // === VELOCITY-BASED ADAPTIVE FILTERING ===
-    // Track value changes for velocity calculation and settling detection
+    // Velocity comes from the encoder's M/T estimator (edge timestamps), so it is
+    // valid even between display updates and drops to zero as soon as motion stops.
     unsigned long currentMillis = millis();
     const unsigned long SETTLING_DELAY = 150;  // 150ms settling time
-    
-    // Calculate velocity (rate of change in cm/s or in/s)
-    float velocity = 0.0;
-    unsigned long deltaTime = currentMillis - _lastValueChangeMillis;
-    
-    if (abs(rawValue - _lastRawValue) > 0.01 && deltaTime > 0) {
-        float deltaValue = abs(rawValue - _lastRawValue);
-        velocity = (deltaValue / deltaTime) * 1000.0;  // Convert to per second
+    const int32_t STILL_UMS = 500;             // Below 0.5 mm/s counts as stopped
+
+    // Speed in display tenths per second (1 tenth = 1 mm or 0.1 in)
+    int32_t speedUMs = (velocityUMs < 0) ? -velocityUMs : velocityUMs;
+    int32_t velocity = speedUMs / (isInch ? (UM_PER_INCH / 10) : UM_PER_MM);
+
+    if (speedUMs >= STILL_UMS) {
         _lastValueChangeMillis = currentMillis;
-        _lastRawValue = rawValue;
-        _lastVelocity = velocity;  // Store for smoothing
     }
-    
-    // Use smoothed velocity (prevents jitter)
-    velocity = _lastVelocity;
-    
+
     // Determine if settled
     bool isSettled = (currentMillis - _lastValueChangeMillis) > SETTLING_DELAY;
-    float displayValue;
+    int32_t displayValue;
     
     // === VELOCITY-BASED ROUNDING ===
-    // Velocity thresholds (adjust these for your preference)
-    const float FAST_THRESHOLD = 5.0;   // cm/s or in/s - fast movement
-    const float SLOW_THRESHOLD = 2.0;   // cm/s or in/s - slow movement
+    // Velocity thresholds in tenths per second (adjust these for your preference)
+    const int32_t FAST_THRESHOLD = 50;   // 5.0 cm/s or in/s - fast movement
+    const int32_t SLOW_THRESHOLD = 20;   // 2.0 cm/s or in/s - slow movement
     
     if (isSettled) {
         // Settled: show exact value with 0.1 precision
         displayValue = rawValue;
     } else if (velocity > FAST_THRESHOLD) {
         // Fast movement: round to 1.0 (ultra smooth)
-        displayValue = round(rawValue);
+        displayValue = divRound(rawValue, 10) * 10;
     } else if (velocity > SLOW_THRESHOLD) {
         // Medium movement: round to 0.5
-        displayValue = round(rawValue * 2.0) / 2.0;
+        displayValue = divRound(rawValue, 5) * 5;
     } else {
         // Slow movement: round to 0.2 for finer granularity
-        displayValue = round(rawValue * 5.0) / 5.0;
+        displayValue = divRound(rawValue, 2) * 2;
     }
     
     // Detect settling transition to force exact value update
@@ -159,282 +146,166 @@ void DisplaySys::showIdle(float currentMM, float targetMM, uint8_t cutMode, uint
     _wasSettled = isSettled;
     
     // Redraw if: value changed OR unit changed OR just settled (to show exact value)
-    // Use smaller threshold (0.15) for more responsive updates with velocity filtering
-    if (abs(displayValue - _lastBigValue) > 0.15 || unitStr != _lastBigUnit || justSettled) {
+    // Threshold of 0.2 keeps velocity filtering responsive without chatter
+    bool bigChanged = (_lastBigValue == INT32_MIN) || (abs(displayValue - _lastBigValue) > 1);
+    if (bigChanged || isInch != _lastIsInch || justSettled) {
         // === AUTO-RANGING LOGIC ===
         // If value > 999.9 CM, switch to Meters
         // 1000.0 CM -> 10.0 M (Single Decimal to fit 4 chars)
-        float effectiveValue = displayValue;
-        String effectiveUnit = "CM"; 
-        int precision = 1; 
+        int32_t effectiveValue = displayValue;
         
-        // Strict check using unitStr
-        if (unitStr == "CM" && effectiveValue >= 999.95) { 
-            effectiveValue /= 100.0;
-            effectiveUnit = "M";
-            precision = 1; // Must use 1 decimal to keep length = 4 chars (fits without shifting)
-        } else if (unitStr == "IN") {
-             effectiveUnit = "IN";
+        if (!isInch && effectiveValue >= 10000) { 
+            effectiveValue = divRound(effectiveValue, 100); // 0.1 CM -> 0.1 M (still 1 decimal, fits without shifting)
         }
         
         // Format number
-        char buffer[10];
-        dtostrf(effectiveValue, 0, precision, buffer);
-        String numStr = String(buffer);
-        
-        int originalLength = numStr.length();
-        
-        // === FIXED ANCHOR FORMATTING ===
-        // Start at Column 4 (Shifted 1 box right from 3)
-        // "99.9" (4 chars) -> Cols 4-19 (Ends at 19).
-        // "CM" at 18,19 -> Overlap at 18,19.
-        // User explicitly requested "move 1 column right" despite overlap.
-        int startCol = 4;
-        
-        // === SMART CLEARING: Only clear when digit count changes ===
-        static int lastNumLength = 0;
-        if (originalLength != lastNumLength) {
-            _lcd->setCursor(0, 0);
-            _lcd->print("                    "); // 20 spaces
-            _lcd->setCursor(0, 1);
-            _lcd->print("                    "); // 20 spaces
-            lastNumLength = originalLength;
-        }
-        
-        // Draw big numbers
-        _bigNumbers->setBigNumberCursor(startCol, 0);
-        _bigNumbers->print(numStr.c_str());
+        LineBuf numStr;
+        numStr.addFixed(effectiveValue, 1);
+        drawBigNumber(numStr.c_str());
         
         _lastBigValue = displayValue;
-        _lastBigUnit = unitStr; // Track original unit
-        
-        // Unit label at row 1, fixed at column 18
-        _lcd->setCursor(18, 1);
-        if (effectiveUnit == "M") {
-            _lcd->print(" M"); // Space then M (aligns M at 19)
-        } else {
-            _lcd->print("CM"); // CM at 18,19
-        }
-    } else {
-        // Even if value didn't change, ensure unit is visible
-        String currentUnit = "CM";
-        if (unitStr == "IN") currentUnit = "IN";
-        else if (displayValue >= 999.95) currentUnit = "M";
-        
-        _lcd->setCursor(18, 1);
-        if (currentUnit == "M") {
-            _lcd->print(" M");
-        } else {
-            _lcd->print("CM");
-        }
+        _lastIsInch = isInch; // Track original unit
     }
+
+    // Unit label at row 1, fixed at column 18 (only resent when it changes)
+    const char *unitLabel = "CM"; // CM at 18,19
+    if (isInch) unitLabel = "IN";
+    else if (displayValue >= 10000) unitLabel = " M"; // Space then M (aligns M at 19)
+    _frame.write(18, 1, unitLabel, 2);
     
-    // --- Line 2: Separator ---
-    String line2 = "====================";
-    if (line2 != _lastLine[2]) {
-        printLine(2, line2);
-        _lastLine[2] = line2;
-    }
+    // --- Line 2: Separator (or the one warning that can't wait) ---
+    printLine(2, _unsaved ? "==== NOT SAVED =====" : "====================");
     
     // --- Line 3: Stock Info ---
-    String stockIcon = "";
-    if (stockType == 0) stockIcon = "\xDB";      // Rect: █ (full block) - WORKING!
-    else if (stockType == 1) stockIcon = "L";    // Angle: L
-    else if (stockType == 2) stockIcon = "D";    // Round: D (diameter)
+    char stockIcon = ' ';
+    if (stockType == 0) stockIcon = '\xDB';      // Rect: █ (full block) - WORKING!
+    else if (stockType == 1) stockIcon = 'L';    // Angle: L
+    else if (stockType == 2) stockIcon = 'D';    // Round: D (diameter)
     
-    String line3 = stockIcon + " " + String(stockStr);
-    line3 += " ANG " + String(cutMode) + "\xDF"; // "ANG 45°"
+    LineBuf line3;
+    line3.add(stockIcon).add(' ').add(stockStr);
+    line3.add(" ANG ").addUInt(cutMode).add('\xDF'); // "ANG 45°"
     
     if (cutMode > 0 && faceVal > 0) {
-        line3 += " F:" + String(faceVal);
+        line3.add(" F:").addUInt(faceVal);
     }
     
-    while(line3.length() < 20) line3 += " ";
-    
-    if (line3 != _lastLine[3]) {
-        printLine(3, line3);
-        _lastLine[3] = line3;
-    }
+    printLine(3, line3.c_str());
 }
 
-void DisplaySys::showHiddenInfo(float kerfMM, float diameter, bool reverseDir, bool autoZeroEnabled) {
-    _lcd->clear();
+void DisplaySys::showHiddenInfo(float kerfMM, float diameter, bool reverseDir, bool autoZeroEnabled,
+                                const EncoderDiag *diag, unsigned long rejectedCuts) {
+    // Called every loop pass: recomposed in full, only changed cells are sent
+    _inIdleMode = false; // Idle redraws everything (big number included) on return
     
     // Line 0: Kerf and Diameter
-    String line0 = "K:" + String(kerfMM, 1) + " D:" + String(diameter, 2);
-    _lcd->setCursor(0, 0);
-    printStr(_lcd, line0);
+    LineBuf line;
+    line.add("K:").addFloat(kerfMM, 1).add(" D:").addFloat(diameter, 2);
+    printLine(0, line.c_str());
     
     // Line 1: Direction and Auto-Zero
-    String line1 = "Dir:" + String(reverseDir ? "REV" : "NORM");
-    line1 += " AZ:" + String(autoZeroEnabled ? "ON" : "OFF");
-    _lcd->setCursor(0, 1);
-    printStr(_lcd, line1);
-    
-    // Line 2: Instructions
-    _lcd->setCursor(0, 2);
-    printStr(_lcd, "Hold to view...");
-    
-    _lcd->setCursor(0, 3);
-    printStr(_lcd, "Release to exit");
+    line.clear();
+    line.add("Dir:").add(reverseDir ? "REV" : "NORM");
+    line.add(" AZ:").add(autoZeroEnabled ? "ON" : "OFF");
+    printLine(1, line.c_str());
+    
+    // Line 2: Encoder health and error counters (Glitch / Chatter / Slip)
+    line.clear();
+    line.add("HP:").addUInt(diag->getHealth());
+    line.add(" G").addUInt(diag->getGlitches());
+    line.add(" C").addUInt(diag->getChatter());
+    line.add(" S").addUInt(diag->getSlips());
+    printLine(2, line.c_str());
+    
+    // Line 3: Cuts refused because of a suspect measurement, display frame rate
+    line.clear();
+    line.add("Rejected:").addUInt(rejectedCuts).add(" FPS:").addUInt(_fps);
+    printLine(3, line.c_str());
 }
 
-void DisplaySys::showMeasurement(float mm, bool isInch) {
-    // Legacy method - can be removed or redirected to showIdle
-    showIdle(mm, 0, 0, 0, "", 0, isInch, false);
-}
-
-void DisplaySys::showMenu(const char* title, String value, bool isEditMode) {
-    // Mark that we're leaving idle mode (so custom chars get reloaded on return)
-    if (_inIdleMode) {
-        _inIdleMode = false;
-        // Clear screen FIRST to prevent gibberish during character redefinition
-        _lcd->clear();
-        // Then reload menu-specific custom characters (icons)
-        createCustomChars();
-    }
+void DisplaySys::showMenu(const char* title, const char* value, bool isEditMode) {
+    // Leaving idle: the big number is recomposed on return
+    _inIdleMode = false;
     
-    // Optimized to prevent flickering (no clear())
+    // Optimized to prevent flickering (no clear()): only changed cells are sent
     
     // Line 0: Title
-    String line0 = String(title);
-    while(line0.length() < 20) line0 += " ";
-    
-    if (line0 != _lastLine[0]) {
-        _lcd->setCursor(0, 0);
-        printStr(_lcd, line0);
-        _lastLine[0] = line0;
-    }
+    printLine(0, title);
     
     // Line 1: Value
-    String line1 = "";
-    if (isEditMode) line1 += "> ";
-    line1 += value;
-    while(line1.length() < 20) line1 += " ";
-    
-    if (line1 != _lastLine[1]) {
-        _lcd->setCursor(0, 1);
-        printStr(_lcd, line1);
-        _lastLine[1] = line1;
-    }
-    
-    // Clear lines 2 & 3 if they are not empty (from previous screen)
-    // We assume lines 2/3 are unused in menu for now
-    String blank = "                    ";
-    if (_lastLine[2] != blank) {
-        _lcd->setCursor(0, 2);
-        printStr(_lcd, blank);
-        _lastLine[2] = blank;
-    }
-    if (_lastLine[3] != blank) {
-        _lcd->setCursor(0, 3);
-        printStr(_lcd, blank);
-        _lastLine[3] = blank;
-    }
+    LineBuf line1;
+    if (isEditMode) line1.add("> ");
+    line1.add(value);
+    printLine(1, line1.c_str());
+    
+    // Lines 2/3 are unused in this menu layout
+    printLine(2, "");
+    printLine(3, "");
 }
 
-void DisplaySys::showMenu4(String l0, String l1, String l2, String l3) {
-    // Mark that we're leaving idle mode
-    if (_inIdleMode) {
-        _inIdleMode = false;
-        // Clear screen FIRST to prevent gibberish during character redefinition
-        _lcd->clear();
-        // Then reload menu-specific custom characters (icons)
-        createCustomChars();
-    }
-    
-    // Truncate to 20 chars max, then pad if needed
-    if (l0.length() > 20) l0 = l0.substring(0, 20);
-    if (l1.length() > 20) l1 = l1.substring(0, 20);
-    if (l2.length() > 20) l2 = l2.substring(0, 20);
-    if (l3.length() > 20) l3 = l3.substring(0, 20);
-    
-    while(l0.length() < 20) l0 += " ";
-    while(l1.length() < 20) l1 += " ";
-    while(l2.length() < 20) l2 += " ";
-    while(l3.length() < 20) l3 += " ";
+void DisplaySys::showMenu4(const char* l0, const char* l1, const char* l2, const char* l3) {
+    _inIdleMode = false;
     
-    // Update if changed
-    if (l0 != _lastLine[0]) {
-        _lcd->setCursor(0, 0);
-        printStr(_lcd, l0);
-        _lastLine[0] = l0;
-    }
-    if (l1 != _lastLine[1]) {
-        _lcd->setCursor(0, 1);
-        printStr(_lcd, l1);
-        _lastLine[1] = l1;
-    }
-    if (l2 != _lastLine[2]) {
-        _lcd->setCursor(0, 2);
-        printStr(_lcd, l2);
-        _lastLine[2] = l2;
-    }
-    if (l3 != _lastLine[3]) {
-        _lcd->setCursor(0, 3);
-        printStr(_lcd, l3);
-        _lastLine[3] = l3;
-    }
+    // Truncated / padded to 20 chars; unchanged cells cost nothing
+    printLine(0, l0);
+    printLine(1, l1);
+    printLine(2, l2);
+    printLine(3, l3);
 }
 
 void DisplaySys::showError(const char* msg) {
-    _lcd->clear();
-    _lcd->setCursor(0, 0);
-    printStr(_lcd, "ERROR:");
-    _lcd->setCursor(0, 1);
-    printStr(_lcd, msg);
+    _inIdleMode = false;
+    printLine(0, "ERROR:");
+    printLine(1, msg);
+    printLine(2, "");
+    printLine(3, "");
 }
 
-void DisplaySys::clear() {
-    _lcd->clear();
-    for (int i = 0; i < 4; i++) {
-        _lastLine[i] = "";
+// ==========================================
+// BIG NUMBER
+// ==========================================
+// Composes columns 0-17 of rows 0-1 into the frame, glyph by glyph. The
+// whole area is written every time, but the frame only sends the cells that
+// differ: a changing last digit costs its 3x2 cells, a digit-count change
+// (or the CM -> M switch) only the columns that actually moved, and nothing
+// is ever blanked first.
+void DisplaySys::drawBigNumber(const char* text) {
+    // Fixed anchor at column 4; shift left only if it would hit the unit label
+    uint8_t width = bigFontWidth(text);
+    uint8_t col = BIG_NUM_COL;
+    if (col + width > BIG_NUM_END_COL) {
+        col = (width < BIG_NUM_END_COL) ? BIG_NUM_END_COL - width : 0;
     }
-}
 
-void DisplaySys::printLine(int row, String text) {
-    _lcd->setCursor(0, row);
-    // Pad with spaces to clear old content
-    while (text.length() < LCD_COLS) {
-        text += " ";
+    for (uint8_t row = 0; row < BIG_FONT_ROWS; row++) {
+        _frame.fill(0, row, ' ', col);
     }
-    printStr(_lcd, text);
-}
 
-void DisplaySys::createCustomChars() {
-    // 0: Statistics/Bar Chart (User Defined - Updated)
-    // Used for Units in Settings and Statistics menus (via \x08 mapping)
-    uint8_t iconStats[8] = {0x00, 0x10, 0x10, 0x14, 0x15, 0x15, 0x1F, 0x00};
-    _lcd->createChar(0, iconStats);
-
-    // 1: Rectangular Tube
-    uint8_t iconRect[8] = {0x00, 0x1F, 0x11, 0x11, 0x11, 0x1F, 0x00, 0x00};
-    _lcd->createChar(1, iconRect);
-    
-    // 2: Angle Iron (L)
-    uint8_t iconAngle[8] = {0x00, 0x10, 0x10, 0x10, 0x10, 0x1F, 0x00, 0x00};
-    _lcd->createChar(2, iconAngle);
-    
-    // 3: Gear (Calibration Icon)
-    uint8_t iconGear[8] = {0x00, 0x0E, 0x15, 0x15, 0x17, 0x11, 0x0E, 0x00};
-    _lcd->createChar(3, iconGear);
-
-    // 4: Blade (User Defined - Updated)
-    // Used for Auto-Zero, Kerf Thickness, and AZ Threshold
-    uint8_t iconBlade[8] = {0x00, 0x18, 0x1C, 0x0E, 0x06, 0x07, 0x03, 0x00};
-    _lcd->createChar(4, iconBlade);
+    for (; *text; text++) {
+        const BigGlyph *g = bigFontGlyph(*text);
+        if (!g) continue;
+        for (uint8_t i = 0; i < g->width && col < BIG_NUM_END_COL; i++, col++) {
+            for (uint8_t row = 0; row < BIG_FONT_ROWS; row++) {
+                _frame.put(col, row, g->cells[row][i]);
+            }
+        }
+    }
 
-    // 5: Settings (Crosshair) - User Defined
-    // Replaces Gear icon
-    uint8_t iconSettings[8] = {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00, 0x00};
-    _lcd->createChar(5, iconSettings);
+    for (uint8_t row = 0; row < BIG_FONT_ROWS; row++) {
+        _frame.fill(col, row, ' ', BIG_NUM_END_COL - col);
+    }
+}
 
-    // 6: Direction (Double Arrow) - User Defined
-    // Replaces Calibration icon
-    uint8_t iconArrows[8] = {0x04, 0x0E, 0x1F, 0x00, 0x00, 0x1F, 0x0E, 0x04};
-    _lcd->createChar(6, iconArrows);
+void DisplaySys::clear() {
+    _out.clearScreen();
+    _frame.cleared();
+    _frameInFlight = false; // Whatever was queued is out now
+}
 
-    // 7: Angle (User Defined - Refined)
-    uint8_t iconAngleSym[8] = {0x00, 0x10, 0x18, 0x1C, 0x1E, 0x1F, 0x00, 0x00};
-    _lcd->createChar(7, iconAngleSym);
+void DisplaySys::printLine(int row, const char* text) {
+    // Pad with spaces to clear old content, map icon characters to glyphs
+    for (int col = 0; col < LCD_COLS; col++) {
+        char c = *text ? *text++ : ' ';
+        _frame.put(col, row, glyphForMenuChar((uint8_t)c));
+    }
 }
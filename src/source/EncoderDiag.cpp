@@ -0,0 +1,131 @@
+#include "headers/EncoderDiag.h"
+
+#define DIAG_PENALTY_GLITCH 10
+#define DIAG_PENALTY_CHATTER 5
+#define DIAG_PENALTY_SLIP 20
+#define DIAG_RECOVER_MS 1000
+
+EncoderDiag::EncoderDiag() {
+    _limits[0].maxCountsPerSec = UINT32_MAX;
+    _limits[0].maxCountsPerSec2 = UINT32_MAX;
+    _limits[0].minEdgeUs = 0;
+    _limits[1] = _limits[0];
+    _limitSlot = 0;
+
+    _glitches = 0;
+    _chatter = 0;
+    _slips = 0;
+    _windowEvents = 0;
+    _health = 100;
+
+    _lastEdgeUs = 0;
+    _lastCount = 0;
+    _lastDir = 0;
+    _slipPending = false;
+    _slipPendingMs = 0;
+    _lastReversalMs = 0;
+    _lastEventMs = 0;
+    _cleanSinceMs = 0;
+    _primed = false;
+}
+
+void EncoderDiag::setLimits(uint32_t maxCountsPerSec, uint32_t maxCountsPerSec2) {
+    uint8_t next = _limitSlot ^ 1;
+    Limits &lim = _limits[next];
+    lim.maxCountsPerSec = (maxCountsPerSec > 0) ? maxCountsPerSec : 1;
+    lim.maxCountsPerSec2 = (maxCountsPerSec2 > 0) ? maxCountsPerSec2 : 1;
+    // One captured A edge per 4 counts
+    lim.minEdgeUs = 4000000UL / lim.maxCountsPerSec;
+    _limitSlot = next;
+}
+
+void EncoderDiag::prime(int64_t count, uint32_t nowMs) {
+    _lastCount = count;
+    _cleanSinceMs = nowMs;
+    _lastEventMs = nowMs - DIAG_EVENT_HOLDOFF_MS; // Nothing to merge with yet
+    _primed = true;
+}
+
+void EncoderDiag::flag(volatile uint16_t &counter, uint8_t penalty, bool suspect, uint32_t nowMs) {
+    _cleanSinceMs = nowMs;
+
+    if ((uint32_t)(nowMs - _lastEventMs) < DIAG_EVENT_HOLDOFF_MS) {
+        return; // Same physical event
+    }
+    _lastEventMs = nowMs;
+
+    if (counter < UINT16_MAX) counter = counter + 1;
+    if (suspect && _windowEvents < UINT8_MAX) _windowEvents = _windowEvents + 1;
+    _health = (_health > penalty) ? (uint8_t)(_health - penalty) : 0;
+}
+
+void EncoderDiag::onEdge(uint32_t edgeTimeUs, uint8_t edgesPerCapture, uint32_t nowMs) {
+    uint32_t interval = edgeTimeUs - _lastEdgeUs;
+    _lastEdgeUs = edgeTimeUs;
+
+    if (_primed && interval < _limits[_limitSlot].minEdgeUs * edgesPerCapture) {
+        flag(_glitches, DIAG_PENALTY_GLITCH, true, nowMs);
+    }
+}
+
+void EncoderDiag::onEstimate(int32_t velocityQ8, int32_t edgeAccel, uint32_t nowMs) {
+    if (!_primed) return;
+
+    // Acceleration beyond what the stock can do: speeding up = glitch,
+    // braking = slip unless the feed comes to rest (see onSample)
+    int64_t absAccel = (edgeAccel < 0) ? -(int64_t)edgeAccel : edgeAccel;
+    if (absAccel <= (int64_t)_limits[_limitSlot].maxCountsPerSec2) return;
+
+    bool braking = (velocityQ8 >= 0) ? (edgeAccel < 0) : (edgeAccel > 0);
+    if (!braking) {
+        flag(_glitches, DIAG_PENALTY_GLITCH, true, nowMs);
+    } else if (!_slipPending) {
+        _slipPending = true;
+        _slipPendingMs = nowMs;
+    }
+}
+
+void EncoderDiag::onSample(int64_t count, int32_t velocityQ8, uint32_t sampleHz, uint32_t nowMs) {
+    if (!_primed) {
+        prime(count, nowMs);
+        return;
+    }
+
+    int64_t delta = count - _lastCount;
+    _lastCount = count;
+
+    // More counts in one tick than max speed allows
+    int64_t absDelta = (delta < 0) ? -delta : delta;
+    if (absDelta > (int64_t)(_limits[_limitSlot].maxCountsPerSec / sampleHz) + 4) {
+        flag(_glitches, DIAG_PENALTY_GLITCH, true, nowMs);
+    }
+
+    // Direction chatter
+    int8_t dir = (delta > 0) ? 1 : ((delta < 0) ? -1 : 0);
+    if (dir != 0) {
+        if (_lastDir != 0 && dir != _lastDir) {
+            // Quadrature nets chatter out, so it costs health but keeps the reading
+            if ((uint32_t)(nowMs - _lastReversalMs) < DIAG_CHATTER_WINDOW_MS) {
+                flag(_chatter, DIAG_PENALTY_CHATTER, false, nowMs);
+            }
+            _lastReversalMs = nowMs;
+        }
+        _lastDir = dir;
+    }
+
+    // Hard braking: a stop if it reached rest, a slip if the wheel kept turning
+    if (_slipPending) {
+        if (velocityQ8 == 0) {
+            _slipPending = false;
+        } else if ((uint32_t)(nowMs - _slipPendingMs) >= DIAG_SLIP_CONFIRM_MS) {
+            _slipPending = false;
+            flag(_slips, DIAG_PENALTY_SLIP, true, nowMs);
+        }
+    }
+
+    // Slow recovery while clean
+    if ((uint32_t)(nowMs - _cleanSinceMs) >= DIAG_RECOVER_MS) {
+        _cleanSinceMs = nowMs;
+        if (_health < 100) _health = _health + 1;
+    }
+}
@@ -1,14 +1,37 @@
 #include "headers/EncoderSys.h"
 
+// Capture prescaler switch points (counts/s), with hysteresis
+#define CAPTURE_DIV8_ABOVE 8000
+#define CAPTURE_DIV1_BELOW 4000
+
+#if defined(STM32F4xx)
+EncoderSys* EncoderSys::_isrInstance = nullptr;
+#endif
+
 EncoderSys::EncoderSys() {
     _wheelDiameter = DEFAULT_WHEEL_DIA_MM;
-    _offsetMM = 0.0f;
+    _zeroCount[0] = _zeroCount[1] = 0;
+    _offsetUM[0] = _offsetUM[1] = 0;
+    _zeroSlot = 0;
+    _edgeSeq = 0;
+    _edgeCount = 0;
+    _edgeTimeUs = 0;
+    _alarmEnabled = false;
+    _alarmFired = false;
+    _alarmTarget = 0;
+    _alarmTrip = 0;
+    _alarmSide = 0;
+    _alarmRearmCounts = 0;
+    _alarmLeadMs = 0;
+    _alarmTargetUM = 0;
+    _alarmOffsetUM = 0;
+    _alarmZeroCount = 0;
+    _corrPoints = 0;
+    _scaleSlot = 0;
     recalculateCalibration();
-    
+
 #if defined(STM32F4xx)
-    _timer = nullptr;
-    _overflowCount = 0;
-    _lastTimerCount = 0;
+    _captureDiv8 = false;
 #else
     _encoder = nullptr;
 #endif
@@ -16,132 +39,318 @@ EncoderSys::EncoderSys() {
 
 void EncoderSys::init() {
 #if defined(STM32F4xx)
-    // 1. Configure Pins FIRST (Enable Pull-ups)
-    pinMode(PB6, INPUT_PULLUP);
-    pinMode(PB7, INPUT_PULLUP);
-
-    // 2. Initialize Hardware Timer
-    _timer = new HardwareTimer(TIM4);
-    
-    // 3. EXPLICITLY Force GPIO to Alternate Function Mode (AF2 for TIM4)
-    // pinMode sets them to Input, which disconnects the timer. We must reconnect it.
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
-    
-    // Enable GPIOB Clock
-    __HAL_RCC_GPIOB_CLK_ENABLE();
-    
-    // Configure PB6 & PB7 as Alternate Function (TIM4)
-    GPIO_InitStruct.Pin = GPIO_PIN_6 | GPIO_PIN_7;
-    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
-    GPIO_InitStruct.Pull = GPIO_PULLUP; // Keep pull-ups enabled!
-    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
-    GPIO_InitStruct.Alternate = GPIO_AF2_TIM4;
-    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
-    
-    // HardwareTimer doesn't expose encoder mode directly, so we configure via HAL
-    // Stop the timer first
-    _timer->pause();
-    
-    // Get the HAL timer handle (returns pointer)
-    TIM_HandleTypeDef *halTimer = _timer->getHandle();
-    
-    // Configure encoder mode (both TI1 and TI2 on both edges)
-    TIM_Encoder_InitTypeDef encoderConfig;
-    encoderConfig.EncoderMode = TIM_ENCODERMODE_TI12;  // Count on both edges of both channels
-    encoderConfig.IC1Polarity = TIM_ICPOLARITY_RISING;
-    encoderConfig.IC1Selection = TIM_ICSELECTION_DIRECTTI;
-    encoderConfig.IC1Prescaler = TIM_ICPSC_DIV1;
-    encoderConfig.IC1Filter = 0x0F; // Add some filtering (0-15)
-    encoderConfig.IC2Polarity = TIM_ICPOLARITY_RISING;
-    encoderConfig.IC2Selection = TIM_ICSELECTION_DIRECTTI;
-    encoderConfig.IC2Prescaler = TIM_ICPSC_DIV1;
-    encoderConfig.IC2Filter = 0x0F; // Add some filtering
-    
-    if (HAL_TIM_Encoder_Init(halTimer, &encoderConfig) != HAL_OK) {
-        // Error handling if needed
-    }
-    
-    // Start the encoder!
-    HAL_TIM_Encoder_Start(halTimer, TIM_CHANNEL_ALL);
-    
-    // Set max count (16-bit timer)
-    _timer->setOverflow(65535);
-    _timer->setCount(0);
-    _timer->resume();
-    
-    // Start encoder mode
-    HAL_TIM_Encoder_Start(halTimer, TIM_CHANNEL_ALL);
-    
-    // Initialize state
-    _timer->setCount(0);
-    _lastTimerCount = 0;
-    _overflowCount = 0;
+    // Timer, pins and wrap handling come from the compile-time backend (ENCODER_TIMER)
+    _hw.init(ENCODER_INPUT_FILTER);
+
+    // Edge timestamps for the M/T velocity estimator
+    _isrInstance = this;
+    _hw.attachCapture(EncoderSys::captureISR);
+    _hw.attachCompare(EncoderSys::compareISR);
 #else
     // AVR Software Interrupt Implementation
     _encoder = new Encoder(PIN_ENCODER_A, PIN_ENCODER_B);
 #endif
-    
+
+    pinMode(PIN_TARGET_ALARM, OUTPUT);
+    setAlarmOutput(false);
+
+    EncoderSnapshot snap = getSnapshot();
+    _motion.reset(snap.count, snap.timestampUs, _edgeSeq);
+
     reset();
 }
 
-void EncoderSys::update() {
 #if defined(STM32F4xx)
-    // Handle 16-bit Timer Overflow/Underflow
-    // This must be called frequently (at least once every few seconds)
-    if (_timer == nullptr) return;
-    
-    uint16_t currentTimerCount = _timer->getCount();
-    int32_t diff = currentTimerCount - _lastTimerCount;
-    
-    // Detect wrap-around
-    // If diff is very negative (e.g. 0 - 65535 = -65535), we wrapped forward
-    // If diff is very positive (e.g. 65535 - 0 = 65535), we wrapped backward
-    // Threshold is half range (32768)
-    
-    if (diff < -32768) {
-        _overflowCount++;
-    } else if (diff > 32768) {
-        _overflowCount--;
+void EncoderSys::captureISR() {
+    if (_isrInstance != nullptr) {
+        _isrInstance->onCapture();
+    }
+}
+
+void EncoderSys::onCapture() {
+    EncoderSnapshot snap = getSnapshot();
+    _edgeSeq = _edgeSeq + 1;
+    _edgeCount = _hw.readCapture(snap.count);
+    _edgeTimeUs = snap.timestampUs;
+    _edgeSeq = _edgeSeq + 1;
+
+    _diag.onEdge(snap.timestampUs, _captureDiv8 ? 8 : 1, millis());
+}
+
+void EncoderSys::compareISR() {
+    if (_isrInstance != nullptr) {
+        _isrInstance->onCompare();
+    }
+}
+
+void EncoderSys::onCompare() {
+    if (!_alarmEnabled || _alarmFired) {
+        return;
+    }
+
+    // 16-bit timers match once per wrap: only act in the right epoch
+    int64_t count = getSnapshot().count;
+    int64_t error = count - _alarmTrip;
+    if (error < 0) error = -error;
+    if (error <= 64) {
+        fireAlarm(count);
+    }
+}
+#endif
+
+void EncoderSys::sampleISR() {
+    EncoderSnapshot snap = getSnapshot();
+
+    // Consistent copy of the latest edge (odd seq = capture ISR mid-write)
+    uint32_t seq;
+    int64_t edgeCount;
+    uint32_t edgeTimeUs;
+    do {
+        seq = _edgeSeq;
+        edgeCount = _edgeCount;
+        edgeTimeUs = _edgeTimeUs;
+    } while ((seq & 1) || seq != _edgeSeq);
+
+    uint32_t nowMs = millis();
+    if (_motion.update(snap.count, snap.timestampUs, SYSTEM_TICK_HZ, seq, edgeCount, edgeTimeUs)) {
+        _diag.onEstimate(_motion.getVelocityQ8(), _motion.getEdgeAccel(), nowMs);
+    }
+    _diag.onSample(snap.count, _motion.getVelocityQ8(), SYSTEM_TICK_HZ, nowMs);
+    serviceAlarm(snap.count);
+
+#if defined(STM32F4xx)
+    _feed.poll(); // Lap tracking for the DMA ring
+#endif
+
+#if defined(STM32F4xx)
+    int32_t countsPerSec = abs(_motion.getVelocityQ8() >> 8);
+    if (!_captureDiv8 && countsPerSec > CAPTURE_DIV8_ABOVE) {
+        _hw.setCapturePrescaler(true);
+        _captureDiv8 = true;
+    } else if (_captureDiv8 && countsPerSec < CAPTURE_DIV1_BELOW) {
+        _hw.setCapturePrescaler(false);
+        _captureDiv8 = false;
     }
-    
-    _lastTimerCount = currentTimerCount;
 #endif
 }
 
-void EncoderSys::reset() {
+int32_t EncoderSys::getVelocityUMs() {
+    return (int32_t)(countsToUM(_motion.getVelocityQ8()) / 256);
+}
+
+int32_t EncoderSys::getAccelUMs2() {
+    return (int32_t)countsToUM(_motion.getAccel());
+}
+
+// ============================================================================
+// TARGET-APPROACH ALARM
+// ============================================================================
+int64_t EncoderSys::predictTripCount(int64_t target, int64_t count, int32_t velocityQ8, uint16_t leadMs) {
+    int64_t dist = target - count;
+    if (dist == 0 || leadMs == 0 || velocityQ8 == 0) {
+        return target;
+    }
+
+    // Moving away: no look-ahead, trip exactly at the target if we ever come back
+    if ((dist > 0) != (velocityQ8 > 0)) {
+        return target;
+    }
+
+    int64_t speed = (velocityQ8 < 0) ? -(int64_t)velocityQ8 : velocityQ8;
+    int64_t lead = (speed * leadMs) / 256000; // counts/s Q8 * ms -> counts
+    int64_t absDist = (dist < 0) ? -dist : dist;
+    if (lead > absDist) lead = absDist;
+
+    return (dist > 0) ? target - lead : target + lead;
+}
+
+void EncoderSys::setTargetAlarm(PositionUM targetUM, uint16_t leadMs) {
+    uint8_t slot = _zeroSlot;
+    int64_t zeroCount = _zeroCount[slot];
+    PositionUM offsetUM = _offsetUM[slot];
+    if (_alarmEnabled && targetUM == _alarmTargetUM && leadMs == _alarmLeadMs &&
+        offsetUM == _alarmOffsetUM && zeroCount == _alarmZeroCount) {
+        return; // Already armed for this target and zero
+    }
+
+    // Park the ISRs while the 64-bit fields change
+    _alarmEnabled = false;
 #if defined(STM32F4xx)
-    if (_timer != nullptr) {
-        _timer->setCount(0);
-        _lastTimerCount = 0;
-        _overflowCount = 0;
+    _hw.enableCompare(false);
+#endif
+
+    _alarmTargetUM = targetUM;
+    _alarmOffsetUM = offsetUM;
+    _alarmZeroCount = zeroCount;
+    _alarmLeadMs = leadMs;
+    _alarmTarget = zeroCount + umToCounts((int64_t)targetUM + offsetUM);
+    _alarmTrip = _alarmTarget;
+    _alarmRearmCounts = umToCounts(TARGET_ALARM_REARM_UM);
+    _alarmSide = 0;
+    _alarmFired = false;
+    setAlarmOutput(false);
+
+    _alarmEnabled = true;
+}
+
+void EncoderSys::clearTargetAlarm() {
+    if (!_alarmEnabled) {
+        return;
     }
+    _alarmEnabled = false;
+#if defined(STM32F4xx)
+    _hw.enableCompare(false);
+#endif
+    _alarmFired = false;
+    setAlarmOutput(false);
+}
+
+bool EncoderSys::isTargetAlarmActive() {
+    return _alarmEnabled && _alarmFired;
+}
+
+void EncoderSys::setAlarmOutput(bool on) {
+#if defined(STM32F4xx)
+    digitalWriteFast(digitalPinToPinName(PIN_TARGET_ALARM), on ? HIGH : LOW); // Single BSRR write
 #else
-    if (_encoder != nullptr) {
-        _encoder->write(0);
+    digitalWrite(PIN_TARGET_ALARM, on ? HIGH : LOW);
+#endif
+}
+
+void EncoderSys::fireAlarm(int64_t count) {
+    _alarmFired = true;
+    _alarmTrip = count;
+    setAlarmOutput(true);
+#if defined(STM32F4xx)
+    _hw.enableCompare(false);
+#endif
+}
+
+void EncoderSys::serviceAlarm(int64_t count) {
+    if (!_alarmEnabled) {
+        return;
+    }
+
+    int64_t dist = _alarmTarget - count;
+    int8_t side = (dist > 0) ? 1 : ((dist < 0) ? -1 : 0);
+
+    if (_alarmFired) {
+        // Re-arm once backed off past the trip point (hysteresis)
+        int64_t tripDist = _alarmTarget - _alarmTrip;
+        if (tripDist < 0) tripDist = -tripDist;
+        int64_t absDist = (dist < 0) ? -dist : dist;
+        if (absDist > tripDist + _alarmRearmCounts) {
+            _alarmFired = false;
+            _alarmSide = side;
+            setAlarmOutput(false);
+        }
+        return;
+    }
+
+    // Look-ahead grows with speed, so the trip point moves every sample
+    int64_t trip = predictTripCount(_alarmTarget, count, _motion.getVelocityQ8(), _alarmLeadMs);
+
+    // Already there, or jumped across the target between samples (compare
+    // missed or no hardware compare): fire from here, one tick late at worst
+    bool crossed = (_alarmSide != 0 && side != _alarmSide);
+    _alarmSide = side;
+    if (trip == count || side == 0 || crossed) {
+        fireAlarm(count);
+        return;
+    }
+
+    _alarmTrip = trip;
+#if defined(STM32F4xx)
+    _hw.setCompare((uint32_t)trip);
+    if (!_hw.isCompareEnabled()) {
+        _hw.enableCompare(true); // Clears CC3IF, so only on the first arm
     }
 #endif
-    _lastCount = 0;
-    _offsetMM = 0.0f;
 }
 
-long EncoderSys::getRawCount() {
+void EncoderSys::update() {
+    // STM32: nothing to poll - 16-bit wraps are counted in the timer update
+    // interrupt and 32-bit backends never wrap.
+}
+
+EncoderSnapshot EncoderSys::getSnapshot() {
+    EncoderSnapshot snap;
+#if defined(STM32F4xx)
+    snap.count = _hw.readCount(&snap.timestampUs);
+#else
+    snap.count = (_encoder != nullptr) ? _encoder->read() : 0;
+    snap.timestampUs = micros();
+#endif
+    return snap;
+}
+
+const char* EncoderSys::getBackendName() {
 #if defined(STM32F4xx)
-    if (_timer == nullptr) return 0;
-    
-    // Update overflow tracking first to ensure consistency
-    update();
-    
-    // Calculate total count: (Overflows * 65536) + CurrentCount
-    return (_overflowCount * 65536) + _timer->getCount();
+    return EncoderBackend::name();
 #else
-    if (_encoder == nullptr) return 0;
-    return _encoder->read();
+    return "AVR Encoder lib";
 #endif
 }
 
-float EncoderSys::getDistanceMM() {
-    long raw = getRawCount();
-    return (raw * _mmPerPulse) - _offsetMM;
+void EncoderSys::reset() {
+    // Software zero: hardware counter keeps running so no count (or wrap) can be
+    // lost in a race with the update ISR.
+    publishZero(getSnapshot().count, 0);
+    _diag.startWindow();
+}
+
+void EncoderSys::publishZero(int64_t zeroCount, PositionUM offsetUM) {
+    uint8_t next = _zeroSlot ^ 1;
+    _zeroCount[next] = zeroCount;
+    _offsetUM[next] = offsetUM;
+    _zeroSlot = next; // The ISR sees the old pair or the new one, never a mix
+}
+
+long EncoderSys::getRawCount() {
+    return (long)(getSnapshot().count - _zeroCount[_zeroSlot]);
+}
+
+PositionUM EncoderSys::getDistanceUM() {
+    // Tick ISR as well as the loop
+    uint8_t slot = _zeroSlot;
+    const CountScale &scale = _scale[_scaleSlot];
+    int64_t counts = getSnapshot().count - _zeroCount[slot];
+    int64_t um = scaleToUM(scale, counts) + scale.correction.correctionUM(counts) - _offsetUM[slot];
+
+    // Saturate rather than wrap if someone feeds 2 km without zeroing
+    if (um > INT32_MAX) return INT32_MAX;
+    if (um < INT32_MIN) return INT32_MIN;
+    return (PositionUM)um;
+}
+
+int64_t EncoderSys::countsToUM(int64_t counts) {
+    return scaleToUM(_scale[_scaleSlot], counts);
+}
+
+int64_t EncoderSys::scaleToUM(const CountScale &scale, int64_t counts) {
+    bool negative = counts < 0;
+    uint64_t c = negative ? (uint64_t)(-counts) : (uint64_t)counts;
+
+    // c * (int + frac/2^32), split so every partial product fits in 64 bits
+    uint64_t cHi = c >> 32;
+    uint64_t cLo = c & 0xFFFFFFFFULL;
+    uint64_t um = (c * scale.umPerCountInt)
+                + (cHi * scale.umPerCountFrac)
+                + ((cLo * scale.umPerCountFrac + 0x80000000ULL) >> 32); // round to nearest
+
+    return negative ? -(int64_t)um : (int64_t)um;
+}
+
+int64_t EncoderSys::umToCounts(int64_t um) {
+    double countsPerUM = PULSES_PER_REV / ((double)_wheelDiameter * PI * UM_PER_MM);
+    int64_t counts = llround((double)um * countsPerUM);
+
+    // Undo the correction too (one fixed-point step: it is small and smooth)
+    const CalibrationTable &correction = _scale[_scaleSlot].correction;
+    if (correction.isActive()) {
+        counts = llround((double)(um - correction.correctionUM(counts)) * countsPerUM);
+    }
+    return counts;
 }
 
 void EncoderSys::setWheelDiameter(float diameterMM) {
@@ -153,11 +362,106 @@ float EncoderSys::getWheelDiameter() {
     return _wheelDiameter;
 }
 
-void EncoderSys::setOffset(float offsetMM) {
-    _offsetMM = offsetMM;
+void EncoderSys::setOffsetUM(PositionUM offsetUM) {
+    publishZero(_zeroCount[_zeroSlot], offsetUM);
+}
+
+PositionUM EncoderSys::getOffsetUM() {
+    return _offsetUM[_zeroSlot];
+}
+
+// ============================================================================
+// FEED CAPTURE
+// ============================================================================
+bool EncoderSys::startFeedCapture(uint32_t sampleHz) {
+#if defined(STM32F4xx)
+    return _feed.start(_hw.instance(), sampleHz, getSnapshot().count);
+#else
+    return false;
+#endif
+}
+
+void EncoderSys::stopFeedCapture() {
+#if defined(STM32F4xx)
+    _feed.stop();
+#endif
+}
+
+uint16_t EncoderSys::drainFeed(FeedSample *out, uint16_t maxSamples) {
+#if defined(STM32F4xx)
+    return _feed.drain(out, maxSamples);
+#else
+    return 0;
+#endif
+}
+
+uint32_t EncoderSys::getFeedOverruns() {
+#if defined(STM32F4xx)
+    return _feed.getOverruns();
+#else
+    return 0;
+#endif
+}
+
+bool EncoderSys::isMeasurementSuspect() {
+    return _diag.isMeasurementSuspect();
+}
+
+void EncoderSys::startMeasurement() {
+    _diag.startWindow();
+}
+
+const EncoderDiag *EncoderSys::getDiag() {
+    return &_diag;
+}
+
+bool EncoderSys::setCorrectionPoints(const int32_t *counts, const int32_t *realUM, uint8_t n) {
+    if (n > CALIB_MAX_POINTS) n = CALIB_MAX_POINTS;
+    for (uint8_t i = 0; i < n; i++) {
+        _corrCounts[i] = counts[i];
+        _corrRealUM[i] = realUM[i];
+    }
+    _corrPoints = n;
+
+    const CountScale &live = _scale[_scaleSlot];
+    publishScale(live.umPerCountInt, live.umPerCountFrac);
+    return hasCorrection();
+}
+
+bool EncoderSys::hasCorrection() {
+    return _scale[_scaleSlot].correction.isActive();
+}
+
+// Builds the spare slot (scale, then the correction refitted against it) and
+// switches the ISRs over in one store
+void EncoderSys::publishScale(uint32_t umPerCountInt, uint32_t umPerCountFrac) {
+    uint8_t next = _scaleSlot ^ 1;
+    CountScale &scale = _scale[next];
+    scale.umPerCountInt = umPerCountInt;
+    scale.umPerCountFrac = umPerCountFrac;
+
+    // Residual of each reference cut against this scale. Lengths are
+    // magnitudes: the wheel may count down depending on mounting.
+    int32_t counts[CALIB_MAX_POINTS];
+    int32_t errorUM[CALIB_MAX_POINTS];
+    for (uint8_t i = 0; i < _corrPoints; i++) {
+        counts[i] = (_corrCounts[i] < 0) ? -_corrCounts[i] : _corrCounts[i];
+        int32_t real = (_corrRealUM[i] < 0) ? -_corrRealUM[i] : _corrRealUM[i];
+        errorUM[i] = (int32_t)(real - scaleToUM(scale, counts[i]));
+    }
+    scale.correction.fit(counts, errorUM, _corrPoints);
+
+    _scaleSlot = next;
 }
 
 void EncoderSys::recalculateCalibration() {
-    float circumference = _wheelDiameter * PI;
-    _mmPerPulse = circumference / PULSES_PER_REV;
+    // Only runs when the diameter changes, so double precision here is free
+    double umPerCount = ((double)_wheelDiameter * PI * UM_PER_MM) / PULSES_PER_REV;
+    if (umPerCount < 0) umPerCount = 0;
+
+    uint32_t umPerCountInt = (uint32_t)umPerCount;
+    publishScale(umPerCountInt, (uint32_t)((umPerCount - umPerCountInt) * 4294967296.0));
+
+    // Limits in counts follow the new scale (published the same way)
+    _diag.setLimits((uint32_t)umToCounts(DIAG_MAX_SPEED_UMS), (uint32_t)umToCounts(DIAG_MAX_ACCEL_UMS2));
 }
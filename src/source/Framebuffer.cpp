@@ -0,0 +1,160 @@
+#include "headers/Framebuffer.h"
+#include "headers/LcdGlyphs.h"
+
+// Classic 5x7 font, ASCII 0x20-0x7F: 5 column bytes, bit 0 = top row.
+// 0x7E/0x7F are the HD44780 ROM arrows (right/left), not ~ and DEL.
+static const uint8_t FONT5X7[96][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, // ' ' !
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, // " #
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 }, // $ %
+    { 0x36, 0x49, 0x55, 0x22, 0x50 }, { 0x00, 0x05, 0x03, 0x00, 0x00 }, // & '
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1C, 0x00 }, // ( )
+    { 0x08, 0x2A, 0x1C, 0x2A, 0x08 }, { 0x08, 0x08, 0x3E, 0x08, 0x08 }, // * +
+    { 0x00, 0x50, 0x30, 0x00, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, // , -
+    { 0x00, 0x60, 0x60, 0x00, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 }, // . /
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 }, // 0 1
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 }, // 2 3
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 }, // 4 5
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 }, // 6 7
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E }, // 8 9
+    { 0x00, 0x36, 0x36, 0x00, 0x00 }, { 0x00, 0x56, 0x36, 0x00, 0x00 }, // : ;
+    { 0x08, 0x14, 0x22, 0x41, 0x00 }, { 0x14, 0x14, 0x14, 0x14, 0x14 }, // < =
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x51, 0x09, 0x06 }, // > ?
+    { 0x32, 0x49, 0x79, 0x41, 0x3E }, { 0x7E, 0x11, 0x11, 0x11, 0x7E }, // @ A
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 }, // B C
+    { 0x7F, 0x41, 0x41, 0x22, 0x1C }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, // D E
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x3E, 0x41, 0x49, 0x49, 0x7A }, // F G
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 }, // H I
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, // J K
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, // L M
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E }, // N O
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, // P Q
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, { 0x46, 0x49, 0x49, 0x49, 0x31 }, // R S
+    { 0x01, 0x01, 0x7F, 0x01, 0x01 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F }, // T U
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, // V W
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x07, 0x08, 0x70, 0x08, 0x07 }, // X Y
+    { 0x61, 0x51, 0x49, 0x45, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x00 }, // Z [
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x7F, 0x00 }, // \ ]
+    { 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x40, 0x40, 0x40, 0x40, 0x40 }, // ^ _
+    { 0x00, 0x01, 0x02, 0x04, 0x00 }, { 0x20, 0x54, 0x54, 0x54, 0x78 }, // ` a
+    { 0x7F, 0x48, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x20 }, // b c
+    { 0x38, 0x44, 0x44, 0x48, 0x7F }, { 0x38, 0x54, 0x54, 0x54, 0x18 }, // d e
+    { 0x08, 0x7E, 0x09, 0x01, 0x02 }, { 0x0C, 0x52, 0x52, 0x52, 0x3E }, // f g
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, // h i
+    { 0x20, 0x40, 0x44, 0x3D, 0x00 }, { 0x7F, 0x10, 0x28, 0x44, 0x00 }, // j k
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x18, 0x04, 0x78 }, // l m
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, // n o
+    { 0x7C, 0x14, 0x14, 0x14, 0x08 }, { 0x08, 0x14, 0x14, 0x18, 0x7C }, // p q
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x20 }, // r s
+    { 0x04, 0x3F, 0x44, 0x40, 0x20 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, // t u
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C }, { 0x3C, 0x40, 0x30, 0x40, 0x3C }, // v w
+    { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x0C, 0x50, 0x50, 0x50, 0x3C }, // x y
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, // z {
+    { 0x00, 0x00, 0x7F, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 }, // | }
+    { 0x08, 0x08, 0x2A, 0x1C, 0x08 }, { 0x08, 0x1C, 0x2A, 0x08, 0x08 }, // right/left arrow
+};
+
+// Doubles every bit: a 8-pixel column becomes 16 pixels tall
+static uint16_t stretch(uint8_t b) {
+    uint16_t v = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        if (b & (1 << i)) v |= 3U << (2 * i);
+    }
+    return v;
+}
+
+// Column bytes (bit 0 = top) of what the HD44780 would show for c
+static void cellColumns(uint8_t c, uint8_t cols[5]) {
+    if (isGlyphCode(c)) {
+        // Row-major 5x8 pattern, bit 4 = leftmost pixel
+        const uint8_t *pattern = glyphPattern(c);
+        for (uint8_t x = 0; x < 5; x++) {
+            cols[x] = 0;
+            for (uint8_t y = 0; y < 8; y++) {
+                if (pattern[y] & (0x10 >> x)) cols[x] |= 1 << y;
+            }
+        }
+    } else if (c >= 0x20 && c < 0x80) {
+        memcpy(cols, FONT5X7[c - 0x20], 5);
+    } else if (c == 0xDB || c == 0xFF) {
+        memset(cols, 0xFF, 5); // Full block
+    } else if (c == 0xDF) {
+        cols[0] = 0x00; cols[1] = 0x07; cols[2] = 0x05; cols[3] = 0x07; cols[4] = 0x00; // Degree
+    } else {
+        memset(cols, 0, 5); // Not in this font
+    }
+}
+
+Framebuffer::Framebuffer() {
+    clear();
+}
+
+void Framebuffer::clear() {
+    memset(_fb, 0, sizeof(_fb));
+    for (uint8_t p = 0; p < OLED_PAGES; p++) {
+        _dirtyLo[p] = 0;
+        _dirtyHi[p] = OLED_WIDTH - 1;
+    }
+}
+
+void Framebuffer::markDirty(uint8_t page, uint8_t x0, uint8_t x1) {
+    if (_dirtyLo[page] > _dirtyHi[page]) {
+        _dirtyLo[page] = x0;
+        _dirtyHi[page] = x1;
+        return;
+    }
+    if (x0 < _dirtyLo[page]) _dirtyLo[page] = x0;
+    if (x1 > _dirtyHi[page]) _dirtyHi[page] = x1;
+}
+
+void Framebuffer::drawCell(uint8_t col, uint8_t row, uint8_t c) {
+    uint8_t cols[5];
+    cellColumns(c, cols);
+
+    uint8_t x = OLED_X0 + col * OLED_CELL_W;
+    uint8_t page = row * 2;
+    for (uint8_t i = 0; i < 5; i++) {
+        uint16_t v = stretch(cols[i]);
+        _fb[page][x + i] = v & 0xFF;
+        _fb[page + 1][x + i] = v >> 8;
+    }
+    _fb[page][x + 5] = 0;
+    _fb[page + 1][x + 5] = 0;
+
+    markDirty(page, x, x + OLED_CELL_W - 1);
+    markDirty(page + 1, x, x + OLED_CELL_W - 1);
+}
+
+void Framebuffer::draw(LcdFrame *frame) {
+    for (uint8_t row = 0; row < LCD_ROWS; row++) {
+        uint32_t cells = frame->commitRow(row);
+        while (cells) {
+            uint8_t col = (uint8_t)__builtin_ctz(cells);
+            cells &= cells - 1;
+            drawCell(col, row, frame->get(col, row));
+        }
+    }
+}
+
+bool Framebuffer::isClean() const {
+    for (uint8_t p = 0; p < OLED_PAGES; p++) {
+        if (_dirtyLo[p] <= _dirtyHi[p]) return false;
+    }
+    return true;
+}
+
+uint16_t Framebuffer::takeWindow(uint8_t page, uint16_t budget, uint8_t *x0) {
+    if (_dirtyLo[page] > _dirtyHi[page]) return 0;
+
+    *x0 = _dirtyLo[page];
+    uint16_t n = (uint16_t)(_dirtyHi[page] - *x0) + 1;
+    if (n > budget) n = budget;
+
+    if (*x0 + n > _dirtyHi[page]) {
+        _dirtyLo[page] = 1; // Empty window
+        _dirtyHi[page] = 0;
+    } else {
+        _dirtyLo[page] = *x0 + n;
+    }
+    return n;
+}
@@ -0,0 +1,39 @@
+#include "headers/Hd44780Backend.h"
+
+Hd44780Backend::Hd44780Backend() : _tx(LCD_ADDR) {
+    _lcd = new LiquidCrystal_I2C(LCD_ADDR, LCD_COLS, LCD_ROWS);
+}
+
+void Hd44780Backend::begin() {
+    // I2C is already running (i2cBus.begin())
+    _lcd->begin();  // fdebrabander begin() takes no arguments
+    _lcd->backlight();
+
+    // Custom characters are uploaded on demand as screens use them
+    _cgram.reset();
+}
+
+void Hd44780Backend::clearScreen() {
+    _tx.drain(); // Queued bytes go first
+    _lcd->clear();
+}
+
+void Hd44780Backend::pump() {
+    if (!_tx.isIdle()) {
+        uint32_t errors = _tx.getErrors();
+        _tx.pump(i2cBus.grant(I2C_CLIENT_LCD, LCD_TX_SLICE_BYTES));
+
+        // The transport has resynced the controller (or will): an upload may
+        // have been cut short, so every glyph goes again. DisplaySys then sees
+        // the error count move and redraws the frame.
+        if (_tx.getErrors() != errors) {
+            _cgram.reset();
+        }
+    }
+}
+
+void Hd44780Backend::beginFrame(LcdFrame *frame) {
+    _cgram.prepare(frame, &_tx); // Glyphs this frame needs, ahead of the cells
+    frame->flush(&_tx, 0x03, _cgram.slotMap()); // Big number first
+    frame->flush(&_tx, 0x0C, _cgram.slotMap());
+}
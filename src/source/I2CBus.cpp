@@ -0,0 +1,166 @@
+#include "headers/I2CBus.h"
+
+I2CBus i2cBus;
+
+// Open-drain emulation for recovery: drive low, or release to the pull-up
+static void lineLow(uint8_t pin) {
+    digitalWrite(pin, LOW);
+    pinMode(pin, OUTPUT);
+    delayMicroseconds(5); // Half a 100 kHz bit
+}
+
+static void lineRelease(uint8_t pin) {
+    pinMode(pin, INPUT_PULLUP);
+    delayMicroseconds(5);
+}
+
+I2CBus::I2CBus() {
+    _passUsed = 0;
+    _failStreak = 0;
+    _recoveries = 0;
+    for (uint8_t i = 0; i < I2C_CLIENT_COUNT; i++) {
+        _transactions[i] = 0;
+        _errors[i] = 0;
+        _waiting[i] = false;
+        _waitPasses[i] = 0;
+        _waitStartMs[i] = 0;
+        _maxWaitMs[i] = 0;
+    }
+}
+
+void I2CBus::begin() {
+    // A reset in the middle of a transaction can leave a slave holding SDA
+    pinMode(PIN_I2C_SDA, INPUT_PULLUP);
+    if (digitalRead(PIN_I2C_SDA) == LOW) {
+        recover();
+        return;
+    }
+    startWire();
+}
+
+void I2CBus::startWire() {
+#if defined(STM32F4xx)
+    Wire.setSDA(PIN_I2C_SDA);
+    Wire.setSCL(PIN_I2C_SCL);
+#endif
+    Wire.begin();
+    Wire.setClock(I2C_CLOCK_HZ);
+}
+
+void I2CBus::startPass() {
+    _passUsed = 0;
+}
+
+uint16_t I2CBus::grant(I2CClient who, uint16_t want) {
+    if (who == I2C_CLIENT_ANGLE || want == 0) {
+        return want;
+    }
+
+    uint16_t granted = 0;
+    bool yield = false;
+    for (uint8_t c = who + 1; c < I2C_CLIENT_COUNT; c++) {
+        if (_waiting[c] && _waitPasses[c] >= I2C_AGING_PASSES) yield = true; // Aged: let it go first
+    }
+    if (!yield && _passUsed < I2C_PASS_BUDGET_BYTES) {
+        granted = I2C_PASS_BUDGET_BYTES - _passUsed;
+        if (granted > want) granted = want;
+    }
+
+    unsigned long now = millis();
+    if (granted == 0) {
+        if (!_waiting[who]) {
+            _waiting[who] = true;
+            _waitPasses[who] = 0;
+            _waitStartMs[who] = now;
+        }
+        if (_waitPasses[who] < 255) _waitPasses[who]++;
+    } else if (_waiting[who]) {
+        _waiting[who] = false;
+        uint32_t waited = now - _waitStartMs[who];
+        if (waited > _maxWaitMs[who]) _maxWaitMs[who] = waited;
+    }
+    return granted;
+}
+
+bool I2CBus::probe(I2CClient who, uint8_t addr) {
+    Wire.beginTransmission(addr);
+    return finish(who, Wire.endTransmission() == 0, 0);
+}
+
+bool I2CBus::write(I2CClient who, uint8_t addr, const uint8_t *data, uint8_t n) {
+    Wire.beginTransmission(addr);
+    Wire.write(data, n);
+    return finish(who, Wire.endTransmission() == 0, n);
+}
+
+bool I2CBus::read(I2CClient who, uint8_t addr, uint8_t *in, uint8_t n) {
+    Wire.requestFrom(addr, n);
+    if (Wire.available() < n) {
+        while (Wire.available()) Wire.read();
+        return finish(who, false, n);
+    }
+    for (uint8_t i = 0; i < n; i++) {
+        in[i] = Wire.read();
+    }
+    return finish(who, true, n);
+}
+
+bool I2CBus::writeRead(I2CClient who, uint8_t addr, const uint8_t *out, uint8_t outLen, uint8_t *in, uint8_t inLen) {
+    Wire.beginTransmission(addr);
+    Wire.write(out, outLen);
+    if (Wire.endTransmission(false) != 0) { // Repeated start: no STOP before the read
+        return finish(who, false, outLen);
+    }
+
+    Wire.requestFrom(addr, inLen);
+    if (Wire.available() < inLen) {
+        while (Wire.available()) Wire.read();
+        return finish(who, false, outLen + inLen);
+    }
+    for (uint8_t i = 0; i < inLen; i++) {
+        in[i] = Wire.read();
+    }
+    return finish(who, true, outLen + inLen);
+}
+
+bool I2CBus::finish(I2CClient who, bool ok, uint16_t bytes) {
+    _transactions[who]++;
+    _passUsed += bytes + 1; // + address byte
+    if (ok) {
+        _failStreak = 0;
+        return true;
+    }
+
+    _errors[who]++;
+    if (++_failStreak >= I2C_RECOVER_AFTER && isStuck()) {
+        recover();
+    }
+    return false;
+}
+
+bool I2CBus::isStuck() const {
+    // Idle bus: both lines pulled high. Readable while Wire owns the pins.
+    return digitalRead(PIN_I2C_SDA) == LOW;
+}
+
+void I2CBus::recover() {
+    Wire.end();
+
+    // Clock out whatever byte the slave thinks it is sending (9 bits max)
+    lineRelease(PIN_I2C_SDA);
+    lineRelease(PIN_I2C_SCL);
+    for (uint8_t i = 0; i < 9 && digitalRead(PIN_I2C_SDA) == LOW; i++) {
+        lineLow(PIN_I2C_SCL);
+        lineRelease(PIN_I2C_SCL);
+    }
+
+    // STOP: SDA rises while SCL is high
+    lineLow(PIN_I2C_SCL);
+    lineLow(PIN_I2C_SDA);
+    lineRelease(PIN_I2C_SCL);
+    lineRelease(PIN_I2C_SDA);
+
+    _failStreak = 0;
+    _recoveries++;
+    startWire();
+}
@@ -0,0 +1,51 @@
+#include "headers/InternalFlash.h"
+
+#if defined(STM32F4xx)
+#include <IWatchdog.h>
+
+#define FLASH_ERROR_FLAGS (FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR | FLASH_FLAG_PGAERR | \
+                           FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR)
+
+uintptr_t flashSectorBase(uint8_t sector) {
+    return (sector == STORAGE_SECTOR_A) ? STORAGE_SECTOR_A_ADDR : STORAGE_SECTOR_B_ADDR;
+}
+
+bool flashProgram(uintptr_t addr, uint32_t word) {
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_ERROR_FLAGS);
+    bool ok = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, word) == HAL_OK;
+    HAL_FLASH_Lock();
+    return ok && *(const volatile uint32_t *)addr == word;
+}
+
+bool flashErase(uint8_t sector) {
+    FLASH_EraseInitTypeDef erase = {};
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Sector = sector;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    uint32_t badSector;
+
+    // The 2 s loop watchdog would bite a slow erase: no reload can run meanwhile
+    bool stretched = IWatchdog.isEnabled();
+    if (stretched) {
+        IWatchdog.set(WATCHDOG_ERASE_TIMEOUT_MS * 1000UL);
+        IWatchdog.reload();
+    }
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_ERROR_FLAGS);
+    bool ok = HAL_FLASHEx_Erase(&erase, &badSector) == HAL_OK;
+    HAL_FLASH_Lock();
+
+    if (stretched) {
+        IWatchdog.set(WATCHDOG_TIMEOUT_MS * 1000UL);
+        IWatchdog.reload();
+    }
+    return ok;
+}
+#else
+uintptr_t flashSectorBase(uint8_t) { return 0; }
+bool flashProgram(uintptr_t, uint32_t) { return false; }
+bool flashErase(uint8_t) { return false; }
+#endif
@@ -0,0 +1,168 @@
+#include "headers/LcdFrame.h"
+
+// HD44780 DDRAM start address of each row (20x4 layout, same as setCursor())
+static const uint8_t ROW_ADDR[4] = { 0x00, 0x40, 0x14, 0x54 };
+// Rows in DDRAM order: 0x00 (row 0) .. 0x14 (row 2) .. 0x40 (row 1) .. 0x54 (row 3)
+static const uint8_t FLUSH_ORDER[4] = { 0, 2, 1, 3 };
+
+// Address after a data write (DDRAM lines are 0x00-0x27 and 0x40-0x67)
+static uint8_t nextAddr(uint8_t addr) {
+    addr++;
+    if (addr == 0x28) return 0x40;
+    if (addr == 0x68) return 0x00;
+    return addr;
+}
+
+LcdFrame::LcdFrame() {
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        for (uint8_t c = 0; c < LCD_COLS; c++) {
+            _want[r][c] = ' ';
+            _shown[r][c] = ' ';
+        }
+    }
+    invalidateAll();
+}
+
+void LcdFrame::updateDirty(uint8_t col, uint8_t row) {
+    uint32_t bit = 1UL << col;
+    if ((_stale[row] & bit) || _want[row][col] != _shown[row][col]) {
+        _dirty[row] |= bit;
+    } else {
+        _dirty[row] &= ~bit;
+    }
+}
+
+void LcdFrame::put(uint8_t col, uint8_t row, uint8_t c) {
+    if (col >= LCD_COLS || row >= LCD_ROWS) return;
+    _want[row][col] = c;
+    updateDirty(col, row);
+}
+
+void LcdFrame::write(uint8_t col, uint8_t row, const char *s, uint8_t width) {
+    for (uint8_t i = 0; i < width && col + i < LCD_COLS; i++) {
+        char ch = *s;
+        if (ch != '\0') {
+            s++;
+        } else {
+            ch = ' ';
+        }
+        put(col + i, row, (uint8_t)ch);
+    }
+}
+
+void LcdFrame::fill(uint8_t col, uint8_t row, uint8_t c, uint8_t n) {
+    for (uint8_t i = 0; i < n && col + i < LCD_COLS; i++) {
+        put(col + i, row, c);
+    }
+}
+
+void LcdFrame::invalidate(uint8_t col, uint8_t row, uint8_t n) {
+    if (row >= LCD_ROWS) return;
+    for (uint8_t i = 0; i < n && col + i < LCD_COLS; i++) {
+        _stale[row] |= 1UL << (col + i);
+        _dirty[row] |= 1UL << (col + i);
+    }
+    _cursorValid = false;
+}
+
+void LcdFrame::invalidateAll() {
+    uint32_t all = (LCD_COLS == 32) ? 0xFFFFFFFFUL : ((1UL << LCD_COLS) - 1);
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        _stale[r] = all;
+        _dirty[r] = all;
+    }
+    _cursorValid = false;
+}
+
+void LcdFrame::invalidateCode(uint8_t c) {
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        for (uint8_t col = 0; col < LCD_COLS; col++) {
+            if (_shown[r][col] == c) {
+                _stale[r] |= 1UL << col;
+                _dirty[r] |= 1UL << col;
+            }
+        }
+    }
+}
+
+void LcdFrame::cleared() {
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        _stale[r] = 0;
+        for (uint8_t c = 0; c < LCD_COLS; c++) {
+            _shown[r][c] = ' ';
+            updateDirty(c, r);
+        }
+    }
+    _cursor = 0x00;
+    _cursorValid = true;
+}
+
+void LcdFrame::cursorLost() {
+    _cursorValid = false;
+}
+
+bool LcdFrame::isDirty() const {
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        if (_dirty[r]) return true;
+    }
+    return false;
+}
+
+void LcdFrame::countGlyphs(uint8_t counts[GLYPH_COUNT]) const {
+    for (uint8_t g = 0; g < GLYPH_COUNT; g++) {
+        counts[g] = 0;
+    }
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        for (uint8_t c = 0; c < LCD_COLS; c++) {
+            if (isGlyphCode(_want[r][c])) {
+                counts[_want[r][c] - GLYPH_BASE]++;
+            }
+        }
+    }
+}
+
+uint32_t LcdFrame::commitRow(uint8_t row) {
+    uint32_t cells = _dirty[row];
+    for (uint8_t c = 0; c < LCD_COLS; c++) {
+        if (cells & (1UL << c)) _shown[row][c] = _want[row][c];
+    }
+    _dirty[row] = 0;
+    _stale[row] = 0;
+    _cursorValid = false; // Not tracked for these backends
+    return cells;
+}
+
+uint16_t LcdFrame::flush(LcdTransport *out, uint8_t rowMask, const uint8_t *glyphMap) {
+    uint16_t bytes = 0;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t row = FLUSH_ORDER[i];
+        if (row >= LCD_ROWS || !(rowMask & (1 << row))) continue;
+
+        while (_dirty[row]) {
+            uint8_t col = (uint8_t)__builtin_ctz(_dirty[row]);
+            uint8_t addr = ROW_ADDR[row] + col;
+            bool move = !_cursorValid || addr != _cursor;
+
+            if (out->room() < (move ? 2 : 1)) {
+                return bytes; // Back-pressure: resume here next time
+            }
+            if (move) {
+                out->setCursor(col, row);
+                bytes++;
+            }
+            uint8_t c = _want[row][col];
+            out->data(isGlyphCode(c) ? glyphMap[c - GLYPH_BASE] : c);
+            bytes++;
+
+            uint32_t bit = 1UL << col;
+            _shown[row][col] = _want[row][col];
+            _dirty[row] &= ~bit;
+            _stale[row] &= ~bit;
+            _cursor = nextAddr(addr);
+            _cursorValid = true;
+        }
+    }
+
+    return bytes;
+}
@@ -0,0 +1,35 @@
+#include "headers/LcdGlyphs.h"
+
+// Const data stays in flash on the STM32
+static const uint8_t PATTERNS[GLYPH_COUNT][8] = {
+    // Big-digit bars
+    { 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // Upper bar (2 rows)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F }, // Lower bar (2 rows)
+    { 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F }, // Upper and lower bar (2+2 rows)
+    { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 }, // Left bar (2 pixels wide, full height)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x18 }, // Left lower bar (2 pixels)
+    { 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x18, 0x18 }, // Left upper and lower (2 pixels)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E }, // Decimal point
+    { 0x00, 0x00, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00 }, // Colon
+
+    // Menu icons
+    { 0x00, 0x10, 0x10, 0x14, 0x15, 0x15, 0x1F, 0x00 }, // Statistics/Bar Chart (Units, Statistics)
+    { 0x00, 0x1F, 0x11, 0x11, 0x11, 0x1F, 0x00, 0x00 }, // Rectangular Tube
+    { 0x00, 0x10, 0x10, 0x10, 0x10, 0x1F, 0x00, 0x00 }, // Angle Iron (L)
+    { 0x00, 0x0E, 0x15, 0x15, 0x17, 0x11, 0x0E, 0x00 }, // Gear (Calibration)
+    { 0x00, 0x18, 0x1C, 0x0E, 0x06, 0x07, 0x03, 0x00 }, // Blade (Auto-Zero, Kerf, AZ Threshold)
+    { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00, 0x00 }, // Settings (Crosshair)
+    { 0x04, 0x0E, 0x1F, 0x00, 0x00, 0x1F, 0x0E, 0x04 }, // Direction (Double Arrow)
+    { 0x00, 0x10, 0x18, 0x1C, 0x1E, 0x1F, 0x00, 0x00 }, // Angle
+};
+
+const uint8_t *glyphPattern(uint8_t code) {
+    return PATTERNS[(code - GLYPH_BASE) & (GLYPH_COUNT - 1)];
+}
+
+uint8_t glyphForMenuChar(uint8_t c) {
+    if (c >= 0x01 && c <= 0x08) {
+        return GLYPH_ICON_STATS + (c & 0x07); // \x08 -> icon 0
+    }
+    return c;
+}
@@ -0,0 +1,140 @@
+#include "headers/LcdTransport.h"
+#include "headers/I2CBus.h"
+
+#define PCF_RS 0x01
+#define PCF_EN 0x04
+
+#define LCD_CMD_SETDDRAMADDR 0x80
+#define LCD_CMD_FUNCTION_4BIT_2LINE 0x28
+#define LCD_CMD_DISPLAY_ON 0x0C  // Cursor and blink off
+#define LCD_CMD_ENTRY_LEFT 0x06  // Increment, no shift
+
+// HD44780 DDRAM start address of each row (20x4 layout)
+static const uint8_t ROW_ADDR[4] = { 0x00, 0x40, 0x14, 0x54 };
+
+LcdTransport::LcdTransport(uint8_t addr) {
+    _addr = addr;
+    _backlight = 0x08;
+    _head = 0;
+    _tail = 0;
+    _errors = 0;
+    _bytesSent = 0;
+    _resyncPending = false;
+}
+
+uint16_t LcdTransport::room() const {
+    uint16_t used = (uint16_t)(_head - _tail);
+    return (LCD_TX_QUEUE_BYTES - used) / 4;
+}
+
+// One LCD byte as the 4 expander writes that clock it in
+void LcdTransport::encode(uint8_t value, uint8_t mode, uint8_t *out) const {
+    uint8_t hi = (value & 0xF0) | mode | _backlight;
+    uint8_t lo = ((value << 4) & 0xF0) | mode | _backlight;
+    out[0] = hi | PCF_EN;
+    out[1] = hi;
+    out[2] = lo | PCF_EN;
+    out[3] = lo;
+}
+
+bool LcdTransport::queueByte(uint8_t value, uint8_t mode) {
+    if (room() == 0) {
+        return false;
+    }
+    uint8_t bytes[4];
+    encode(value, mode, bytes);
+    for (uint8_t i = 0; i < 4; i++) {
+        _buf[_head++ & (LCD_TX_QUEUE_BYTES - 1)] = bytes[i];
+    }
+    return true;
+}
+
+bool LcdTransport::command(uint8_t cmd) {
+    return queueByte(cmd, 0);
+}
+
+bool LcdTransport::data(uint8_t c) {
+    return queueByte(c, PCF_RS);
+}
+
+bool LcdTransport::setCursor(uint8_t col, uint8_t row) {
+    if (row >= 4) row = 3;
+    return command(LCD_CMD_SETDDRAMADDR | (ROW_ADDR[row] + col));
+}
+
+uint16_t LcdTransport::pump(uint16_t maxBytes) {
+    if (_resyncPending && !resync()) {
+        _tail = _head; // Still not answering: what was queued is lost too
+        return 0;
+    }
+
+    maxBytes &= ~3; // Whole LCD bytes only: a slice never ends mid-character
+    uint16_t sent = 0;
+    while (sent < maxBytes && _head != _tail) {
+        uint16_t n = (uint16_t)(_head - _tail);
+        if (n > LCD_TX_CHUNK) n = LCD_TX_CHUNK;
+        if (n > maxBytes - sent) n = maxBytes - sent;
+
+        uint8_t chunk[LCD_TX_CHUNK];
+        for (uint16_t i = 0; i < n; i++) {
+            chunk[i] = _buf[_tail++ & (LCD_TX_QUEUE_BYTES - 1)];
+        }
+        sent += n;
+        if (!i2cBus.write(I2C_CLIENT_LCD, _addr, chunk, n)) {
+            _errors++; // Bytes are gone either way: the owner redraws the screen
+            _tail = _head;
+            resync();
+            break;
+        }
+    }
+    _bytesSent += sent;
+    return sent;
+}
+
+void LcdTransport::drain() {
+    while (_head != _tail) {
+        pump(LCD_TX_QUEUE_BYTES);
+    }
+}
+
+// Single nibble with RS low: the only way to talk to the controller before
+// the nibble phase is known
+bool LcdTransport::writeNibble(uint8_t nibble) {
+    uint8_t out[2] = { (uint8_t)((nibble << 4) | _backlight | PCF_EN), (uint8_t)((nibble << 4) | _backlight) };
+    if (!i2cBus.write(I2C_CLIENT_LCD, _addr, out, 2)) {
+        _errors++;
+        return false;
+    }
+    _bytesSent += 2;
+    return true;
+}
+
+// HD44780 "initialisation by instruction": the first 0x3 lands as the low
+// nibble of a half-sent byte, or as a function set; three of them leave it in
+// 8-bit mode whatever it was doing, 0x2 then selects 4-bit
+bool LcdTransport::resync() {
+    static const uint8_t NIBBLES[4] = { 0x3, 0x3, 0x3, 0x2 };
+    static const uint16_t WAIT_US[4] = { 4500, 150, 50, 50 }; // The first may have been a 1.5 ms home/clear
+
+    _resyncPending = true;
+    for (uint8_t i = 0; i < 4; i++) {
+        if (!writeNibble(NIBBLES[i])) {
+            return false;
+        }
+        delayMicroseconds(WAIT_US[i]);
+    }
+
+    // As the library's begin() left it
+    static const uint8_t SETUP[3] = { LCD_CMD_FUNCTION_4BIT_2LINE, LCD_CMD_DISPLAY_ON, LCD_CMD_ENTRY_LEFT };
+    uint8_t out[12];
+    for (uint8_t i = 0; i < 3; i++) {
+        encode(SETUP[i], 0, &out[i * 4]);
+    }
+    if (!i2cBus.write(I2C_CLIENT_LCD, _addr, out, sizeof(out))) {
+        _errors++;
+        return false;
+    }
+    _bytesSent += sizeof(out);
+    _resyncPending = false;
+    return true;
+}
@@ -0,0 +1,75 @@
+#include "headers/LineBuf.h"
+
+static const uint32_t POW10[] = { 1, 10, 100, 1000, 10000, 100000 };
+
+LineBuf &LineBuf::add(const char *s) {
+    while (*s && _len < LINEBUF_CAPACITY) {
+        _buf[_len++] = *s++;
+    }
+    _buf[_len] = '\0';
+    return *this;
+}
+
+LineBuf &LineBuf::add(char c) {
+    if (_len < LINEBUF_CAPACITY) {
+        _buf[_len++] = c;
+        _buf[_len] = '\0';
+    }
+    return *this;
+}
+
+LineBuf &LineBuf::addUInt(uint32_t v) {
+    char tmp[10];
+    uint8_t n = 0;
+    do {
+        tmp[n++] = '0' + (v % 10);
+        v /= 10;
+    } while (v > 0);
+    while (n > 0) {
+        add(tmp[--n]);
+    }
+    return *this;
+}
+
+LineBuf &LineBuf::addInt(int32_t v) {
+    if (v < 0) {
+        add('-');
+        return addUInt((uint32_t)(-(int64_t)v));
+    }
+    return addUInt((uint32_t)v);
+}
+
+LineBuf &LineBuf::addFixed(int32_t scaled, uint8_t decimals) {
+    if (decimals > 5) decimals = 5;
+    uint32_t mag = (scaled < 0) ? (uint32_t)(-(int64_t)scaled) : (uint32_t)scaled;
+    if (scaled < 0) add('-');
+
+    addUInt(mag / POW10[decimals]);
+    if (decimals == 0) return *this;
+
+    add('.');
+    uint32_t frac = mag % POW10[decimals];
+    for (uint8_t d = decimals; d > 0; d--) {
+        add('0' + (frac / POW10[d - 1]) % 10);
+    }
+    return *this;
+}
+
+LineBuf &LineBuf::addFloat(float v, uint8_t decimals) {
+    if (decimals > 5) decimals = 5;
+    float scaled = v * (float)POW10[decimals];
+    // Out of int32 range: nothing a 20-column line could show anyway
+    if (scaled > 2147483000.0f || scaled < -2147483000.0f) {
+        return add("OVF");
+    }
+    return addFixed((int32_t)lroundf(scaled), decimals);
+}
+
+LineBuf &LineBuf::pad(char c, uint8_t width) {
+    if (width > LINEBUF_CAPACITY) width = LINEBUF_CAPACITY;
+    while (_len < width) {
+        _buf[_len++] = c;
+    }
+    _buf[_len] = '\0';
+    return *this;
+}
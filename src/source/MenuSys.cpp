@@ -20,10 +20,29 @@ void MenuSys::init(SystemSettings *settings, StatsSys *stats, AngleSensor *angle
     _exitRequest = false;
     _lastActivityTime = millis(); // CRITICAL: Reset timeout timer!
     _warningEndTime = 0;
+    _editSteps = 1;
 }
 
 bool MenuSys::update(InputEvent e, DisplaySys *display, EncoderSys *encoder)
 {
+    if (!handleEvent(e, display, encoder))
+    {
+        return false;
+    }
+
+    if (_needsRedraw)
+    {
+        render(display);
+        _needsRedraw = false;
+    }
+
+    return !_exitRequest;
+}
+
+bool MenuSys::handleEvent(InputEvent e, DisplaySys *display, EncoderSys *encoder, uint8_t steps)
+{
+    _editSteps = (steps > 0) ? steps : 1;
+
     if (e != EVENT_NONE)
     {
         _lastActivityTime = millis();
@@ -34,10 +53,9 @@ bool MenuSys::update(InputEvent e, DisplaySys *display, EncoderSys *encoder)
         return false;
     }
 
-    // Check for state change and clear screen if needed
+    // State change: redraw (every screen writes all four rows, no clear needed)
     if (_state != _lastState)
     {
-        display->clear();
         _lastState = _state;
         _needsRedraw = true;
     }
@@ -90,8 +108,8 @@ bool MenuSys::update(InputEvent e, DisplaySys *display, EncoderSys *encoder)
             return true;
 
         case MENU_AUTO_CALIB:
-        case MENU_CALIB_ANGLE_0:
-        case MENU_CALIB_ANGLE_45:
+        case MENU_MULTI_CALIB:
+        case MENU_CALIB_ANGLE:
             // Return to calibration submenu
             _state = MENU_CALIBRATION_SUBMENU;
             _needsRedraw = true;
@@ -142,7 +160,11 @@ bool MenuSys::update(InputEvent e, DisplaySys *display, EncoderSys *encoder)
     {
         handleAutoCalib(e, encoder);
     }
-    else if (_state == MENU_CALIB_ANGLE_0 || _state == MENU_CALIB_ANGLE_45)
+    else if (_state == MENU_MULTI_CALIB)
+    {
+        handleMultiCalib(e, encoder);
+    }
+    else if (_state == MENU_CALIB_ANGLE)
     {
         handleAngleWizard(e);
     }
@@ -155,12 +177,6 @@ bool MenuSys::update(InputEvent e, DisplaySys *display, EncoderSys *encoder)
         handleEdit(e);
     }
 
-    if (_needsRedraw)
-    {
-        render(display);
-        _needsRedraw = false;
-    }
-
     return !_exitRequest;
 }
 
@@ -359,17 +375,18 @@ void MenuSys::handleStatsGlobal(InputEvent e)
 
 void MenuSys::handleCalibrationSubmenu(InputEvent e)
 {
-    // Calibration submenu: 5 items (0-4)
+    // Calibration submenu: 6 items (0-5)
     // 0: Wheel Wizard (auto-calibrate)
     // 1: Angle Wizard (calibrate angle sensor)
     // 2: Wheel Diameter (manual fine-tune)
     // 3: Kerf Thickness
-    // 4: Back
+    // 4: Multi-Point Wizard (correction table)
+    // 5: Back
 
     if (e == EVENT_NEXT)
     {
         _calibSubItem++;
-        if (_calibSubItem > 4)
+        if (_calibSubItem > 5)
             _calibSubItem = 0;
         _needsRedraw = true;
     }
@@ -377,7 +394,7 @@ void MenuSys::handleCalibrationSubmenu(InputEvent e)
     {
         _calibSubItem--;
         if (_calibSubItem < 0)
-            _calibSubItem = 4;
+            _calibSubItem = 5;
         _needsRedraw = true;
     }
 
@@ -399,7 +416,10 @@ void MenuSys::handleCalibrationSubmenu(InputEvent e)
             // Angle Wizard - check if sensor is enabled first
             if (_settings->useAngleSensor)
             {
-                _state = MENU_CALIB_ANGLE_0;
+                _state = MENU_CALIB_ANGLE;
+                _calibStep = 0;
+                _angleCount = 0;
+                _angleSaveSelected = false;
             }
             else
             {
@@ -421,6 +441,14 @@ void MenuSys::handleCalibrationSubmenu(InputEvent e)
             _tempKerf = _settings->kerfMM;
         }
         else if (_calibSubItem == 4)
+        {
+            // Multi-Point Wizard
+            _state = MENU_MULTI_CALIB;
+            _calibStep = 0;
+            _multiCount = 0;
+            _multiSaveSelected = false;
+        }
+        else if (_calibSubItem == 5)
         {
             // Back to main menu
             _state = MENU_NAVIGATE;
@@ -433,18 +461,19 @@ void MenuSys::handleCalibrationSubmenu(InputEvent e)
 
 void MenuSys::handleSettingsSubmenu(InputEvent e)
 {
-    // Settings submenu: 6 items (0-5)
+    // Settings submenu: 7 items (0-6)
     // 0: Units (METRIC/IMPERIAL)
     // 1: Angle Source (MANUAL/AUTO)
     // 2: Auto-Zero (ON/OFF)
     // 3: Auto-Zero Threshold
-    // 4: Direction (FWD/REV)
-    // 5: Back
+    // 4: Auto-Zero Arm Delay
+    // 5: Direction (FWD/REV)
+    // 6: Back
 
     if (e == EVENT_NEXT)
     {
         _settingsSubItem++;
-        if (_settingsSubItem > 5)
+        if (_settingsSubItem > 6)
             _settingsSubItem = 0;
         _needsRedraw = true;
     }
@@ -452,7 +481,7 @@ void MenuSys::handleSettingsSubmenu(InputEvent e)
     {
         _settingsSubItem--;
         if (_settingsSubItem < 0)
-            _settingsSubItem = 5;
+            _settingsSubItem = 6;
         _needsRedraw = true;
     }
 
@@ -487,11 +516,19 @@ void MenuSys::handleSettingsSubmenu(InputEvent e)
             _currentItem = -1;   // Prevent main menu edit logic from activating
         }
         else if (_settingsSubItem == 4)
+        {
+            // Edit Auto-Zero Arm Delay
+            _state = MENU_EDIT;
+            _tempAZArm = _settings->autoZeroArmMs;
+            _calibSubItem = -1;
+            _currentItem = -1;
+        }
+        else if (_settingsSubItem == 5)
         {
             // Toggle Direction
             _settings->reverseDirection = !_settings->reverseDirection;
         }
-        else if (_settingsSubItem == 5)
+        else if (_settingsSubItem == 6)
         {
             // Back to main menu
             _state = MENU_NAVIGATE;
@@ -519,7 +556,7 @@ void MenuSys::handleAutoCalib(InputEvent e, EncoderSys *encoder)
         {
             _calibPulses = encoder->getRawCount();
             // Initialize with encoder's measurement as a smart starting point
-            _calibRealLen = encoder->getDistanceMM();
+            _calibRealLen = umToMM(encoder->getDistanceUM());
             _calibStep = 2;
             _needsRedraw = true;
         }
@@ -529,12 +566,12 @@ void MenuSys::handleAutoCalib(InputEvent e, EncoderSys *encoder)
         // Fine adjustment: 1mm = 0.1 CM (precise control)
         if (e == EVENT_NEXT)
         {
-            _calibRealLen += 1.0;
+            _calibRealLen += 1.0 * _editSteps;
             _needsRedraw = true;
         }
         else if (e == EVENT_PREV)
         {
-            _calibRealLen -= 1.0;
+            _calibRealLen -= 1.0 * _editSteps;
             _needsRedraw = true;
         }
         else if (e == EVENT_CLICK)
@@ -555,6 +592,10 @@ void MenuSys::handleAutoCalib(InputEvent e, EncoderSys *encoder)
 
                 _settings->wheelDiameter = newDia;
                 encoder->setWheelDiameter(newDia);
+
+                // A fresh single-point fit replaces the multi-point table
+                _settings->calibPointCount = 0;
+                encoder->setCorrectionPoints(_settings->calibCounts, _settings->calibRealUM, 0);
             }
             _state = MENU_CALIBRATION_SUBMENU;
             _needsRedraw = true;
@@ -562,21 +603,135 @@ void MenuSys::handleAutoCalib(InputEvent e, EncoderSys *encoder)
     }
 }
 
+void MenuSys::handleMultiCalib(InputEvent e, EncoderSys *encoder)
+{
+    // Same zero / cut / measure steps as the wheel wizard, repeated for up to
+    // CALIB_MAX_POINTS reference cuts of different lengths (short to full bar)
+    if (_calibStep == 0)
+    {
+        if (e == EVENT_CLICK)
+        {
+            encoder->reset();
+            _calibStep = 1;
+            _needsRedraw = true;
+        }
+    }
+    else if (_calibStep == 1)
+    {
+        if (e == EVENT_CLICK)
+        {
+            _calibPulses = encoder->getRawCount();
+            // Start from the diameter-only length: the correction is what we're measuring
+            _calibRealLen = encoder->countsToUM(_calibPulses) / (float)UM_PER_MM;
+            _calibStep = 2;
+            _needsRedraw = true;
+        }
+    }
+    else if (_calibStep == 2)
+    {
+        if (e == EVENT_NEXT)
+        {
+            _calibRealLen += 1.0 * _editSteps;
+            _needsRedraw = true;
+        }
+        else if (e == EVENT_PREV)
+        {
+            _calibRealLen -= 1.0 * _editSteps;
+            _needsRedraw = true;
+        }
+        else if (e == EVENT_CLICK)
+        {
+            if (_calibPulses != 0)
+            {
+                _multiCounts[_multiCount] = (int32_t)_calibPulses;
+                _multiRealUM[_multiCount] = mmToUM(abs(_calibRealLen));
+                _multiCount++;
+            }
+            _multiSaveSelected = (_multiCount >= CALIB_MAX_POINTS);
+            _calibStep = 3;
+            _needsRedraw = true;
+        }
+    }
+    else if (_calibStep == 3)
+    {
+        if ((e == EVENT_NEXT || e == EVENT_PREV) && _multiCount < CALIB_MAX_POINTS)
+        {
+            _multiSaveSelected = !_multiSaveSelected;
+            _needsRedraw = true;
+        }
+        else if (e == EVENT_CLICK)
+        {
+            if (!_multiSaveSelected)
+            {
+                _calibStep = 0; // Next reference cut
+            }
+            else
+            {
+                _settings->calibPointCount = _multiCount;
+                for (uint8_t i = 0; i < _multiCount; i++)
+                {
+                    _settings->calibCounts[i] = _multiCounts[i];
+                    _settings->calibRealUM[i] = _multiRealUM[i];
+                }
+                encoder->setCorrectionPoints(_multiCounts, _multiRealUM, _multiCount);
+                _state = MENU_CALIBRATION_SUBMENU;
+            }
+            _needsRedraw = true;
+        }
+    }
+}
+
 void MenuSys::handleAngleWizard(InputEvent e)
 {
-    if (e == EVENT_CLICK)
+    // Capture the (filtered) raw reading at 0, 15, 30 ... degrees. From the
+    // second point on the table can be saved, for saws that stop short of 60.
+    if (_calibStep == 0)
     {
-        uint16_t raw = _angleSensor->getRawAngle();
-        if (_state == MENU_CALIB_ANGLE_0)
+        if (e == EVENT_CLICK)
         {
-            _angleSensor->setZeroPoint(raw);
-            _state = MENU_CALIB_ANGLE_45;
+            _angleRaw[_angleCount++] = _angleSensor->getRawAngle();
+            if (_angleCount >= 2)
+            {
+                _angleSaveSelected = (_angleCount >= ANGLE_CALIB_POINTS);
+                _calibStep = 1;
+            }
+            _needsRedraw = true;
         }
-        else
+    }
+    else if (_calibStep == 1)
+    {
+        if ((e == EVENT_NEXT || e == EVENT_PREV) && _angleCount < ANGLE_CALIB_POINTS)
         {
-            _angleSensor->set45Point(raw);
-            _state = MENU_CALIBRATION_SUBMENU;
+            _angleSaveSelected = !_angleSaveSelected;
+            _needsRedraw = true;
+        }
+        else if (e == EVENT_CLICK)
+        {
+            if (!_angleSaveSelected)
+            {
+                _calibStep = 0; // Next angle
+            }
+            else if (_angleSensor->setCalibration(_angleRaw, _angleCount))
+            {
+                _settings->angleCalibCount = _angleCount;
+                for (uint8_t i = 0; i < _angleCount; i++)
+                {
+                    _settings->angleCalibRaw[i] = _angleRaw[i];
+                }
+                _state = MENU_CALIBRATION_SUBMENU;
+            }
+            else
+            {
+                _calibStep = 2; // Readings don't move steadily one way
+            }
+            _needsRedraw = true;
         }
+    }
+    else if (e == EVENT_CLICK)
+    {
+        // Start over from 0 degrees
+        _angleCount = 0;
+        _calibStep = 0;
         _needsRedraw = true;
     }
 }
@@ -657,12 +812,12 @@ void MenuSys::handleEdit(InputEvent e)
     {
         if (e == EVENT_NEXT)
         {
-            _tempRate += 1.0;
+            _tempRate += 1.0 * _editSteps;
             _needsRedraw = true;
         }
         else if (e == EVENT_PREV)
         {
-            _tempRate -= 1.0;
+            _tempRate -= 1.0 * _editSteps;
             if (_tempRate < 0)
                 _tempRate = 0;
             _needsRedraw = true;
@@ -681,14 +836,12 @@ void MenuSys::handleEdit(InputEvent e)
     {
         if (e == EVENT_NEXT)
         {
-            if (_tempCutMode < 45)
-                _tempCutMode++;
+            _tempCutMode = min(45, _tempCutMode + _editSteps);
             _needsRedraw = true;
         }
         else if (e == EVENT_PREV)
         {
-            if (_tempCutMode > 0)
-                _tempCutMode--;
+            _tempCutMode = max(0, _tempCutMode - _editSteps);
             _needsRedraw = true;
         }
         else if (e == EVENT_CLICK)
@@ -701,12 +854,13 @@ void MenuSys::handleEdit(InputEvent e)
     // Calibration Value Editing (from System Setup menu)
     else if (_calibSubItem >= 0 && _calibSubItem <= 3 && _state == MENU_EDIT)
     {
-        if (_calibSubItem == 0)
+        if (_calibSubItem == 2)
         {
+            // Wheel Diameter editing
             if (e == EVENT_NEXT)
-                _tempDia += 0.1;
+                _tempDia += 0.1 * _editSteps;
             else if (e == EVENT_PREV)
-                _tempDia -= 0.1;
+                _tempDia -= 0.1 * _editSteps;
             else if (e == EVENT_CLICK)
             {
                 _settings->wheelDiameter = _tempDia;
@@ -714,26 +868,13 @@ void MenuSys::handleEdit(InputEvent e)
             }
             _needsRedraw = true;
         }
-        else if (_calibSubItem == 1)
-        {
-            if (e == EVENT_NEXT)
-                _tempKerf += 0.1;
-            else if (e == EVENT_PREV)
-                _tempKerf -= 0.1;
-            else if (e == EVENT_CLICK)
-            {
-                _settings->kerfMM = max(0.0f, _tempKerf);
-                _state = MENU_CALIBRATION_SUBMENU;
-            }
-            _needsRedraw = true;
-        }
         else if (_calibSubItem == 3)
         {
             // Kerf Thickness editing
             if (e == EVENT_NEXT)
-                _tempKerf += 0.1;
+                _tempKerf += 0.1 * _editSteps;
             else if (e == EVENT_PREV)
-                _tempKerf -= 0.1;
+                _tempKerf -= 0.1 * _editSteps;
             else if (e == EVENT_CLICK)
             {
                 _settings->kerfMM = max(0.0f, _tempKerf);
@@ -743,15 +884,15 @@ void MenuSys::handleEdit(InputEvent e)
         }
     }
     // Settings Value Editing (from Settings submenu)
-    else if (_settingsSubItem >= 0 && _settingsSubItem <= 5 && _state == MENU_EDIT)
+    else if (_settingsSubItem >= 0 && _settingsSubItem <= 6 && _state == MENU_EDIT)
     {
         if (_settingsSubItem == 3)
         {
             // Auto-Zero Threshold editing
             if (e == EVENT_NEXT)
-                _tempAZThresh += 0.5;
+                _tempAZThresh += 0.5 * _editSteps;
             else if (e == EVENT_PREV)
-                _tempAZThresh -= 0.5;
+                _tempAZThresh -= 0.5 * _editSteps;
             else if (e == EVENT_CLICK)
             {
                 _settings->autoZeroThresholdMM = constrain(_tempAZThresh, 2.0, 20.0);
@@ -759,52 +900,59 @@ void MenuSys::handleEdit(InputEvent e)
             }
             _needsRedraw = true;
         }
+        else if (_settingsSubItem == 4)
+        {
+            // Auto-Zero Arm Delay editing (50 ms steps)
+            if (e == EVENT_NEXT)
+                _tempAZArm = min(5000, _tempAZArm + 50 * _editSteps);
+            else if (e == EVENT_PREV)
+                _tempAZArm = max(50, _tempAZArm - 50 * _editSteps);
+            else if (e == EVENT_CLICK)
+            {
+                _settings->autoZeroArmMs = constrain(_tempAZArm, 50, 5000);
+                _state = MENU_SETTINGS_SUBMENU;
+            }
+            _needsRedraw = true;
+        }
     }
 }
 
-void MenuSys::render(DisplaySys *display)
+// " TITLE " centred in a line of '='
+static void header(LineBuf &out, const char *title)
 {
-    auto header = [](String s) -> String
-    {
-        s = " " + s + " ";
-        int len = s.length();
-        if (len >= 20)
-            return s.substring(0, 20);
-        int padLeft = (20 - len) / 2;
-        String res = "";
-        for (int i = 0; i < padLeft; i++)
-            res += "=";
-        res += s;
-        while (res.length() < 20)
-            res += "=";
-        return res;
-    };
+    LineBuf s;
+    s.add(' ').add(title).add(' ');
+    out.clear();
+    if (s.length() < LCD_COLS)
+        out.pad('=', (LCD_COLS - s.length()) / 2);
+    out.add(s.c_str());
+    out.pad('=', LCD_COLS);
+}
 
-    auto center = [](String s) -> String
-    {
-        int len = s.length();
-        if (len >= 20)
-            return s.substring(0, 20);
-        int pad = (20 - len) / 2;
-        String res = "";
-        for (int i = 0; i < pad; i++)
-            res += " ";
-        res += s;
-        while (res.length() < 20)
-            res += " ";
-        return res;
-    };
+static void center(LineBuf &out, const char *text)
+{
+    LineBuf s(text);
+    out.clear();
+    if (s.length() < LCD_COLS)
+        out.pad(' ', (LCD_COLS - s.length()) / 2);
+    out.add(s.c_str());
+}
+
+void MenuSys::render(DisplaySys *display)
+{
+    // All lines are fixed-size stack buffers: no heap traffic per frame
+    LineBuf l0, l1, l2, l3;
 
     // Check for flashing warning message
     if (_warningEndTime > 0)
     {
         if (millis() < _warningEndTime)
         {
-            display->showMenu4(
-                header("! WARNING !"),
-                center("CHANGE ANGLE SRC"),
-                center("TO AUTO"),
-                center("IN SETTINGS"));
+            header(l0, "! WARNING !");
+            center(l1, "CHANGE ANGLE SRC");
+            center(l2, "TO AUTO");
+            center(l3, "IN SETTINGS");
+            display->showMenu4(l0.c_str(), l1.c_str(), l2.c_str(), l3.c_str());
             return;
         }
         else
@@ -815,87 +963,141 @@ void MenuSys::render(DisplaySys *display)
 
     if (_state == MENU_AUTO_CALIB)
     {
-        String l0, l1, l2, l3;
         if (_calibStep == 0)
         {
             // Step 1: Zero the encoder
-            l0 = header("\x04 AUTO CALIB");
-            l1 = center(" => STEP 1 <=");
-            l2 = center("TOUCH BLADE AND ZERO");
-            l3 = center("THEN CLICK");
+            header(l0, "\x04 AUTO CALIB");
+            center(l1, " => STEP 1 <=");
+            center(l2, "TOUCH BLADE AND ZERO");
+            center(l3, "THEN CLICK");
         }
         else if (_calibStep == 1)
         {
             // Step 2: Cut a piece - no real-time display needed
-            l0 = header("\x04 STEP 2: CUT");
-            l1 = center("CUT A PIECE");
-            l2 = center("~50 CM OR MORE");
-            l3 = center("CLICK WHEN DONE");
+            header(l0, "\x04 STEP 2: CUT");
+            center(l1, "CUT A PIECE");
+            center(l2, "~50 CM OR MORE");
+            center(l3, "CLICK WHEN DONE");
         }
         else if (_calibStep == 2)
         {
             // Step 3: Enter the actual measured length - show in CM
-            l0 = header("\x04 STEP 3: MEASURE");
-            l1 = "\x7E REAL CUT: " + String(_calibRealLen / 10.0, 1) + " CM";
-            l2 = center("TURN TO ADJUST");
-            l3 = center("CLICK TO CONFIRM");
+            header(l0, "\x04 STEP 3: MEASURE");
+            l1.add("\x7E REAL CUT: ").addFloat(_calibRealLen / 10.0, 1).add(" CM");
+            center(l2, "TURN TO ADJUST");
+            center(l3, "CLICK TO CONFIRM");
         }
         else
         {
             // Step 4: Show calculated wheel diameter - 1 space before icon
             float mmPerPulse = abs(_calibRealLen) / (float)abs(_calibPulses);
             float newDia = (mmPerPulse * PULSES_PER_REV) / PI;
-            l0 = header("\x04 STEP 4: SAVE");
-            l1 = " \x04 NEW WHEEL DIA:";
-            l2 = " \x04 " + String(newDia, 3) + " MM";
-            l3 = center("CLICK TO SAVE");
+            header(l0, "\x04 STEP 4: SAVE");
+            l1.add(" \x04 NEW WHEEL DIA:");
+            l2.add(" \x04 ").addFloat(newDia, 3).add(" MM");
+            center(l3, "CLICK TO SAVE");
         }
-        display->showMenu4(l0, l1, l2, l3);
+        display->showMenu4(l0.c_str(), l1.c_str(), l2.c_str(), l3.c_str());
         return;
     }
 
-    // START NEW ANGLE WIZARD RENDERING
-    if (_state == MENU_CALIB_ANGLE_0)
+    if (_state == MENU_MULTI_CALIB)
     {
-        display->showMenu4(
-            header("\x07 ANGLE WIZARD"),
-            center("STEP 1: ZERO"),
-            center("SET TO 0 DEGREES"),
-            center("CLICK TO CAPTURE"));
+        LineBuf title;
+        if (_calibStep == 0)
+        {
+            title.add("\x03 MULTI-PT ").addUInt(_multiCount + 1).add('/').addUInt(CALIB_MAX_POINTS);
+            header(l0, title.c_str());
+            center(l1, "TOUCH BLADE AND ZERO");
+            center(l2, "THEN CLICK");
+            center(l3, "(SHORT TO LONG CUTS)");
+        }
+        else if (_calibStep == 1)
+        {
+            title.add("\x03 MULTI-PT ").addUInt(_multiCount + 1).add('/').addUInt(CALIB_MAX_POINTS);
+            header(l0, title.c_str());
+            center(l1, "CUT A PIECE");
+            center(l2, "LONGER THAN LAST");
+            center(l3, "CLICK WHEN DONE");
+        }
+        else if (_calibStep == 2)
+        {
+            title.add("\x03 MEASURE ").addUInt(_multiCount + 1).add('/').addUInt(CALIB_MAX_POINTS);
+            header(l0, title.c_str());
+            l1.add("\x7E REAL CUT: ").addFloat(_calibRealLen / 10.0, 1).add(" CM");
+            center(l2, "TURN TO ADJUST");
+            center(l3, "CLICK TO CONFIRM");
+        }
+        else
+        {
+            title.add("\x03 ").addUInt(_multiCount).add(" POINTS SET");
+            header(l0, title.c_str());
+            if (_multiCount < CALIB_MAX_POINTS)
+                l1.add(_multiSaveSelected ? "  " : "> ").add("NEXT POINT");
+            l2.add(_multiSaveSelected ? "> " : "  ").add("SAVE TABLE");
+            center(l3, "CLICK TO CONFIRM");
+        }
+        display->showMenu4(l0.c_str(), l1.c_str(), l2.c_str(), l3.c_str());
         return;
     }
-    else if (_state == MENU_CALIB_ANGLE_45)
+
+    // START NEW ANGLE WIZARD RENDERING
+    if (_state == MENU_CALIB_ANGLE)
     {
-        display->showMenu4(
-            header("\x07 ANGLE WIZARD"),
-            center("STEP 2: 45 DEG"),
-            center("SET TO 45 DEGREES"),
-            center("CLICK TO SAVE"));
+        LineBuf title;
+        if (_calibStep == 0)
+        {
+            uint16_t deg = _angleCount * ANGLE_CALIB_STEP_DEG;
+            title.add("\x07 ANGLE PT ").addUInt(_angleCount + 1).add('/').addUInt(ANGLE_CALIB_POINTS);
+            header(l0, title.c_str());
+            LineBuf step;
+            step.add("STEP ").addUInt(_angleCount + 1).add(": ").addUInt(deg).add(" DEG");
+            center(l1, step.c_str());
+            LineBuf target;
+            target.add("SET TO ").addUInt(deg).add(" DEGREES");
+            center(l2, target.c_str());
+            center(l3, "CLICK TO CAPTURE");
+        }
+        else if (_calibStep == 1)
+        {
+            title.add("\x07 ").addUInt(_angleCount).add(" POINTS SET");
+            header(l0, title.c_str());
+            if (_angleCount < ANGLE_CALIB_POINTS)
+                l1.add(_angleSaveSelected ? "  " : "> ").add("NEXT POINT");
+            l2.add(_angleSaveSelected ? "> " : "  ").add("SAVE TABLE");
+            center(l3, "CLICK TO CONFIRM");
+        }
+        else
+        {
+            header(l0, "\x07 ANGLE WIZARD");
+            center(l1, "POINTS OUT OF ORDER");
+            center(l2, "CHECK MAGNET/SAW");
+            center(l3, "CLICK TO RESTART");
+        }
+        display->showMenu4(l0.c_str(), l1.c_str(), l2.c_str(), l3.c_str());
         return;
     }
     // END NEW ANGLE WIZARD RENDERING
 
     if (_state == MENU_STOCK_SELECT)
     {
-        String l0, l1, l2, l3;
         if (_stockPage == 0)
         {
             const char *types[] = {"RECTANGULAR", "ANGLE IRON", "CYLINDRICAL"};
             const char icons[] = {1, 2, 3};
-            l0 = header("STOCK TYPE");
-            auto fmt = [&](int i) -> String
+            header(l0, "STOCK TYPE");
+            auto fmt = [&](LineBuf &s, int i)
             {
-                String s = (i == _settings->stockType) ? "> " : "  ";
-                s += String(icons[i]) + " " + String(types[i]);
-                return s;
+                s.add((i == _settings->stockType) ? "> " : "  ");
+                s.add(icons[i]).add(' ').add(types[i]);
             };
-            l1 = fmt(0);
-            l2 = fmt(1);
-            l3 = fmt(2);
+            fmt(l1, 0);
+            fmt(l2, 1);
+            fmt(l3, 2);
         }
         else if (_stockPage == 1)
         {
-            l0 = header("STOCK SIZE");
+            header(l0, "STOCK SIZE");
             int count = 0;
             if (_settings->isInch)
             {
@@ -915,31 +1117,26 @@ void MenuSys::render(DisplaySys *display)
                 else
                     count = STOCK_CYL_MM_COUNT;
             }
-            auto getStr = [&](int idx) -> String
+            auto getStr = [&](int idx) -> const char *
             {
-                if (idx < 0 || idx >= count)
-                    return "";
-                String s = "";
                 if (_settings->isInch)
                 {
                     if (_settings->stockType == 0)
-                        s = STOCK_RECT_IN[idx];
+                        return STOCK_RECT_IN[idx];
                     else if (_settings->stockType == 1)
-                        s = STOCK_ANGLE_IN[idx];
+                        return STOCK_ANGLE_IN[idx];
                     else
-                        s = STOCK_CYL_IN[idx];
+                        return STOCK_CYL_IN[idx];
                 }
                 else
                 {
                     if (_settings->stockType == 0)
-                        s = STOCK_RECT_MM[idx];
+                        return STOCK_RECT_MM[idx];
                     else if (_settings->stockType == 1)
-                        s = STOCK_ANGLE_MM[idx];
+                        return STOCK_ANGLE_MM[idx];
                     else
-                        s = STOCK_CYL_MM[idx];
+                        return STOCK_CYL_MM[idx];
                 }
-                char icon = (_settings->stockType == 0) ? 1 : (_settings->stockType == 1 ? 2 : 3);
-                return String(icon) + " " + s;
             };
             int current = _settings->stockIdx;
             int startIdx = current - 1;
@@ -949,261 +1146,252 @@ void MenuSys::render(DisplaySys *display)
                 startIdx = count - 3;
             if (startIdx < 0)
                 startIdx = 0;
-            auto fmtLine = [&](int row) -> String
+            char icon = (_settings->stockType == 0) ? 1 : (_settings->stockType == 1 ? 2 : 3);
+            auto fmtLine = [&](LineBuf &s, int row)
             {
                 int idx = startIdx + row;
                 if (idx >= count)
-                    return "";
-                String s = (idx == current) ? "> " : "  ";
-                s += getStr(idx);
-                return s;
+                    return;
+                s.add((idx == current) ? "> " : "  ");
+                s.add(icon).add(' ').add(getStr(idx));
             };
-            l1 = fmtLine(0);
-            l2 = fmtLine(1);
-            l3 = fmtLine(2);
+            fmtLine(l1, 0);
+            fmtLine(l2, 1);
+            fmtLine(l3, 2);
         }
         else
         {
-            l0 = header("FACE SELECT");
-            l3 = center("TURN TO TOGGLE");
+            header(l0, "FACE SELECT");
+            center(l3, "TURN TO TOGGLE");
         }
-        display->showMenu4(l0, l1, l2, l3);
+        display->showMenu4(l0.c_str(), l1.c_str(), l2.c_str(), l3.c_str());
         return;
     }
 
-    String l0, l1, l2, l3;
     int currentItem = 0;
     int scrollOffset = 0;
     int itemCount = 0;
 
     if (_state == MENU_NAVIGATE || (_state == MENU_EDIT && _currentItem == ITEM_CUT_MODE))
     {
-        l0 = header("MAIN MENU");
+        header(l0, "MAIN MENU");
         currentItem = _currentItem;
         scrollOffset = _scrollOffset;
         itemCount = ITEM_COUNT;
     }
     else if (_state == MENU_STATS_SELECT || (_state == MENU_EDIT && _statsSubItem == 2))
     {
-        l0 = header("STATISTICS");
+        header(l0, "STATISTICS");
         currentItem = _statsSubItem;
         scrollOffset = _statsScrollOffset;
         itemCount = 4;
     }
     else if (_state == MENU_STATS_PROJECT)
     {
-        l0 = header("PROJECT STATS");
+        header(l0, "PROJECT STATS");
         currentItem = _statsPage;
         scrollOffset = _statsScrollOffset;
         itemCount = 7;
     }
     else if (_state == MENU_STATS_GLOBAL)
     {
-        l0 = header("GLOBAL STATS");
+        header(l0, "GLOBAL STATS");
         currentItem = _statsPage;
         scrollOffset = _statsScrollOffset;
         itemCount = 5;
     }
     else if (_state == MENU_CALIBRATION_SUBMENU || (_state == MENU_EDIT && _calibSubItem >= 0 && _settingsSubItem < 0))
     {
-        l0 = header("CALIBRATION");
+        header(l0, "CALIBRATION");
         currentItem = _calibSubItem;
         scrollOffset = _calibScrollOffset;
-        itemCount = 5;
+        itemCount = 6;
     }
     else if (_state == MENU_SETTINGS_SUBMENU || (_state == MENU_EDIT && _settingsSubItem >= 0 && _calibSubItem < 0))
     {
-        l0 = header("SETTINGS");
+        header(l0, "SETTINGS");
         currentItem = _settingsSubItem;
         scrollOffset = _settingsScrollOffset;
-        itemCount = 6;
+        itemCount = 7;
     }
 
-    auto renderItem = [&](int idx) -> String
+    auto renderItem = [&](LineBuf &s, int idx)
     {
         if (idx >= itemCount)
-            return "";
+            return;
         bool selected = (idx == currentItem);
-        String s = selected ? "> " : "  ";
+        bool editing = (_state == MENU_EDIT && selected);
+        // Value being edited: "> ~ " replaces the cursor and the icon shifts right
+        s.add(editing ? "> \x7E " : (selected ? "> " : "  "));
 
         if (_state == MENU_NAVIGATE || (_state == MENU_EDIT && _currentItem == ITEM_CUT_MODE))
         {
-            const char *items[] = {"STOCK PROFILE", "CUT ANGLE", "STATISTICS", "CALIBRATION", "SETTINGS", "EXIT MENU"};
-            // Use dynamic icon for stock based on current selection: 1=Rect, 2=Angle, 3=Cyl
-            char stockIcon = (_settings->stockType == 0) ? 1 : (_settings->stockType == 1 ? 2 : 3);
-            // Icons: Stock(Dynamic), Angle(7), Stats(8->0), Calib(3-Diameter), Settings(5-Crosshair), Exit(Space)
-            // Updated: Stats(8) maps to custom char 0 via printStr helper
-            const char icons[] = {stockIcon, 7, 8, 3, 5, 32};
-
-            s += String(icons[idx]) + " " + items[idx];
-
             if (idx == ITEM_CUT_MODE)
             {
-                bool editing = (_state == MENU_EDIT && selected);
                 uint8_t mode = editing ? _tempCutMode : _settings->cutMode;
-                s = selected ? "> " : "  ";
+                s.clear();
+                s.add(selected ? "> " : "  ");
                 // Use Angle Symbol (7)
 
                 if (_settings->useAngleSensor)
                 {
                     // Auto Mode: Show simple text
-                    s += "\x07 ANGLE IS AUTO";
+                    s.add("\x07 ANGLE IS AUTO");
                 }
                 else
                 {
                     // Manual Mode: Normal display
-                    s += "\x07 CUT ANGLE: ";
+                    s.add("\x07 CUT ANGLE: ");
                     if (editing)
-                        s += "\x7E";
-                    s += String(mode) + "\xDF";
+                        s.add('\x7E');
+                    s.addUInt(mode).add('\xDF');
                 }
+                return;
             }
+
+            const char *items[] = {"STOCK PROFILE", "CUT ANGLE", "STATISTICS", "CALIBRATION", "SETTINGS", "EXIT MENU"};
+            // Use dynamic icon for stock based on current selection: 1=Rect, 2=Angle, 3=Cyl
+            char stockIcon = (_settings->stockType == 0) ? 1 : (_settings->stockType == 1 ? 2 : 3);
+            // Icons: Stock(Dynamic), Angle(7), Stats(8->0), Calib(3-Diameter), Settings(5-Crosshair), Exit(Space)
+            // Updated: Stats(8) maps to custom char 0 via printLine
+            const char icons[] = {stockIcon, 7, 8, 3, 5, 32};
+
+            s.add(icons[idx]).add(' ').add(items[idx]);
         }
         else if (_state == MENU_STATS_SELECT || (_state == MENU_EDIT && _statsSubItem == 2))
         {
-            bool editing = (_state == MENU_EDIT && selected);
             if (idx == 0)
-                s += "\x08 PROJECT STATS"; // Stats icon via \x08 (maps to char 0)
+                s.add("\x08 PROJECT STATS"); // Stats icon via \x08 (maps to char 0)
             else if (idx == 1)
-                s += "\x08 GLOBAL STATS"; // Stats icon via \x08
+                s.add("\x08 GLOBAL STATS"); // Stats icon via \x08
             else if (idx == 2)
             {
-                s += "\x08 RATE: $"; // Stats icon + Dollar
+                s.add("\x08 RATE: $"); // Stats icon + Dollar
                 if (editing)
-                    s = "> \x7E \x08 RATE: $" + String(_tempRate, 2);
+                    s.addFloat(_tempRate, 2);
                 else
-                    s += String(_settings->hourlyRate, 2) + "/HR";
+                    s.addFloat(_settings->hourlyRate, 2).add("/HR");
             }
             else if (idx == 3)
-                s += "  BACK";
+                s.add("  BACK");
         }
         else if (_state == MENU_STATS_PROJECT)
         {
             if (idx == 0)
-                s += "\x04 CUTS: " + String(_stats->getProjectCuts()); // Blade icon (Index 4)
+                s.add("\x04 CUTS: ").addUInt(_stats->getProjectCuts()); // Blade icon (Index 4)
             else if (idx == 1)
-                s += "\x04 LEN: " + String(_stats->getProjectLengthMeters(), 1) + " M"; // Blade icon
+                s.add("\x04 LEN: ").addFloat(_stats->getProjectLengthMeters(), 1).add(" M"); // Blade icon
             else if (idx == 2)
-                s += "\x01 WASTE: " + String(_stats->getProjectWasteMeters(), 2) + " M"; // Rect icon (Material)
+                s.add("\x01 WASTE: ").addFloat(_stats->getProjectWasteMeters(), 2).add(" M"); // Rect icon (Material)
             else if (idx == 3)
             {
                 unsigned long mins = _stats->getUptimeMinutes();
-                s += "\x08 TIME: " + String(mins / 60) + "H " + String(mins % 60) + "M"; // Stats icon
+                s.add("\x08 TIME: ").addUInt(mins / 60).add("H ").addUInt(mins % 60).add('M'); // Stats icon
             }
             else if (idx == 4)
-                s += "$ COST: $" + String(_stats->getLaborCost(), 2); // Dollar
+                s.add("$ COST: $").addFloat(_stats->getLaborCost(), 2); // Dollar
             else if (idx == 5)
-                s += "\x08 [ RESET PROJECT ]"; // Stats icon
+                s.add("\x08 [ RESET PROJECT ]"); // Stats icon
             else if (idx == 6)
-                s += "  BACK";
+                s.add("  BACK");
         }
         else if (_state == MENU_STATS_GLOBAL)
         {
             if (idx == 0)
-                s += "\x04 TOT CUTS: " + String(_stats->getTotalCuts()); // Blade icon
+                s.add("\x04 TOT CUTS: ").addUInt(_stats->getTotalCuts()); // Blade icon
             else if (idx == 1)
-                s += "\x04 TOT LEN: " + String(_stats->getTotalLengthMeters(), 1) + " M"; // Blade icon
+                s.add("\x04 TOT LEN: ").addFloat(_stats->getTotalLengthMeters(), 1).add(" M"); // Blade icon
             else if (idx == 2)
-                s += "\x01 TOT WASTE: " + String(_stats->getTotalWasteMeters(), 1) + " M"; // Rect icon
+                s.add("\x01 TOT WASTE: ").addFloat(_stats->getTotalWasteMeters(), 1).add(" M"); // Rect icon
             else if (idx == 3)
-                s += "\x08 TOT TIME: " + String((int)_stats->getTotalHours()) + " H"; // Stats icon
+                s.add("\x08 TOT TIME: ").addInt((int)_stats->getTotalHours()).add(" H"); // Stats icon
             else if (idx == 4)
-                s += "  BACK";
+                s.add("  BACK");
         }
         else if (_state == MENU_CALIBRATION_SUBMENU || (_state == MENU_EDIT && _calibSubItem >= 0 && _settingsSubItem < 0))
         {
-            // Calibration submenu rendering (5 items)
-            bool editing = (_state == MENU_EDIT && selected);
-
+            // Calibration submenu rendering (6 items)
             if (idx == 0)
             {
                 // Wheel Wizard - use Phi icon (3)
-                s += "\x03 WHEEL WIZARD";
+                s.add("\x03 WHEEL WIZARD");
             }
             else if (idx == 1)
             {
                 // Angle Wizard - use Angle icon (7)
-                s += "\x07 ANGLE WIZARD";
+                s.add("\x07 ANGLE WIZARD");
             }
             else if (idx == 2)
             {
                 // Wheel Diameter (manual) - use Phi icon (3)
                 if (editing)
-                {
-                    s = "> \x7E \x03 WHEEL: " + String(_tempDia, 1);
-                }
+                    s.add("\x03 WHEEL: ").addFloat(_tempDia, 1);
                 else
-                {
-                    s += "\x03 WHEEL: " + String(_settings->wheelDiameter, 1) + " MM";
-                }
+                    s.add("\x03 WHEEL: ").addFloat(_settings->wheelDiameter, 1).add(" MM");
             }
             else if (idx == 3)
             {
                 // Kerf - use Blade icon (4)
                 if (editing)
-                {
-                    s = "> \x7E \x04 KERF: " + String(_tempKerf, 1);
-                }
+                    s.add("\x04 KERF: ").addFloat(_tempKerf, 1);
                 else
-                {
-                    s += "\x04 KERF: " + String(_settings->kerfMM, 1) + " MM";
-                }
+                    s.add("\x04 KERF: ").addFloat(_settings->kerfMM, 1).add(" MM");
             }
             else if (idx == 4)
+            {
+                // Multi-Point Wizard - use Phi icon (3)
+                s.add("\x03 MULTI-PT: ").addUInt(_settings->calibPointCount).add(" PTS");
+            }
+            else if (idx == 5)
             {
                 // Back
-                s += "  BACK";
+                s.add("  BACK");
             }
         }
         else if (_state == MENU_SETTINGS_SUBMENU || (_state == MENU_EDIT && _settingsSubItem >= 0 && _calibSubItem < 0))
         {
-            // Settings submenu rendering (6 items)
-            bool editing = (_state == MENU_EDIT && selected);
-
+            // Settings submenu rendering (7 items)
             if (idx == 0)
             {
                 // Units - use Stats icon (8->0) for units
-                s += "\x08 UNITS : " + String(_settings->isInch ? "IMPERIAL" : "METRIC");
+                s.add("\x08 UNITS : ").add(_settings->isInch ? "IMPERIAL" : "METRIC");
             }
             else if (idx == 1)
             {
                 // Angle Source - use Angle icon (7)
-                s += "\x07 ANGLE SRC: " + String(_settings->useAngleSensor ? "AUTO" : "MAN");
+                s.add("\x07 ANGLE SRC: ").add(_settings->useAngleSensor ? "AUTO" : "MAN");
             }
             else if (idx == 2)
             {
                 // Auto-Zero toggle - use Blade icon (4)
-                s += "\x04 AUTO-ZERO: " + String(_settings->autoZeroEnabled ? "ON" : "OFF");
+                s.add("\x04 AUTO-ZERO: ").add(_settings->autoZeroEnabled ? "ON" : "OFF");
             }
             else if (idx == 3)
             {
                 // Auto-Zero Threshold - use Blade icon (4)
-                if (editing)
-                {
-                    s = "> \x7E \x04 AZ THRESH: " + String(_tempAZThresh, 1);
-                }
-                else
-                {
-                    s += "\x04 AZ THRESH: " + String(_settings->autoZeroThresholdMM, 1);
-                }
+                s.add("\x04 AZ THRESH: ").addFloat(editing ? _tempAZThresh : _settings->autoZeroThresholdMM, 1);
             }
             else if (idx == 4)
             {
-                // Direction - use Double Arrow icon (6)
-                s += "\x06 DIR : " + String(_settings->reverseDirection ? "REV" : "FWD");
+                // Auto-Zero Arm Delay (ms) - use Blade icon (4)
+                s.add("\x04 AZ ARM: ").addUInt(editing ? _tempAZArm : _settings->autoZeroArmMs).add("ms");
             }
             else if (idx == 5)
+            {
+                // Direction - use Double Arrow icon (6)
+                s.add("\x06 DIR : ").add(_settings->reverseDirection ? "REV" : "FWD");
+            }
+            else if (idx == 6)
             {
                 // Back
-                s += "  BACK";
+                s.add("  BACK");
             }
         }
-        return s;
     };
 
-    l1 = renderItem(scrollOffset);
-    l2 = renderItem(scrollOffset + 1);
-    l3 = renderItem(scrollOffset + 2);
+    renderItem(l1, scrollOffset);
+    renderItem(l2, scrollOffset + 1);
+    renderItem(l3, scrollOffset + 2);
 
-    display->showMenu4(l0, l1, l2, l3);
+    display->showMenu4(l0.c_str(), l1.c_str(), l2.c_str(), l3.c_str());
 }
@@ -0,0 +1,111 @@
+#include "headers/MotionEstimator.h"
+
+// counts / us -> counts/s Q8
+static int32_t rateQ8(int64_t counts, uint32_t dtUs) {
+    if (dtUs == 0) return 0;
+    int64_t v = (counts * 256000000LL) / (int64_t)dtUs;
+    if (v > INT32_MAX) return INT32_MAX;
+    if (v < -INT32_MAX) return -INT32_MAX;
+    return (int32_t)v;
+}
+
+// Acceleration smoothing: EMA weight 1/2^ACCEL_EMA_SHIFT per edge estimate
+#define ACCEL_EMA_SHIFT 2
+
+MotionEstimator::MotionEstimator() {
+    reset(0, 0, 0);
+}
+
+void MotionEstimator::reset(int64_t count, uint32_t nowUs, uint32_t edgeSeq) {
+    _refCount = count;
+    _refTimeUs = nowUs;
+    _refValid = false;
+    _edgeSeq = edgeSeq;
+    _lastCount = count;
+    _refSpacing = 4; // One full quadrature cycle per captured edge
+    _velocityQ8 = 0;
+    _accel = 0;
+    _edgeAccel = 0;
+    _edgeVelocityQ8 = 0;
+    _edgeMidUs = nowUs;
+    _edgeVelocityValid = false;
+}
+
+bool MotionEstimator::update(int64_t count, uint32_t nowUs, uint32_t sampleHz,
+                             uint32_t edgeSeq, int64_t edgeCount, uint32_t edgeTimeUs) {
+    int32_t velocityQ8 = _velocityQ8;
+    int64_t windowCount = count - _lastCount;
+    bool estimated = false;
+
+    if (edgeSeq != _edgeSeq) {
+        // New captured edge: exact (count, time) pair. M/T between reference points.
+        int64_t dCount = edgeCount - _refCount;
+        int32_t dT = (int32_t)(edgeTimeUs - _refTimeUs);
+
+        // First edge after reset, or after standing still: the interval
+        // includes the start of motion, so it only becomes the new reference
+        if (_refValid && dT > 0 && (uint32_t)dT < MOTION_STOP_US) {
+            velocityQ8 = rateQ8(dCount, (uint32_t)dT);
+            edgeVelocity(velocityQ8, _refTimeUs + (uint32_t)dT / 2);
+            estimated = true;
+        }
+        if (dCount != 0) {
+            _refSpacing = (int32_t)((dCount < 0) ? -dCount : dCount);
+        }
+
+        _refCount = edgeCount;
+        _refTimeUs = edgeTimeUs;
+        _refValid = true;
+        _edgeSeq = edgeSeq;
+    } else if (windowCount != 0 && (velocityQ8 == 0 || (windowCount > 0) != (velocityQ8 > 0))) {
+        // Counts moved with no edge pair to measure them (starting from rest,
+        // or a reversal inside one capture period): estimate from this sample
+        // window until the next edges. The reference stays where it is.
+        velocityQ8 = rateQ8(windowCount, 1000000UL / sampleHz);
+        _edgeVelocityValid = false;
+    } else {
+        // No new edge. The true speed can be at most "one more edge right
+        // now", so clamp and let it decay; hard zero after timeout. The next
+        // edge is at least one edge spacing away, and beyond wherever the
+        // counter has got to (the capture prescaler may have just changed).
+        uint32_t sinceEdge = nowUs - _refTimeUs;
+        if (sinceEdge >= MOTION_STOP_US && windowCount == 0) {
+            velocityQ8 = 0;
+        } else if (_refValid) {
+            int64_t moved = count - _refCount;
+            if (moved < 0) moved = -moved;
+            int64_t spacing = (moved + 1 > _refSpacing) ? moved + 1 : _refSpacing;
+            int32_t bound = rateQ8(spacing, sinceEdge);
+            if (velocityQ8 > bound) velocityQ8 = bound;
+            if (velocityQ8 < -bound) velocityQ8 = -bound;
+        }
+    }
+
+    if (velocityQ8 == 0) {
+        _accel = 0;
+        _edgeAccel = 0;
+        _edgeVelocityValid = false;
+    }
+    _lastCount = count;
+    _velocityQ8 = velocityQ8;
+    return estimated;
+}
+
+void MotionEstimator::edgeVelocity(int32_t velocityQ8, uint32_t midUs) {
+    if (_edgeVelocityValid) {
+        uint32_t dT = midUs - _edgeMidUs;
+        if (dT > 0) {
+            // (counts/s Q8) / us -> counts/s^2, smoothed
+            int64_t rawAccel = ((int64_t)(velocityQ8 - _edgeVelocityQ8) * 1000000LL / (int64_t)dT) >> 8;
+            if (rawAccel > INT32_MAX) rawAccel = INT32_MAX;
+            if (rawAccel < -INT32_MAX) rawAccel = -INT32_MAX;
+            _edgeAccel = (int32_t)rawAccel;
+            _accel = _accel + (int32_t)((rawAccel - _accel) / (1 << ACCEL_EMA_SHIFT));
+        }
+    } else {
+        _edgeAccel = 0;
+    }
+    _edgeVelocityQ8 = velocityQ8;
+    _edgeMidUs = midUs;
+    _edgeVelocityValid = true;
+}
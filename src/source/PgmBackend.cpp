@@ -0,0 +1,52 @@
+#include "headers/PgmBackend.h"
+
+// Host builds only: the board has no file system to dump into
+#ifndef ARDUINO
+#include <stdio.h>
+
+PgmBackend::PgmBackend() {
+    memset(_glass, 0, sizeof(_glass));
+}
+
+void PgmBackend::begin() {
+    clearScreen();
+}
+
+void PgmBackend::clearScreen() {
+    _fb.clear();
+    while (!isIdle()) {
+        pump();
+    }
+}
+
+void PgmBackend::beginFrame(LcdFrame *frame) {
+    _fb.draw(frame);
+}
+
+void PgmBackend::pump() {
+    uint16_t budget = OLED_SLICE_BYTES;
+    for (uint8_t p = 0; p < OLED_PAGES && budget > 0; p++) {
+        uint8_t x0;
+        uint16_t n = _fb.takeWindow(p, budget, &x0);
+        if (n == 0) continue; // Clean page, x0 not set
+        memcpy(&_glass[p][x0], _fb.page(p) + x0, n);
+        budget -= n;
+    }
+}
+
+bool PgmBackend::writePgm(const char *path) const {
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+
+    fprintf(f, "P5\n%d %d\n255\n", OLED_WIDTH, OLED_PAGES * 8);
+    for (uint8_t y = 0; y < OLED_PAGES * 8; y++) {
+        uint8_t line[OLED_WIDTH];
+        for (uint8_t x = 0; x < OLED_WIDTH; x++) {
+            line[x] = getPixel(x, y);
+        }
+        fwrite(line, 1, sizeof(line), f);
+    }
+    return fclose(f) == 0;
+}
+
+#endif // ARDUINO
@@ -0,0 +1,256 @@
+#include "headers/SettingsLog.h"
+#include "headers/InternalFlash.h"
+
+#define SECTOR_MAGIC 0x4C4B5449UL // "ITKL"
+#define RECORD_MAGIC 0xA7
+#define ERASED 0xFFFFFFFFUL
+#define SECTOR_HEADER_BYTES 8
+
+static uint32_t flashWord(uintptr_t addr) {
+    return *(const volatile uint32_t *)addr;
+}
+
+// CRC-32 (IEEE, reflected), bitwise: a record is ~130 bytes, once per save
+static uint32_t crc32(const uint8_t *p, uint32_t n) {
+    uint32_t crc = 0xFFFFFFFFUL;
+    while (n--) {
+        crc ^= *p++;
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+// ============================================================================
+// LOG
+// ============================================================================
+SettingsLog::SettingsLog() {
+    _len = 0;
+    _version = 0;
+    _ready = false;
+    _active = 0;
+    _generation = 0;
+    _writeOffset = STORAGE_SECTOR_SIZE;
+    _spareBlank = false;
+    _spareNeeded = false;
+    _eraseFailed = false;
+    _sequence = 0;
+    _pending = false;
+    _phase = LOG_IDLE;
+    _wordCount = 0;
+    _wordNext = 0;
+    _compacting = false;
+    _compactEnd = 0;
+    _errors = 0;
+    _compactions = 0;
+}
+
+uintptr_t SettingsLog::sectorAddr(uint8_t which) const {
+    return flashSectorBase(sectorNumber(which));
+}
+
+uint8_t SettingsLog::sectorNumber(uint8_t which) const {
+    return which ? STORAGE_SECTOR_B : STORAGE_SECTOR_A;
+}
+
+bool SettingsLog::sectorHeader(uint8_t which, uint32_t *generation) const {
+    uintptr_t base = sectorAddr(which);
+    if (flashWord(base) != SECTOR_MAGIC) return false;
+    *generation = flashWord(base + 4);
+    return true;
+}
+
+bool SettingsLog::isBlank(uint8_t which) const {
+    uintptr_t base = sectorAddr(which);
+    for (uint32_t off = 0; off < STORAGE_SECTOR_SIZE; off += 4) {
+        if (flashWord(base + off) != ERASED) return false;
+    }
+    return true;
+}
+
+// Walks a sector's records. Returns the offset of the first free byte
+// (STORAGE_SECTOR_SIZE if the tail can't be trusted) and updates the best
+// matching record if one here is newer.
+uint32_t SettingsLog::scan(uint8_t which, uint32_t *bestSeq, uintptr_t *bestAddr) const {
+    uintptr_t base = sectorAddr(which);
+    uint32_t off = SECTOR_HEADER_BYTES;
+
+    while (off + 12 <= STORAGE_SECTOR_SIZE) {
+        uint32_t head = flashWord(base + off);
+        if (head == ERASED) return off;
+
+        uint16_t len = head & 0xFFFF;
+        if ((head >> 24) != RECORD_MAGIC || len > STORAGE_MAX_PAYLOAD) {
+            return STORAGE_SECTOR_SIZE; // Torn header: no telling where the next record starts
+        }
+        uint32_t span = 12 + ((len + 3) & ~3UL);
+        if (off + span > STORAGE_SECTOR_SIZE) return STORAGE_SECTOR_SIZE;
+
+        uint32_t seq = flashWord(base + off + 4);
+        bool intact = flashWord(base + off + span - 4) == crc32((const uint8_t *)(base + off), span - 4);
+        bool ours = ((head >> 16) & 0xFF) == _version && len == _len;
+        if (intact && ours && (*bestAddr == 0 || (int32_t)(seq - *bestSeq) > 0)) {
+            *bestSeq = seq;
+            *bestAddr = base + off;
+        }
+        off += span;
+    }
+    return STORAGE_SECTOR_SIZE;
+}
+
+bool SettingsLog::begin(void *data, uint16_t len, uint8_t version) {
+    if (len > STORAGE_MAX_PAYLOAD || !sectorAddr(0) || !sectorAddr(1)) return false;
+    _len = len;
+    _version = version;
+
+    uint32_t gen[2];
+    bool valid[2] = { sectorHeader(0, &gen[0]), sectorHeader(1, &gen[1]) };
+
+    if (!valid[0] && !valid[1]) {
+        // First boot, or neither sector finished: start over in sector A
+        uintptr_t base = sectorAddr(0);
+        if ((!isBlank(0) && !flashErase(sectorNumber(0))) ||
+            !flashProgram(base + 4, 1) || !flashProgram(base, SECTOR_MAGIC)) {
+            _errors++;
+            return false;
+        }
+        _active = 0;
+        _generation = 1;
+        _writeOffset = SECTOR_HEADER_BYTES;
+        _spareBlank = isBlank(1) || flashErase(sectorNumber(1));
+        _ready = true;
+        return false;
+    }
+
+    _active = (valid[0] && (!valid[1] || (int32_t)(gen[0] - gen[1]) > 0)) ? 0 : 1;
+    _generation = gen[_active];
+    uint8_t spare = 1 - _active;
+
+    // Newest record: normally in the active sector, but look at both
+    uint32_t bestSeq = 0;
+    uintptr_t bestAddr = 0;
+    _writeOffset = scan(_active, &bestSeq, &bestAddr);
+    bool activeHasBest = bestAddr != 0;
+    if (valid[spare]) {
+        scan(spare, &bestSeq, &bestAddr);
+        activeHasBest = activeHasBest && bestAddr >= sectorAddr(_active) &&
+                        bestAddr < sectorAddr(_active) + STORAGE_SECTOR_SIZE;
+    }
+
+    // Clear the spare now, while a stalled CPU costs nothing. Keep it if it
+    // still holds the only good copy.
+    _spareBlank = isBlank(spare);
+    _spareNeeded = !_spareBlank && !activeHasBest && bestAddr != 0;
+    if (!_spareBlank && !_spareNeeded) {
+        _spareBlank = flashErase(sectorNumber(spare));
+        if (!_spareBlank) _errors++;
+    }
+    _ready = true;
+
+    if (bestAddr == 0) return false;
+    _sequence = bestSeq;
+    memcpy(data, (const void *)(bestAddr + 8), len);
+    return true;
+}
+
+void SettingsLog::save(const void *data) {
+    if (!_ready) return;
+    memcpy(_latest, data, _len);
+    _pending = true;
+}
+
+void SettingsLog::startRecord() {
+    uint8_t spare = 1 - _active;
+    uintptr_t addr;
+
+    _compacting = _writeOffset + recordBytes() > STORAGE_SECTOR_SIZE;
+    addr = _compacting ? sectorAddr(spare) + SECTOR_HEADER_BYTES : sectorAddr(_active) + _writeOffset;
+
+    // Build the record in RAM: header, sequence, payload (0xFF padded), CRC
+    uint8_t payloadWords = (_len + 3) / 4;
+    _sequence++;
+    _words[0] = ((uint32_t)RECORD_MAGIC << 24) | ((uint32_t)_version << 16) | _len;
+    _words[1] = _sequence;
+    _words[1 + payloadWords] = ERASED;
+    memcpy(&_words[2], _latest, _len);
+    _words[2 + payloadWords] = crc32((const uint8_t *)_words, (2 + payloadWords) * 4);
+    _wordCount = 3 + payloadWords;
+    for (uint8_t i = 0; i < _wordCount; i++) {
+        _addr[i] = addr + i * 4;
+    }
+
+    // New sector: its header goes last, magic word after the generation
+    if (_compacting) {
+        _words[_wordCount] = _generation + 1;
+        _addr[_wordCount++] = sectorAddr(spare) + 4;
+        _words[_wordCount] = SECTOR_MAGIC;
+        _addr[_wordCount++] = sectorAddr(spare);
+        _compactEnd = SECTOR_HEADER_BYTES + recordBytes();
+    }
+
+    _wordNext = 0;
+    _pending = false;
+    _phase = LOG_PROGRAM;
+}
+
+bool SettingsLog::isEraseDue() const {
+    if (!_ready || _spareBlank || _spareNeeded || _eraseFailed || _phase != LOG_IDLE) return false;
+    return _writeOffset + STORAGE_ERASE_AHEAD_BYTES >= STORAGE_SECTOR_SIZE;
+}
+
+bool SettingsLog::isStalled() const {
+    if (!_ready) return true;
+    return _pending && _phase == LOG_IDLE && _writeOffset + recordBytes() > STORAGE_SECTOR_SIZE && !_spareBlank;
+}
+
+void SettingsLog::eraseSpare() {
+    if (!_ready || _spareBlank || _spareNeeded || _eraseFailed || _phase != LOG_IDLE) return;
+
+    _spareBlank = flashErase(sectorNumber(1 - _active));
+    if (!_spareBlank) {
+        _errors++;
+        _eraseFailed = true; // Don't freeze every menu visit on a worn sector
+    }
+}
+
+void SettingsLog::update() {
+    if (!_ready) return;
+
+    if (_phase == LOG_IDLE) {
+        if (!_pending) return;
+        // Full, and the spare needs erasing first: waits for eraseSpare()
+        if (_writeOffset + recordBytes() > STORAGE_SECTOR_SIZE && !_spareBlank) return;
+        startRecord();
+    }
+
+    for (uint8_t i = 0; i < STORAGE_WORDS_PER_STEP && _wordNext < _wordCount; i++) {
+        if (!flashProgram(_addr[_wordNext], _words[_wordNext])) {
+            // The record is spoilt (its CRC won't match): retry the newest
+            // snapshot in a fresh sector
+            _errors++;
+            if (_compacting) {
+                _spareBlank = false;
+            } else {
+                _writeOffset = STORAGE_SECTOR_SIZE;
+            }
+            _pending = true;
+            _phase = LOG_IDLE;
+            return;
+        }
+        _wordNext++;
+    }
+    if (_wordNext < _wordCount) return;
+
+    _phase = LOG_IDLE;
+    _spareNeeded = false;
+    if (_compacting) {
+        _active = 1 - _active;
+        _generation++;
+        _writeOffset = _compactEnd;
+        _spareBlank = false; // The old sector, until it is erased
+        _compactions++;
+    } else {
+        _writeOffset += recordBytes();
+    }
+}
@@ -0,0 +1,97 @@
+#include "headers/Ssd1306Backend.h"
+#include <SPI.h>
+
+// Power-on sequence: 128x64, charge pump on, page addressing, flipped to
+// match the usual module orientation
+static const uint8_t INIT_CMDS[] = {
+    0xAE,       // Display off
+    0xD5, 0x80, // Clock divide
+    0xA8, 0x3F, // Multiplex 64
+    0xD3, 0x00, // No display offset
+    0x40,       // Start line 0
+    0x8D, 0x14, // Charge pump on (ignored by SH1106)
+    0x20, 0x02, // Page addressing mode
+    0xA1,       // Segment remap
+    0xC8,       // COM scan descending
+    0xDA, 0x12, // COM pins
+    0x81, 0xCF, // Contrast
+    0xD9, 0xF1, // Precharge
+    0xDB, 0x40, // VCOMH
+    0xA4,       // Show RAM
+    0xA6,       // Not inverted
+    0xAF,       // Display on
+};
+
+Ssd1306Backend::Ssd1306Backend() {}
+
+void Ssd1306Backend::begin() {
+    pinMode(PIN_OLED_CS, OUTPUT);
+    pinMode(PIN_OLED_DC, OUTPUT);
+    pinMode(PIN_OLED_RST, OUTPUT);
+    digitalWrite(PIN_OLED_CS, HIGH);
+
+    // Hardware reset (only at boot)
+    digitalWrite(PIN_OLED_RST, LOW);
+    delay(1);
+    digitalWrite(PIN_OLED_RST, HIGH);
+    delay(10);
+
+    SPI.begin();
+    sendCommands(INIT_CMDS, sizeof(INIT_CMDS));
+    clearScreen();
+}
+
+void Ssd1306Backend::clearScreen() {
+    _fb.clear();
+    while (!isIdle()) {
+        pump();
+    }
+}
+
+void Ssd1306Backend::beginFrame(LcdFrame *frame) {
+    _fb.draw(frame);
+}
+
+void Ssd1306Backend::pump() {
+    uint16_t budget = OLED_SLICE_BYTES;
+    for (uint8_t p = 0; p < OLED_PAGES && budget > 0; p++) {
+        budget -= sendWindow(p, budget);
+    }
+}
+
+void Ssd1306Backend::sendCommands(const uint8_t *cmds, uint8_t n) {
+    SPI.beginTransaction(SPISettings(OLED_SPI_HZ, MSBFIRST, SPI_MODE0));
+    digitalWrite(PIN_OLED_DC, LOW);
+    digitalWrite(PIN_OLED_CS, LOW);
+    for (uint8_t i = 0; i < n; i++) {
+        SPI.transfer(cmds[i]);
+    }
+    digitalWrite(PIN_OLED_CS, HIGH);
+    SPI.endTransaction();
+}
+
+// Sends the start of a page's dirty window, up to budget data bytes
+uint16_t Ssd1306Backend::sendWindow(uint8_t page, uint16_t budget) {
+    uint8_t x0;
+    uint16_t n = _fb.takeWindow(page, budget, &x0);
+    if (n == 0) return 0;
+
+    uint8_t ramCol = x0 + OLED_COL_OFFSET;
+    uint8_t cmds[3] = {
+        (uint8_t)(0xB0 | page),
+        (uint8_t)(0x00 | (ramCol & 0x0F)),
+        (uint8_t)(0x10 | (ramCol >> 4)),
+    };
+    sendCommands(cmds, sizeof(cmds));
+
+    const uint8_t *data = _fb.page(page) + x0;
+    SPI.beginTransaction(SPISettings(OLED_SPI_HZ, MSBFIRST, SPI_MODE0));
+    digitalWrite(PIN_OLED_DC, HIGH);
+    digitalWrite(PIN_OLED_CS, LOW);
+    for (uint16_t i = 0; i < n; i++) {
+        SPI.transfer(data[i]);
+    }
+    digitalWrite(PIN_OLED_CS, HIGH);
+    SPI.endTransaction();
+    return n;
+}
@@ -6,34 +6,48 @@ StatsSys::StatsSys() {
 
 void StatsSys::init(SystemSettings* settings) {
     _settings = settings;
-    _lastCutLen = 0.0;
+    _lastCutUM = 0;
+    _rejectedCuts = 0;
 }
 
-void StatsSys::registerCut(float lengthMM) {
+bool StatsSys::registerCut(PositionUM lengthUM, bool suspect) {
     // Smart Algorithm: Only count if length > Threshold
-    if (abs(lengthMM) > MIN_CUT_LENGTH_MM) {
-        float lenMeters = abs(lengthMM) / 1000.0;
-        float kerfMeters = _settings->kerfMM / 1000.0;  // Kerf compensation
-        
-        _lastCutLen = abs(lengthMM);
-        
-        // Update Project Stats (includes kerf waste)
-        _settings->projectCuts++;
-        _settings->projectLengthMeters += (lenMeters + kerfMeters);
-        
-        // Update Total Stats (Persistent, includes kerf waste)
-        _settings->totalCuts++;
-        _settings->totalLengthMeters += (lenMeters + kerfMeters);
-        
-        // Storage::save(*_settings); // Disabled - Will use AT24C256 EEPROM
+    PositionUM absLen = (lengthUM < 0) ? -lengthUM : lengthUM;
+    if (absLen <= MIN_CUT_LENGTH_UM) {
+        return false;
     }
+
+    // Glitch or slip during this measurement: length can't be trusted
+    if (suspect) {
+        _rejectedCuts++;
+        return false;
+    }
+
+    int64_t kerfUM = mmToUM(_settings->kerfMM);  // Kerf compensation
+
+    _lastCutUM = absLen;
+
+    // Update Project Stats (includes kerf waste)
+    _settings->projectCuts++;
+    _settings->projectLengthUM += (absLen + kerfUM);
+
+    // Update Total Stats (Persistent, includes kerf waste)
+    _settings->totalCuts++;
+    _settings->totalLengthUM += (absLen + kerfUM);
+
+    Storage::save(*_settings); // Snapshot only: written to flash in the background
+    return true;
+}
+
+unsigned long StatsSys::getRejectedCuts() {
+    return _rejectedCuts;
 }
 
 void StatsSys::resetProject() {
     _settings->projectCuts = 0;
-    _settings->projectLengthMeters = 0.0;
+    _settings->projectLengthUM = 0;
     _settings->projectSeconds = 0;
-    // Storage::save(*_settings); // Disabled - Will use AT24C256 EEPROM
+    Storage::save(*_settings);
 }
 
 void StatsSys::update() {
@@ -50,7 +64,7 @@ unsigned long StatsSys::getProjectCuts() {
 }
 
 float StatsSys::getProjectLengthMeters() {
-    return _settings->projectLengthMeters;
+    return _settings->projectLengthUM / 1000000.0;
 }
 
 unsigned long StatsSys::getTotalCuts() {
@@ -58,7 +72,7 @@ unsigned long StatsSys::getTotalCuts() {
 }
 
 float StatsSys::getTotalLengthMeters() {
-    return _settings->totalLengthMeters;
+    return _settings->totalLengthUM / 1000000.0;
 }
 
 float StatsSys::getProjectWasteMeters() {
@@ -72,12 +86,13 @@ float StatsSys::getTotalWasteMeters() {
 float StatsSys::getAverageCutLengthMM() {
     if (_settings->projectCuts == 0) return 0.0;
     // Project Length includes Kerf, so subtract it to get raw material average
-    float totalRawMeters = _settings->projectLengthMeters - getProjectWasteMeters();
-    return (totalRawMeters * 1000.0) / _settings->projectCuts;
+    int64_t wasteUM = (int64_t)_settings->projectCuts * mmToUM(_settings->kerfMM);
+    int64_t rawUM = _settings->projectLengthUM - wasteUM;
+    return (rawUM / (float)_settings->projectCuts) / UM_PER_MM;
 }
 
 float StatsSys::getLastCutLengthMM() {
-    return _lastCutLen;
+    return umToMM(_lastCutUM);
 }
 
 unsigned long StatsSys::getUptimeMinutes() {
@@ -0,0 +1,34 @@
+#include "headers/Storage.h"
+#include "headers/SettingsLog.h"
+
+static_assert(sizeof(SystemSettings) <= STORAGE_MAX_PAYLOAD, "SystemSettings outgrew a log record");
+
+static SettingsLog settingsLog;
+
+bool Storage::load(SystemSettings &settings) {
+    return settingsLog.begin(&settings, sizeof(SystemSettings), SETTINGS_LAYOUT_VERSION);
+}
+
+void Storage::save(const SystemSettings &settings) {
+    settingsLog.save(&settings);
+}
+
+void Storage::update() {
+    settingsLog.update();
+}
+
+void Storage::eraseSpare() {
+    settingsLog.eraseSpare();
+}
+
+bool Storage::isEraseDue() {
+    return settingsLog.isEraseDue();
+}
+
+bool Storage::isStalled() {
+    return settingsLog.isStalled();
+}
+
+bool Storage::isIdle() {
+    return settingsLog.isIdle();
+}
@@ -1,10 +1,26 @@
 #include "headers/UserInput.h"
 
+// Quadrature transition table, indexed by (last << 2) | now with state = (DT << 1) | CLK.
+// +1 / -1 for a valid single-bit step, 0 for no change or an impossible double step
+// (bounce that skipped a state nets out on its own).
+static const int8_t KNOB_TRANSITIONS[16] = {
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0
+};
+
+UserInput* UserInput::_isrInstance = nullptr;
+
 UserInput::UserInput() {
     _lastEncoded = 0;
-    _encoderValue = 0;
+    _knobSteps = 0;
+    _knobConsumed = 0;
+    _knobExti = false;
+    _lastDetentMs = 0;
+    _lastDetentEvent = EVENT_NONE;
     _btnState = 0xFFFF; // Assume high (pullup)
-    _pendingEvent = EVENT_NONE;
+    _overflows = 0;
     _longPressHandled = false;
     _superLongPressHandled = false;
 }
@@ -13,55 +29,127 @@ void UserInput::init() {
     pinMode(PIN_MENU_CLK, INPUT_PULLUP);
     pinMode(PIN_MENU_DT, INPUT_PULLUP);
     pinMode(PIN_MENU_SW, INPUT_PULLUP);
-    
+
+#if defined(STM32F4xx)
+    _knobPort = digitalPinToPort(PIN_MENU_CLK);
+    _clkMask = digitalPinToBitMask(PIN_MENU_CLK);
+    _dtMask = digitalPinToBitMask(PIN_MENU_DT);
+    _swMask = digitalPinToBitMask(PIN_MENU_SW);
+#endif
+
     // Read initial state
-    int MSB = digitalRead(PIN_MENU_DT);
-    int LSB = digitalRead(PIN_MENU_CLK);
-    _lastEncoded = (MSB << 1) | LSB;
+    _lastEncoded = readPins() & 0x03;
+
+#if defined(STM32F4xx) && MENU_KNOB_EXTI
+    // Every CLK/DT edge is decoded as it happens: no missed transitions on a
+    // fast spin, and no knob work in the tick while the knob is still
+    _isrInstance = this;
+    attachInterrupt(digitalPinToInterrupt(PIN_MENU_CLK), UserInput::knobISR, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(PIN_MENU_DT), UserInput::knobISR, CHANGE);
+    _knobExti = true;
+#endif
 }
 
 // This function is called at 1kHz by Timer1 ISR
 void UserInput::isrTick() {
+    uint8_t pins = readPins();
+    if (!_knobExti) {
+        decodeKnob(pins);
+    }
     handleEncoder();
-    handleButton();
+    handleButton((pins & 0x04) != 0);
+}
+
+void UserInput::knobISR() {
+    if (_isrInstance) {
+        _isrInstance->decodeKnob(_isrInstance->readPins());
+    }
+}
+
+uint8_t UserInput::readPins() {
+#if defined(STM32F4xx)
+    uint32_t idr = _knobPort->IDR;
+    return ((idr & _clkMask) ? 0x01 : 0) | ((idr & _dtMask) ? 0x02 : 0) | ((idr & _swMask) ? 0x04 : 0);
+#else
+    return (digitalRead(PIN_MENU_CLK) ? 0x01 : 0) | (digitalRead(PIN_MENU_DT) ? 0x02 : 0) | (digitalRead(PIN_MENU_SW) ? 0x04 : 0);
+#endif
+}
+
+// Runs in exactly one context (knob EXTI or the tick), so it owns _knobSteps
+void UserInput::decodeKnob(uint8_t pins) {
+    uint8_t encoded = pins & 0x03;
+    uint8_t last = _lastEncoded;
+    if (encoded == last) {
+        return;
+    }
+    int8_t step = KNOB_TRANSITIONS[(last << 2) | encoded];
+    if (step != 0) {
+        _knobSteps = (int16_t)(_knobSteps + step);
+    }
+    _lastEncoded = encoded;
 }
 
 InputEvent UserInput::getEvent() {
-    InputEvent e = _pendingEvent;
-    _pendingEvent = EVENT_NONE; // Clear event after reading
-    return e;
+    InputRecord record;
+    if (!pollEvent(&record)) {
+        return EVENT_NONE;
+    }
+    return record.event;
 }
 
-void UserInput::handleEncoder() {
-    int MSB = digitalRead(PIN_MENU_DT);
-    int LSB = digitalRead(PIN_MENU_CLK);
-    int encoded = (MSB << 1) | LSB;
-    int sum = (_lastEncoded << 2) | encoded;
+bool UserInput::pollEvent(InputRecord *record) {
+    return _queue.pop(record);
+}
+
+// ISR side only
+void UserInput::postEvent(InputEvent e, uint8_t steps) {
+    InputRecord record;
+    record.event = e;
+    record.timeMs = millis();
+    record.steps = steps;
+    if (!_queue.push(record)) {
+        _overflows = _overflows + 1;
+    }
+}
 
-    // State transition table for rotary encoder
-    // This handles the 4 steps of a quadrature encoder
-    if(sum == 0b1101 || sum == 0b0100 || sum == 0b0010 || sum == 0b1011) _encoderValue++;
-    if(sum == 0b1110 || sum == 0b0111 || sum == 0b0001 || sum == 0b1000) _encoderValue--;
+// Turns decoded steps into detent events (tick side)
+void UserInput::handleEncoder() {
+    // KY-040: 4 quarter steps per detent, one event per detent.
+    // Several detents between two ticks all get queued.
+    int16_t pending = (int16_t)(_knobSteps - _knobConsumed);
+    while (pending >= 4) {
+        postDetent(EVENT_CW);
+        _knobConsumed = (int16_t)(_knobConsumed + 4);
+        pending -= 4;
+    }
+    while (pending <= -4) {
+        postDetent(EVENT_CCW);
+        _knobConsumed = (int16_t)(_knobConsumed - 4);
+        pending += 4;
+    }
+}
 
-    _lastEncoded = encoded; // Store this value for next time
-    
-    // KY-040 often has 2 or 4 steps per detent. 
-    // We usually want 1 event per detent.
-    // Let's assume 4 steps per detent for standard encoders, or 2.
-    // Adjust divisor based on feel.
-    if (_encoderValue >= 4) {
-        _pendingEvent = EVENT_CW;
-        _encoderValue = 0;
-    } else if (_encoderValue <= -4) {
-        _pendingEvent = EVENT_CCW;
-        _encoderValue = 0;
+// Tags each detent with an acceleration multiplier from the gap to the previous
+// one. A reversal or a pause starts over at single steps.
+void UserInput::postDetent(InputEvent e) {
+    uint32_t now = millis();
+    uint32_t gap = now - _lastDetentMs;
+    uint8_t steps = 1;
+    if (e == _lastDetentEvent) {
+        if (gap < KNOB_ACCEL_FAST_MS) {
+            steps = KNOB_ACCEL_FAST_STEPS;
+        } else if (gap < KNOB_ACCEL_MED_MS) {
+            steps = KNOB_ACCEL_MED_STEPS;
+        }
     }
+    _lastDetentMs = now;
+    _lastDetentEvent = e;
+    postEvent(e, steps);
 }
 
-void UserInput::handleButton() {
+void UserInput::handleButton(bool pinVal) {
     // Shift register debounce
-    // Read pin (active low)
-    bool pinVal = digitalRead(PIN_MENU_SW);
+    // pinVal: raw pin level (active low)
     
     // Shift left and insert new value at bit 0
     _btnState = (_btnState << 1) | pinVal | 0xE000; // Keep top bits high to prevent false positives on overflow? No, just mask.
@@ -95,7 +183,7 @@ void UserInput::handleButton() {
         } else if (lastStableState == LOW && pinVal == HIGH) {
             // Rising Edge (Release)
             if (!_longPressHandled) {
-                _pendingEvent = EVENT_CLICK;
+                postEvent(EVENT_CLICK);
             }
         }
         lastStableState = pinVal;
@@ -107,11 +195,11 @@ void UserInput::handleButton() {
         unsigned long pressedDuration = millis() - _btnPressTime;
         
         if (!_superLongPressHandled && pressedDuration > 10000) {  // 10 seconds
-            _pendingEvent = EVENT_SUPER_LONG_PRESS;
+            postEvent(EVENT_SUPER_LONG_PRESS);
             _superLongPressHandled = true;
             _longPressHandled = true;  // Also mark long press as handled
         } else if (!_longPressHandled && pressedDuration > 500) {  // 500ms (was 1s)
-            _pendingEvent = EVENT_LONG_PRESS;
+            postEvent(EVENT_LONG_PRESS);
             _longPressHandled = true;
         }
     }
@@ -0,0 +1,75 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// ============================================================================
+// HOST STAND-IN FOR <Arduino.h> ([env:native] tests only)
+// ============================================================================
+// Just enough of the core for the HAL-free modules to compile on the PC.
+// Time is whatever the test says it is.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define OUTPUT_OPEN_DRAIN 3
+
+// Black Pill pin names, numbered for hostPinLevel[]
+enum {
+    PA0, PA1, PA2, PA3, PA4, PA5, PA6, PA7, PA8, PA9, PA10, PA11, PA12, PA13, PA14, PA15,
+    PB0, PB1, PB2, PB3, PB4, PB5, PB6, PB7, PB8, PB9, PB10, PB11, PB12, PB13, PB14, PB15,
+    PC13, PC14, PC15,
+    HOST_PIN_COUNT
+};
+
+using std::min;
+using std::max;
+
+inline uint32_t hostMillis = 0;
+inline uint32_t hostMicros = 0;
+
+inline unsigned long millis() { return hostMillis; }
+inline unsigned long micros() { return hostMicros; }
+
+// GPIO: inputs read whatever the test set, outputs are remembered.
+// hostPinHeldLow models another device pulling a line down (open drain);
+// hostPinChanged, if set, runs after every pinMode() / digitalWrite().
+inline uint8_t hostPinLevel[HOST_PIN_COUNT];
+inline uint8_t hostPinMode[HOST_PIN_COUNT];
+inline bool hostPinHeldLow[HOST_PIN_COUNT];
+inline void (*hostPinChanged)(uint32_t pin) = nullptr;
+
+inline void pinMode(uint32_t pin, uint32_t mode) {
+    hostPinMode[pin] = (uint8_t)mode;
+    if (mode == INPUT_PULLUP) hostPinLevel[pin] = HIGH;
+    if (hostPinChanged) hostPinChanged(pin);
+}
+inline int digitalRead(uint32_t pin) { return hostPinHeldLow[pin] ? LOW : hostPinLevel[pin]; }
+inline void digitalWrite(uint32_t pin, uint32_t level) {
+    hostPinLevel[pin] = level ? HIGH : LOW;
+    if (hostPinChanged) hostPinChanged(pin);
+}
+
+// Busy waits just move the clock
+inline void delayMicroseconds(uint32_t us) {
+    hostMicros += us;
+    hostMillis += us / 1000;
+}
+inline void delay(unsigned long ms) { delayMicroseconds(ms * 1000); }
+
+// Suites covering the STM32 code paths define STM32F4xx before any include
+#if defined(STM32F4xx)
+#include "stm32f4xx_hal.h"
+#endif
+
+#endif // HOST_ARDUINO_H
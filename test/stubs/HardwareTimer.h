@@ -0,0 +1,88 @@
+#ifndef HOST_HARDWARETIMER_H
+#define HOST_HARDWARETIMER_H
+
+// ============================================================================
+// HOST STAND-IN FOR <HardwareTimer.h> ([env:native] tests only)
+// ============================================================================
+// The STM32 core's timer object on top of the fake registers. Like the core,
+// attaching a callback enables its interrupt. Nothing fires on its own:
+// hostIrq() is the timer's IRQ handler, called by the test when it wants the
+// interrupt to run (clears the pending flags it serves, then calls back).
+// hostTimerIrq() finds the object for a timer the firmware keeps private.
+
+#include <Arduino.h>
+
+#define HOST_TIMER_CLOCK_HZ 100000000 // F411 APB2 timers
+
+enum TimerFormat_t { TICK_FORMAT, MICROSEC_FORMAT, HERTZ_FORMAT };
+
+class HardwareTimer;
+inline HardwareTimer *hostTimers[4]; // Latest object per instance
+
+class HardwareTimer {
+public:
+    explicit HardwareTimer(TIM_TypeDef *instance) {
+        _handle.Instance = instance;
+        for (uint8_t i = 0; i < 5; i++) _callbacks[i] = nullptr;
+        hostTimers[hostSlot(instance)] = this;
+    }
+    ~HardwareTimer() {
+        if (hostTimers[hostSlot(_handle.Instance)] == this) hostTimers[hostSlot(_handle.Instance)] = nullptr;
+    }
+
+    static uint8_t hostSlot(TIM_TypeDef *tim) {
+        return (tim == TIM1) ? 0 : (tim == TIM2) ? 1 : (tim == TIM4) ? 2 : 3;
+    }
+
+    void pause() { _handle.Instance->CR1 &= ~1U; }
+    void resume() { _handle.Instance->CR1 |= 1U; }
+    void setInterruptPriority(uint32_t preempt, uint32_t sub) { priority = preempt; }
+    uint32_t priority = 15;
+
+    TIM_HandleTypeDef *getHandle() { return &_handle; }
+    void setCount(uint32_t count) { _handle.Instance->CNT = count; }
+
+    void setOverflow(uint32_t value, TimerFormat_t format) {
+        uint32_t ticks = value;
+        if (format == HERTZ_FORMAT) ticks = HOST_TIMER_CLOCK_HZ / value;
+        else if (format == MICROSEC_FORMAT) ticks = (uint32_t)((uint64_t)HOST_TIMER_CLOCK_HZ * value / 1000000);
+        // Same split as the core: smallest prescaler that fits 16 bits
+        uint32_t prescale = ticks / 0x10000 + 1;
+        _handle.Instance->PSC = prescale - 1;
+        _handle.Instance->ARR = ticks / prescale - 1;
+    }
+    uint32_t getPrescaleFactor() { return _handle.Instance->PSC.value + 1; }
+    uint32_t getOverflow(TimerFormat_t format) { return _handle.Instance->ARR.value + 1; } // TICK_FORMAT only
+    uint32_t getTimerClkFreq() { return HOST_TIMER_CLOCK_HZ; }
+
+    void attachInterrupt(void (*callback)()) {
+        _callbacks[0] = callback;
+        _handle.Instance->DIER |= TIM_DIER_UIE;
+    }
+    void attachInterrupt(uint32_t channel, void (*callback)()) {
+        _callbacks[channel] = callback;
+        _handle.Instance->DIER |= (1U << channel);
+    }
+
+    void hostIrq() {
+        TIM_TypeDef *tim = _handle.Instance;
+        for (uint8_t i = 0; i < 5; i++) {
+            uint32_t flag = 1U << i; // UIF, CC1IF..CC4IF (same bits in DIER)
+            if ((tim->SR.value & flag) && (tim->DIER.value & flag) && _callbacks[i]) {
+                tim->SR.value &= ~flag;
+                _callbacks[i]();
+            }
+        }
+    }
+
+private:
+    TIM_HandleTypeDef _handle;
+    void (*_callbacks[5])();
+};
+
+inline void hostTimerIrq(TIM_TypeDef *tim) {
+    HardwareTimer *timer = hostTimers[HardwareTimer::hostSlot(tim)];
+    if (timer) timer->hostIrq();
+}
+
+#endif // HOST_HARDWARETIMER_H
@@ -0,0 +1,47 @@
+#ifndef HOST_LIQUIDCRYSTAL_I2C_H
+#define HOST_LIQUIDCRYSTAL_I2C_H
+
+// ============================================================================
+// HOST STAND-IN FOR <LiquidCrystal_I2C.h> ([env:native] tests only)
+// ============================================================================
+// Only what Hd44780Backend uses. Like the library, every call turns into
+// PCF8574 writes (4-bit, backlight on), here through i2cBus so a model LCD
+// (test/support/FakeLcd.h) sees the same instructions the glass would.
+
+#include <Arduino.h>
+#include "headers/I2CBus.h"
+
+class LiquidCrystal_I2C {
+public:
+    LiquidCrystal_I2C(uint8_t addr, uint8_t cols, uint8_t rows) : _addr(addr) {}
+
+    // HD44780 "initialization by instruction", then 2-line, display on, clear
+    void begin() {
+        nibble(0x3);
+        nibble(0x3);
+        nibble(0x3);
+        nibble(0x2);
+        command(0x28);
+        command(0x0C);
+        clear();
+        command(0x06);
+    }
+
+    void backlight() {}
+    void clear() { command(0x01); }
+
+private:
+    uint8_t _addr;
+
+    void nibble(uint8_t n) {
+        uint8_t out[2] = { (uint8_t)((n << 4) | 0x08 | 0x04), (uint8_t)((n << 4) | 0x08) };
+        i2cBus.write(I2C_CLIENT_LCD, _addr, out, 2);
+    }
+
+    void command(uint8_t value) {
+        nibble(value >> 4);
+        nibble(value & 0x0F);
+    }
+};
+
+#endif // HOST_LIQUIDCRYSTAL_I2C_H
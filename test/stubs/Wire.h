@@ -0,0 +1,88 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+// ============================================================================
+// HOST STAND-IN FOR <Wire.h> ([env:native] tests only)
+// ============================================================================
+// A bus with at most one model slave on it (hostI2cSlave). Other addresses
+// NACK. hostI2cFailures makes the next transactions fail with a bus error,
+// whoever they address. Suites that replace I2CBus (FakeLcd.h) never get here.
+
+#include <Arduino.h>
+
+struct HostI2cSlave {
+    uint8_t address;
+    explicit HostI2cSlave(uint8_t addr) : address(addr) {}
+    virtual ~HostI2cSlave() {}
+    // A write transaction's bytes; stop = false for a repeated start
+    virtual void onWrite(const uint8_t *data, uint8_t n, bool stop) = 0;
+    // Fill a read of n bytes; returns how many the slave sent
+    virtual uint8_t onRead(uint8_t *data, uint8_t n) = 0;
+};
+
+inline HostI2cSlave *hostI2cSlave = nullptr;
+inline uint8_t hostI2cFailures = 0;
+
+class TwoWire {
+public:
+    uint16_t begins = 0;
+    uint16_t ends = 0;
+    uint32_t clockHz = 0;
+
+    void begin() { begins++; }
+    void end() { ends++; }
+    void setClock(uint32_t hz) { clockHz = hz; }
+
+    void beginTransmission(uint8_t addr) {
+        _addr = addr;
+        _txLen = 0;
+    }
+    size_t write(uint8_t b) {
+        if (_txLen >= sizeof(_tx)) return 0;
+        _tx[_txLen++] = b;
+        return 1;
+    }
+    size_t write(const uint8_t *data, size_t n) {
+        size_t done = 0;
+        while (done < n && write(data[done])) done++;
+        return done;
+    }
+
+    // 0 = ACK, 2 = address NACK, 4 = other error (like the STM32 core)
+    uint8_t endTransmission(bool stop = true) {
+        if (hostI2cFailures) {
+            hostI2cFailures--;
+            return 4;
+        }
+        if (!hostI2cSlave || hostI2cSlave->address != _addr) return 2;
+        hostI2cSlave->onWrite(_tx, _txLen, stop);
+        return 0;
+    }
+
+    uint8_t requestFrom(uint8_t addr, uint8_t n) {
+        _rxLen = 0;
+        _rxPos = 0;
+        if (hostI2cFailures) {
+            hostI2cFailures--;
+            return 0;
+        }
+        if (!hostI2cSlave || hostI2cSlave->address != addr) return 0;
+        if (n > sizeof(_rx)) n = sizeof(_rx);
+        _rxLen = hostI2cSlave->onRead(_rx, n);
+        return _rxLen;
+    }
+    int available() { return _rxLen - _rxPos; }
+    int read() { return (_rxPos < _rxLen) ? _rx[_rxPos++] : -1; }
+
+private:
+    uint8_t _addr = 0;
+    uint8_t _tx[32];
+    uint8_t _txLen = 0;
+    uint8_t _rx[32];
+    uint8_t _rxLen = 0;
+    uint8_t _rxPos = 0;
+};
+
+inline TwoWire Wire;
+
+#endif // HOST_WIRE_H
@@ -0,0 +1,225 @@
+#ifndef HOST_STM32F4XX_HAL_H
+#define HOST_STM32F4XX_HAL_H
+
+// ============================================================================
+// HOST STAND-IN FOR THE STM32F4 HAL ([env:native] tests only)
+// ============================================================================
+// Pulled in by the host Arduino.h when a suite defines STM32F4xx before its
+// includes, the way the real core's Arduino.h pulls in the HAL. Just the
+// registers, handles and macros the encoder timer and feed capture use.
+//
+// The registers are HostReg: reads call hostRegRead (if set) first, so a
+// test can make the hardware move between two reads of the firmware, e.g.
+// wrap the counter between the flag check and the CNT read. The hardware
+// itself is driven by the test: hostTimerCount() clocks an encoder timer,
+// hostDmaRequest() is one DMA transfer on a stream.
+
+#include <stdint.h>
+#include <string.h>
+
+struct HostReg;
+inline void (*hostRegRead)(const HostReg *reg) = nullptr;
+
+struct HostReg {
+    uint32_t value;
+
+    operator uint32_t() const {
+        if (hostRegRead) hostRegRead(this);
+        return value;
+    }
+    HostReg &operator=(uint32_t v) { value = v; return *this; }
+    HostReg &operator|=(uint32_t v) { value |= v; return *this; }
+    HostReg &operator&=(uint32_t v) { value &= v; return *this; }
+};
+
+// ----------------------------------------------------------------------------
+// GPIO
+// ----------------------------------------------------------------------------
+struct GPIO_TypeDef {
+    HostReg IDR;
+    HostReg ODR;
+};
+inline GPIO_TypeDef hostGPIOA, hostGPIOB;
+#define GPIOA (&hostGPIOA)
+#define GPIOB (&hostGPIOB)
+
+struct GPIO_InitTypeDef {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+};
+#define GPIO_PIN_0 0x0001
+#define GPIO_PIN_1 0x0002
+#define GPIO_PIN_3 0x0008
+#define GPIO_PIN_6 0x0040
+#define GPIO_PIN_7 0x0080
+#define GPIO_PIN_15 0x8000
+#define GPIO_MODE_AF_PP 2
+#define GPIO_PULLUP 1
+#define GPIO_SPEED_FREQ_HIGH 2
+#define GPIO_AF1_TIM2 1
+#define GPIO_AF2_TIM4 2
+#define GPIO_AF2_TIM5 2
+inline void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init) {}
+#define __HAL_RCC_GPIOA_CLK_ENABLE() do {} while (0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE() do {} while (0)
+#define __HAL_RCC_DMA2_CLK_ENABLE() do {} while (0)
+
+typedef enum { HAL_OK = 0, HAL_ERROR } HAL_StatusTypeDef;
+
+// ----------------------------------------------------------------------------
+// TIMERS
+// ----------------------------------------------------------------------------
+struct TIM_TypeDef {
+    HostReg CR1;
+    HostReg DIER;
+    HostReg SR;
+    HostReg CCMR1;
+    HostReg CNT;
+    HostReg PSC;
+    HostReg ARR;
+    HostReg CCR1;
+    HostReg CCR2;
+    HostReg CCR3;
+    HostReg CCR4;
+};
+inline TIM_TypeDef hostTIM1, hostTIM2, hostTIM4, hostTIM5;
+#define TIM1 (&hostTIM1)
+#define TIM2 (&hostTIM2)
+#define TIM4 (&hostTIM4)
+#define TIM5 (&hostTIM5)
+
+#define TIM_SR_UIF 0x0001
+#define TIM_SR_CC1IF 0x0002
+#define TIM_SR_CC3IF 0x0008
+#define TIM_DIER_UIE 0x0001
+#define TIM_DIER_CC1IE 0x0002
+#define TIM_DIER_CC3IE 0x0008
+#define TIM_DIER_UDE 0x0100
+#define TIM_FLAG_UPDATE TIM_SR_UIF
+#define TIM_FLAG_CC3 TIM_SR_CC3IF
+#define TIM_IT_UPDATE TIM_DIER_UIE
+#define TIM_IT_CC3 TIM_DIER_CC3IE
+#define TIM_CHANNEL_1 0x0000
+#define TIM_CHANNEL_ALL 0x003C
+
+struct TIM_HandleTypeDef {
+    TIM_TypeDef *Instance;
+};
+
+struct TIM_Encoder_InitTypeDef {
+    uint32_t EncoderMode;
+    uint32_t IC1Polarity, IC1Selection, IC1Prescaler, IC1Filter;
+    uint32_t IC2Polarity, IC2Selection, IC2Prescaler, IC2Filter;
+};
+#define TIM_ENCODERMODE_TI12 3
+#define TIM_ICPOLARITY_RISING 0
+#define TIM_ICSELECTION_DIRECTTI 1
+#define TIM_ICPSC_DIV1 0x0
+#define TIM_ICPSC_DIV8 0xC
+
+inline HAL_StatusTypeDef HAL_TIM_Encoder_Init(TIM_HandleTypeDef *h, TIM_Encoder_InitTypeDef *config) { return HAL_OK; }
+inline HAL_StatusTypeDef HAL_TIM_Encoder_Start(TIM_HandleTypeDef *h, uint32_t channels) { return HAL_OK; }
+#define __HAL_TIM_SET_AUTORELOAD(h, v) ((h)->Instance->ARR = (v))
+#define __HAL_TIM_SET_ICPRESCALER(h, ch, psc) ((h)->Instance->CCMR1 = (psc))
+#define __HAL_TIM_CLEAR_FLAG(h, f) ((h)->Instance->SR &= ~(uint32_t)(f))
+#define __HAL_TIM_ENABLE_IT(h, it) ((h)->Instance->DIER |= (it))
+#define __HAL_TIM_DISABLE_IT(h, it) ((h)->Instance->DIER &= ~(uint32_t)(it))
+
+// Encoder mode seen from the pins: steps counts, one at a time, up or down.
+// Wraps at ARR and sets UIF like the hardware; CC3IF on CNT == CCR3.
+inline void hostTimerCount(TIM_TypeDef *tim, int32_t steps) {
+    uint32_t arr = tim->ARR.value;
+    while (steps != 0) {
+        uint32_t cnt = tim->CNT.value;
+        if (steps > 0) {
+            cnt = (cnt == arr) ? 0 : cnt + 1;
+            if (cnt == 0) tim->SR.value |= TIM_SR_UIF;
+            steps--;
+        } else {
+            cnt = (cnt == 0) ? arr : cnt - 1;
+            if (cnt == arr) tim->SR.value |= TIM_SR_UIF;
+            steps++;
+        }
+        tim->CNT.value = cnt;
+        if (cnt == tim->CCR3.value) tim->SR.value |= TIM_SR_CC3IF;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// DMA
+// ----------------------------------------------------------------------------
+// Addresses stay host pointers (the HAL takes them as 32-bit integers)
+struct DMA_Stream_TypeDef {
+    HostReg NDTR;
+    uintptr_t hostSrc;
+    uintptr_t hostDst;
+    uint32_t hostLength;
+    uint8_t hostSize;  // Bytes per transfer
+    bool hostEnabled;
+};
+inline DMA_Stream_TypeDef hostDMA2_Stream5;
+#define DMA2_Stream5 (&hostDMA2_Stream5)
+
+struct DMA_InitTypeDef {
+    uint32_t Channel, Direction, PeriphInc, MemInc, PeriphDataAlignment, MemDataAlignment;
+    uint32_t Mode, Priority, FIFOMode;
+};
+struct DMA_HandleTypeDef {
+    DMA_Stream_TypeDef *Instance;
+    DMA_InitTypeDef Init;
+};
+#define DMA_CHANNEL_6 6
+#define DMA_PERIPH_TO_MEMORY 0
+#define DMA_PINC_DISABLE 0
+#define DMA_MINC_ENABLE 1
+#define DMA_PDATAALIGN_HALFWORD 1
+#define DMA_PDATAALIGN_WORD 2
+#define DMA_MDATAALIGN_HALFWORD 1
+#define DMA_MDATAALIGN_WORD 2
+#define DMA_CIRCULAR 1
+#define DMA_PRIORITY_HIGH 2
+#define DMA_FIFOMODE_DISABLE 0
+
+inline HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *h) {
+    h->Instance->hostSize = (h->Init.PeriphDataAlignment == DMA_PDATAALIGN_WORD) ? 4 : 2;
+    return HAL_OK;
+}
+inline HAL_StatusTypeDef HAL_DMA_Start(DMA_HandleTypeDef *h, uintptr_t src, uintptr_t dst, uint32_t n) {
+    DMA_Stream_TypeDef *s = h->Instance;
+    s->hostSrc = src;
+    s->hostDst = dst;
+    s->hostLength = n;
+    s->NDTR.value = n;
+    s->hostEnabled = true;
+    return HAL_OK;
+}
+inline HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *h) {
+    h->Instance->hostEnabled = false;
+    return HAL_OK;
+}
+#define __HAL_DMA_GET_COUNTER(h) ((uint32_t)(h)->Instance->NDTR)
+
+// One request: copy the peripheral register to the next slot, circular
+inline void hostDmaRequest(DMA_Stream_TypeDef *s) {
+    if (!s->hostEnabled) return;
+    uint32_t value = ((const HostReg *)s->hostSrc)->value;
+    uint32_t slot = s->hostLength - s->NDTR.value;
+    if (s->hostSize == 2) {
+        ((uint16_t *)s->hostDst)[slot] = (uint16_t)value;
+    } else {
+        ((uint32_t *)s->hostDst)[slot] = value;
+    }
+    s->NDTR.value = (s->NDTR.value == 1) ? s->hostLength : s->NDTR.value - 1;
+}
+
+// ----------------------------------------------------------------------------
+// Core GPIO extras
+// ----------------------------------------------------------------------------
+typedef uint32_t PinName;
+inline PinName digitalPinToPinName(uint32_t pin) { return pin; }
+inline void digitalWriteFast(PinName pin, uint32_t level) { digitalWrite(pin, level); }
+
+#endif // HOST_STM32F4XX_HAL_H
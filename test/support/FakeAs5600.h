@@ -0,0 +1,74 @@
+#ifndef FAKEAS5600_H
+#define FAKEAS5600_H
+
+// ============================================================================
+// AS5600 MODEL FOR HOST TESTS (a slave on the host Wire)
+// ============================================================================
+// Register file with the chip's pointer behaviour: a write sets the pointer
+// (and writes on from the second byte), reads auto-increment, except that
+// ANGLE and RAW ANGLE step from their low byte back to their high byte.
+// CONF keeps only its 14 implemented bits. Counts what the driver costs.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "headers/As5600.h"
+
+struct FakeAs5600 : HostI2cSlave {
+    uint8_t regs[256];
+    uint8_t pointer;
+
+    uint32_t pointerWrites; // Write phases that (re)addressed the chip
+    uint32_t dataWrites;    // Register bytes written
+    uint32_t reads;         // Read transactions
+    uint32_t confWrites;
+
+    FakeAs5600() : HostI2cSlave(AS5600_I2C_ADDR) { reset(); }
+
+    void reset() {
+        memset(regs, 0, sizeof(regs));
+        pointer = 0;
+        pointerWrites = 0;
+        dataWrites = 0;
+        reads = 0;
+        confWrites = 0;
+        regs[AS5600_REG_STATUS] = AS5600_STATUS_MD;
+        regs[AS5600_REG_AGC] = 128;
+    }
+
+    void setAngle(uint16_t angle) {
+        regs[AS5600_REG_ANGLE] = (angle >> 8) & 0x0F;
+        regs[AS5600_REG_ANGLE + 1] = angle & 0xFF;
+        regs[AS5600_REG_RAW_ANGLE] = regs[AS5600_REG_ANGLE];
+        regs[AS5600_REG_RAW_ANGLE + 1] = regs[AS5600_REG_ANGLE + 1];
+    }
+
+    void setConf(uint16_t conf) {
+        regs[AS5600_REG_CONF] = (conf >> 8) & 0x3F;
+        regs[AS5600_REG_CONF + 1] = conf & 0xFF;
+    }
+    uint16_t conf() const { return ((uint16_t)regs[AS5600_REG_CONF] << 8) | regs[AS5600_REG_CONF + 1]; }
+
+    void onWrite(const uint8_t *data, uint8_t n, bool stop) override {
+        if (n == 0) return;
+        pointer = data[0];
+        pointerWrites++;
+        for (uint8_t i = 1; i < n; i++) {
+            if (pointer == AS5600_REG_CONF || pointer == AS5600_REG_CONF + 1) confWrites++;
+            regs[pointer] = (pointer == AS5600_REG_CONF) ? (data[i] & 0x3F) : data[i];
+            pointer++;
+            dataWrites++;
+        }
+    }
+
+    uint8_t onRead(uint8_t *data, uint8_t n) override {
+        reads++;
+        for (uint8_t i = 0; i < n; i++) {
+            data[i] = regs[pointer];
+            if (pointer == AS5600_REG_ANGLE + 1 || pointer == AS5600_REG_RAW_ANGLE + 1) pointer--;
+            else pointer++;
+        }
+        return n;
+    }
+};
+
+#endif // FAKEAS5600_H
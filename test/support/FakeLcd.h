@@ -0,0 +1,135 @@
+#ifndef FAKELCD_H
+#define FAKELCD_H
+
+// ============================================================================
+// HD44780 + PCF8574 MODEL FOR HOST TESTS
+// ============================================================================
+// Stands in for I2CBus.cpp: every write the LCD transport makes lands on a
+// model backpack that latches a nibble on each EN falling edge, pairs them
+// into LCD bytes and runs them against DDRAM/CGRAM like the controller does.
+// Only what the firmware sends is modelled: set DDRAM / CGRAM address, clear,
+// data writes with auto-increment, and the 8-bit / 4-bit function set (in
+// 8-bit mode every EN pulse is a whole instruction, D3-D0 reading 0).
+//
+// Inline throughout: include it in every test unit that links I2CBus users.
+
+#include <Arduino.h>
+#include "headers/I2CBus.h"
+
+struct LcdModel {
+    uint8_t ddram[0x80];
+    uint8_t cgram[64];
+    uint8_t addr;
+    bool cgramMode;
+
+    uint8_t lastExpander;
+    bool eightBit;
+    bool haveHighNibble;
+    uint8_t highNibble;
+
+    uint32_t commands;
+    uint32_t clears;    // Clear display instructions (0x01)
+    uint32_t dataBytes;
+    uint32_t writes;    // I2C transactions
+    uint32_t maxWrite;  // Longest transaction, bytes
+    bool failWrites;    // Bus errors: the bytes are lost
+    int16_t failAfter;  // >= 0: the next write latches this many bytes, then fails
+
+    LcdModel() { reset(); }
+
+    void reset() {
+        memset(ddram, ' ', sizeof(ddram));
+        memset(cgram, 0, sizeof(cgram));
+        addr = 0;
+        cgramMode = false;
+        lastExpander = 0;
+        eightBit = false;
+        haveHighNibble = false;
+        highNibble = 0;
+        commands = 0;
+        clears = 0;
+        dataBytes = 0;
+        writes = 0;
+        maxWrite = 0;
+        failWrites = false;
+        failAfter = -1;
+    }
+
+    uint8_t at(uint8_t col, uint8_t row) const {
+        static const uint8_t ROWS[4] = { 0x00, 0x40, 0x14, 0x54 };
+        return ddram[ROWS[row] + col];
+    }
+
+    void expander(uint8_t value) {
+        bool fallingEn = (lastExpander & 0x04) && !(value & 0x04);
+        if (fallingEn) {
+            uint8_t nibble = lastExpander & 0xF0;
+            if (eightBit) {
+                lcdByte(nibble, lastExpander & 0x01);
+            } else if (!haveHighNibble) {
+                highNibble = nibble;
+                haveHighNibble = true;
+            } else {
+                haveHighNibble = false;
+                lcdByte(highNibble | (nibble >> 4), lastExpander & 0x01);
+            }
+        }
+        lastExpander = value;
+    }
+
+    void lcdByte(uint8_t b, bool rs) {
+        if (!rs) {
+            commands++;
+            if (b & 0x80) {
+                addr = b & 0x7F;
+                cgramMode = false;
+            } else if (b & 0x40) {
+                addr = b & 0x3F;
+                cgramMode = true;
+            } else if (b & 0x20) {
+                eightBit = (b & 0x10) != 0; // Function set: DL
+                haveHighNibble = false;
+            } else if (b == 0x01) {
+                clears++;
+                memset(ddram, ' ', sizeof(ddram));
+                addr = 0;
+                cgramMode = false;
+            }
+            return;
+        }
+        dataBytes++;
+        if (cgramMode) {
+            cgram[addr] = b;
+            addr = (addr + 1) & 0x3F;
+        } else {
+            ddram[addr] = b;
+            addr++;
+            if (addr == 0x28) addr = 0x40;
+            else if (addr == 0x68) addr = 0x00;
+        }
+    }
+};
+
+inline LcdModel lcdModel;
+
+inline I2CBus::I2CBus() {}
+
+// No other clients: every grant is in full
+inline uint16_t I2CBus::grant(I2CClient who, uint16_t want) { return want; }
+
+inline bool I2CBus::write(I2CClient who, uint8_t addr, const uint8_t *data, uint8_t n) {
+    lcdModel.writes++;
+    if (n > lcdModel.maxWrite) lcdModel.maxWrite = n;
+    if (lcdModel.failWrites) return false;
+    if (lcdModel.failAfter >= 0) {
+        for (uint8_t i = 0; i < n && i < lcdModel.failAfter; i++) lcdModel.expander(data[i]);
+        lcdModel.failAfter = -1;
+        return false;
+    }
+    for (uint8_t i = 0; i < n; i++) lcdModel.expander(data[i]);
+    return true;
+}
+
+inline I2CBus i2cBus;
+
+#endif // FAKELCD_H
@@ -0,0 +1,92 @@
+#ifndef PULSETRAIN_H
+#define PULSETRAIN_H
+
+// ============================================================================
+// SYNTHETIC ENCODER FOR HOST TESTS
+// ============================================================================
+// Reproduces what EncoderSys::sampleISR feeds the motion estimator: a 1 kHz
+// sample of the count, and the latest CH1 capture (count + ISR timestamp with
+// a few us of latency). CH1 captures every A rising edge (one per 4 counts),
+// or every 8th one while the /8 prescaler is on, switched with EncoderSys's
+// thresholds. Position is integrated in 1 us steps from a velocity function.
+
+#include <Arduino.h>
+#include <functional>
+#include "headers/MotionEstimator.h"
+
+static const uint32_t SAMPLE_HZ = 1000;
+static const uint32_t SAMPLE_US = 1000000 / SAMPLE_HZ;
+static const int32_t DIV8_ABOVE = 8000; // EncoderSys.cpp CAPTURE_DIV8_ABOVE
+static const int32_t DIV1_BELOW = 4000; // EncoderSys.cpp CAPTURE_DIV1_BELOW
+
+struct PulseTrain {
+    MotionEstimator est;
+    double pos;        // Exact position, counts
+    int64_t count;
+    uint32_t nowUs;
+    uint32_t edgeSeq;
+    int64_t edgeCount;
+    uint32_t edgeTimeUs;
+    bool div8;
+    uint8_t prescaleCount;
+    uint32_t rng;
+    uint32_t maxLatencyUs; // Capture ISR entry: 1..maxLatencyUs
+
+    // Called for every capture (what EncoderSys::onCapture sees)
+    std::function<void(uint32_t edgeTimeUs, uint8_t edgesPerCapture)> onCapture;
+
+    PulseTrain() : pos(0.5), count(0), nowUs(1000), edgeSeq(0), edgeCount(0), edgeTimeUs(0),
+                   div8(false), prescaleCount(0), rng(12345), maxLatencyUs(4) {
+        est.reset(0, nowUs, 0);
+    }
+
+    uint32_t latencyUs() {
+        rng = rng * 1103515245u + 12345u;
+        return 1 + (rng >> 16) % maxLatencyUs;
+    }
+
+    uint32_t nowMs() const { return nowUs / 1000; }
+
+    static bool channelA(int64_t c) {
+        int64_t phase = ((c % 4) + 4) % 4;
+        return phase == 1 || phase == 2;
+    }
+
+    // One sample period at velocity(t) counts/s, in 1 us steps. Returns
+    // MotionEstimator::update()'s "new edge estimate".
+    template <typename VelocityFn>
+    bool sample(VelocityFn velocity) {
+        for (uint32_t i = 0; i < SAMPLE_US; i++) {
+            nowUs++;
+            pos += velocity(nowUs) / 1e6;
+            int64_t target = (int64_t)floor(pos);
+            while (count != target) {
+                bool aBefore = channelA(count);
+                count += (target > count) ? 1 : -1;
+                if (!aBefore && channelA(count)) {
+                    if (!div8 || ++prescaleCount >= 8) {
+                        prescaleCount = 0;
+                        edgeSeq += 2;
+                        edgeCount = count;
+                        edgeTimeUs = nowUs + latencyUs();
+                        if (onCapture) onCapture(edgeTimeUs, div8 ? 8 : 1);
+                    }
+                }
+            }
+        }
+        bool estimated = est.update(count, nowUs, SAMPLE_HZ, edgeSeq, edgeCount, edgeTimeUs);
+
+        int32_t countsPerSec = abs(est.getVelocityQ8() >> 8);
+        if (!div8 && countsPerSec > DIV8_ABOVE) {
+            div8 = true;
+            prescaleCount = 0;
+        } else if (div8 && countsPerSec < DIV1_BELOW) {
+            div8 = false;
+        }
+        return estimated;
+    }
+
+    int32_t velocity() const { return est.getVelocityQ8() / 256; }
+};
+
+#endif // PULSETRAIN_H
@@ -0,0 +1,110 @@
+// AngleCalibration fit and lookup, including the 4095 -> 0 seam
+#include <unity.h>
+#include <Arduino.h>
+#include "source/AngleCalibration.cpp"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Sensor with an off-centre magnet: raw = zero + dir * (angle + wobble)
+static uint16_t sensorRaw(double deg, uint16_t zero, int dir) {
+    double counts = deg * 4096.0 / 360.0 + 6.0 * sin(deg * M_PI / 90.0);
+    long raw = lround(zero + dir * counts);
+    return (uint16_t)(((raw % 4096) + 4096) % 4096);
+}
+
+static void capture(uint16_t *raw, uint8_t n, uint8_t stepDeg, uint16_t zero, int dir) {
+    for (uint8_t i = 0; i < n; i++) raw[i] = sensorRaw(i * stepDeg, zero, dir);
+}
+
+void test_wrap_diff(void) {
+    TEST_ASSERT_EQUAL_INT16(10, angleWrapDiff(4090, 4));
+    TEST_ASSERT_EQUAL_INT16(-10, angleWrapDiff(4, 4090));
+    TEST_ASSERT_EQUAL_INT16(-2048, angleWrapDiff(0, 2048));
+    TEST_ASSERT_EQUAL_INT16(2047, angleWrapDiff(0, 2047));
+}
+
+void test_default_table(void) {
+    AngleCalibration cal;
+    TEST_ASSERT_EQUAL_INT32(0, cal.toCentiDeg(0));
+    TEST_ASSERT_EQUAL_INT32(2250, cal.toCentiDeg(256));
+    TEST_ASSERT_EQUAL_INT32(4500, cal.toCentiDeg(512));
+    // Below zero: same slope, from whole-centidegree nodes
+    TEST_ASSERT_INT32_WITHIN(3, -2250, cal.toCentiDeg(4096 - 256));
+}
+
+// Every captured point reads back at its angle, and the wobble between them
+// is followed far better than a straight 0/45 line would manage
+static void checkFit(uint16_t zero, int dir) {
+    uint16_t raw[4];
+    capture(raw, 4, 15, zero, dir);
+    AngleCalibration cal;
+    TEST_ASSERT_TRUE(cal.fit(raw, 4, 15));
+
+    for (uint8_t i = 0; i < 4; i++) {
+        TEST_ASSERT_INT32_WITHIN(15, i * 1500, cal.toCentiDeg(raw[i]));
+    }
+    for (double deg = 0; deg <= 45; deg += 0.5) {
+        TEST_ASSERT_INT32_WITHIN(25, (int32_t)lround(deg * 100), cal.toCentiDeg(sensorRaw(deg, zero, dir)));
+    }
+}
+
+void test_fit_rising(void) { checkFit(1000, 1); }
+void test_fit_falling(void) { checkFit(3000, -1); }
+void test_fit_across_seam(void) { checkFit(3900, 1); }
+void test_fit_falling_across_seam(void) { checkFit(200, -1); }
+
+void test_extrapolates_past_the_ends(void) {
+    uint16_t raw[4];
+    capture(raw, 4, 15, 1000, 1);
+    AngleCalibration cal;
+    TEST_ASSERT_TRUE(cal.fit(raw, 4, 15));
+
+    // A few degrees either side: wobble + end slope, still close
+    TEST_ASSERT_INT32_WITHIN(60, -300, cal.toCentiDeg(sensorRaw(-3, 1000, 1)));
+    TEST_ASSERT_INT32_WITHIN(60, 4800, cal.toCentiDeg(sensorRaw(48, 1000, 1)));
+    TEST_ASSERT_LESS_THAN_INT32(cal.toCentiDeg(sensorRaw(60, 1000, 1)), cal.toCentiDeg(sensorRaw(50, 1000, 1)));
+}
+
+void test_rejects_bad_captures(void) {
+    AngleCalibration cal;
+    uint16_t good[2] = { 0, 512 };
+    uint16_t one[1] = { 100 };
+    uint16_t same[3] = { 100, 300, 300 };
+    uint16_t back[3] = { 100, 300, 200 };
+    uint16_t half[3] = { 0, 1024, 2048 };
+    uint16_t many[9] = { 0, 10, 20, 30, 40, 50, 60, 70, 80 };
+
+    TEST_ASSERT_FALSE(cal.fit(one, 1, 15));
+    TEST_ASSERT_FALSE(cal.fit(same, 3, 15));
+    TEST_ASSERT_FALSE(cal.fit(back, 3, 15));
+    TEST_ASSERT_FALSE(cal.fit(half, 3, 90));
+    TEST_ASSERT_FALSE(cal.fit(many, 9, 1));
+    TEST_ASSERT_FALSE(cal.fit(good, 2, 0));
+
+    // Table unchanged: still the defaults
+    TEST_ASSERT_EQUAL_INT32(4500, cal.toCentiDeg(512));
+}
+
+void test_refit_replaces_table(void) {
+    AngleCalibration cal;
+    uint16_t raw[3] = { 2000, 1800, 1600 }; // Falling, 200 counts per 20 degrees
+    TEST_ASSERT_TRUE(cal.fit(raw, 3, 20));
+    TEST_ASSERT_EQUAL_INT32(0, cal.toCentiDeg(2000));
+    TEST_ASSERT_EQUAL_INT32(3000, cal.toCentiDeg(1700));
+    TEST_ASSERT_EQUAL_INT32(4000, cal.toCentiDeg(1600));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_wrap_diff);
+    RUN_TEST(test_default_table);
+    RUN_TEST(test_fit_rising);
+    RUN_TEST(test_fit_falling);
+    RUN_TEST(test_fit_across_seam);
+    RUN_TEST(test_fit_falling_across_seam);
+    RUN_TEST(test_extrapolates_past_the_ends);
+    RUN_TEST(test_rejects_bad_captures);
+    RUN_TEST(test_refit_replaces_table);
+    return UNITY_END();
+}
@@ -0,0 +1,154 @@
+// AngleSensor filter chain (median of 3, EMA, deadband) fed by a model AS5600
+#include <unity.h>
+#include <Arduino.h>
+#include "FakeAs5600.h"
+#include "headers/AngleSensor.h"
+#include "source/AngleSensor.cpp"
+#include "source/AngleCalibration.cpp"
+#include "source/As5600.cpp"
+#include "source/I2CBus.cpp"
+
+static FakeAs5600 chip;
+
+// One background sample of the given raw angle, paced by the tick like main.cpp
+static void sample(AngleSensor &s, uint16_t raw) {
+    chip.setAngle(raw);
+    for (uint16_t t = 0; t < SYSTEM_TICK_HZ / ANGLE_SAMPLE_HZ; t++) {
+        s.tickISR();
+    }
+    s.update();
+}
+
+// Distance between two raw angles the short way round the circle
+static int16_t seamDistance(uint16_t a, uint16_t b) {
+    int16_t d = (int16_t)((a - b) & 0x0FFF);
+    return (d >= 2048) ? d - 4096 : d;
+}
+
+void setUp(void) {
+    chip.reset();
+    hostI2cSlave = &chip;
+    hostI2cFailures = 0;
+    i2cBus = I2CBus();
+}
+
+void tearDown(void) {}
+
+void test_samples_only_when_due(void) {
+    AngleSensor s;
+    TEST_ASSERT_TRUE(s.init());
+    uint32_t reads = chip.reads;
+    s.update(); // No tick yet
+    TEST_ASSERT_EQUAL_UINT32(reads, chip.reads);
+    sample(s, 1000);
+    TEST_ASSERT_EQUAL_UINT32(reads + 1, chip.reads);
+    TEST_ASSERT_EQUAL_UINT16(1000, s.getRawAngle()); // First sample seeds the EMA
+}
+
+void test_noise_on_the_seam_stays_on_the_seam(void) {
+    AngleSensor s;
+    s.init();
+    const uint16_t noise[] = { 4094, 1, 4095, 2, 0, 4093, 3, 4095 };
+    for (uint8_t round = 0; round < 20; round++) {
+        for (uint16_t raw : noise) {
+            sample(s, raw);
+            // A plain average of 4095 and 1 would be 2048
+            TEST_ASSERT_INT_WITHIN(4, 0, seamDistance(s.getRawAngle(), 0));
+        }
+    }
+}
+
+void test_step_across_the_seam(void) {
+    AngleSensor s;
+    s.init();
+    for (uint8_t i = 0; i < 10; i++) sample(s, 4080);
+    for (uint8_t i = 0; i < 40; i++) {
+        sample(s, 20);
+        // Takes the short way (+36), never through the middle of the range
+        int16_t d = seamDistance(s.getRawAngle(), 4080);
+        TEST_ASSERT_TRUE(d >= 0 && d <= 36);
+    }
+    TEST_ASSERT_INT_WITHIN(1, 0, seamDistance(s.getRawAngle(), 20));
+}
+
+void test_median_rejects_single_impulse(void) {
+    AngleSensor s;
+    s.init();
+    for (uint8_t i = 0; i < 10; i++) sample(s, 1000);
+
+    sample(s, 3000); // One bad read: median of (3000, 1000, 1000)
+    TEST_ASSERT_EQUAL_UINT16(1000, s.getRawAngle());
+    sample(s, 1000);
+    TEST_ASSERT_EQUAL_UINT16(1000, s.getRawAngle());
+    sample(s, 1000); // 3000 out of the window
+
+    sample(s, 0); // Also across the seam
+    TEST_ASSERT_EQUAL_UINT16(1000, s.getRawAngle());
+}
+
+void test_ema_converges_without_overshoot(void) {
+    AngleSensor s;
+    s.init();
+    for (uint8_t i = 0; i < 10; i++) sample(s, 1000);
+
+    // The median holds the first sample of a real move back by one
+    sample(s, 1200);
+    TEST_ASSERT_EQUAL_UINT16(1000, s.getRawAngle());
+
+    uint16_t last = 1000;
+    uint8_t n = 0;
+    while (s.getRawAngle() < 1199 && n < 50) {
+        sample(s, 1200);
+        TEST_ASSERT_TRUE(s.getRawAngle() >= last); // Monotonic
+        TEST_ASSERT_TRUE(s.getRawAngle() <= 1200); // No overshoot
+        last = s.getRawAngle();
+        n++;
+    }
+    // Weight 1/2^ANGLE_EMA_SHIFT: within a count in a few dozen samples
+    TEST_ASSERT_TRUE(n < 30);
+    for (uint8_t i = 0; i < 30; i++) sample(s, 1200);
+    TEST_ASSERT_INT_WITHIN(1, 1200, s.getRawAngle());
+}
+
+void test_deadband_holds_small_moves(void) {
+    // Default calibration: 256 raw = 22.5 degrees, one count ~0.088 degrees
+    AngleSensor s;
+    s.init();
+    for (uint8_t i = 0; i < 60; i++) sample(s, 256);
+    float settled = s.getAngleDegrees();
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 22.5f, settled);
+
+    // Two counts (~0.18 degrees): filtered in, but not shown
+    for (uint8_t i = 0; i < 60; i++) sample(s, 258);
+    TEST_ASSERT_INT_WITHIN(1, 258, s.getRawAngle());
+    TEST_ASSERT_EQUAL_FLOAT(settled, s.getAngleDegrees());
+
+    // Four counts (~0.35 degrees): published
+    for (uint8_t i = 0; i < 60; i++) sample(s, 260);
+    TEST_ASSERT_TRUE(s.getAngleDegrees() > settled + 0.2f);
+}
+
+void test_read_error_keeps_last_value(void) {
+    AngleSensor s;
+    s.init();
+    for (uint8_t i = 0; i < 60; i++) sample(s, 512);
+    float degrees = s.getAngleDegrees();
+
+    hostI2cFailures = 1;
+    sample(s, 3000);
+    TEST_ASSERT_EQUAL_UINT32(1, s.getSampleErrors());
+    TEST_ASSERT_EQUAL_UINT16(512, s.getRawAngle());
+    TEST_ASSERT_EQUAL_FLOAT(degrees, s.getAngleDegrees());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_samples_only_when_due);
+    RUN_TEST(test_noise_on_the_seam_stays_on_the_seam);
+    RUN_TEST(test_step_across_the_seam);
+    RUN_TEST(test_median_rejects_single_impulse);
+    RUN_TEST(test_ema_converges_without_overshoot);
+    RUN_TEST(test_deadband_holds_small_moves);
+    RUN_TEST(test_read_error_keeps_last_value);
+    return UNITY_END();
+}
@@ -0,0 +1,140 @@
+// As5600 driver against a model chip: CONF setup and register pointer reuse
+#include <unity.h>
+#include <Arduino.h>
+#include "FakeAs5600.h"
+#include "headers/As5600.h"
+#include "source/As5600.cpp"
+#include "source/I2CBus.cpp"
+
+#define CONF_OUTS_MASK 0x0030 // Output stage (OUT pin), not ours to change
+#define CONF_PWMF_MASK 0x00C0 // PWM frequency
+
+static FakeAs5600 chip;
+
+void setUp(void) {
+    chip.reset();
+    hostI2cSlave = &chip;
+    hostI2cFailures = 0;
+    i2cBus = I2CBus();
+}
+
+void tearDown(void) {}
+
+void test_begin_sets_filters(void) {
+    As5600 as;
+    TEST_ASSERT_TRUE(as.begin());
+
+    uint16_t conf = chip.conf();
+    TEST_ASSERT_EQUAL_UINT16(AS5600_SLOW_FILTER, (conf & AS5600_CONF_SF_MASK) >> AS5600_CONF_SF_POS);
+    TEST_ASSERT_EQUAL_UINT16(AS5600_FAST_FILTER, (conf & AS5600_CONF_FTH_MASK) >> AS5600_CONF_FTH_POS);
+    TEST_ASSERT_EQUAL_UINT16(AS5600_HYSTERESIS, (conf & AS5600_CONF_HYST_MASK) >> AS5600_CONF_HYST_POS);
+    TEST_ASSERT_EQUAL_UINT16(0, conf & AS5600_CONF_PM_MASK); // Normal power
+    TEST_ASSERT_EQUAL_UINT16(0, conf & AS5600_CONF_WD);
+    TEST_ASSERT_EQUAL_UINT16(conf, as.getConf());
+}
+
+void test_begin_keeps_output_bits(void) {
+    // Whatever was there: low-power mode, watchdog, other filters, and an
+    // output stage / PWM frequency someone chose
+    uint16_t before = 0x3FFF;
+    chip.setConf(before);
+
+    As5600 as;
+    TEST_ASSERT_TRUE(as.begin());
+    uint16_t conf = chip.conf();
+    TEST_ASSERT_EQUAL_HEX16(before & (CONF_OUTS_MASK | CONF_PWMF_MASK), conf & (CONF_OUTS_MASK | CONF_PWMF_MASK));
+    TEST_ASSERT_EQUAL_UINT16(0, conf & (AS5600_CONF_PM_MASK | AS5600_CONF_WD));
+    TEST_ASSERT_EQUAL_UINT16(AS5600_SLOW_FILTER, (conf & AS5600_CONF_SF_MASK) >> AS5600_CONF_SF_POS);
+
+    chip.setConf(0x0020); // OUTS = 2 only
+    TEST_ASSERT_TRUE(as.begin());
+    TEST_ASSERT_EQUAL_HEX16(0x0020, chip.conf() & (CONF_OUTS_MASK | CONF_PWMF_MASK));
+}
+
+void test_begin_is_read_modify_write_verify(void) {
+    As5600 as;
+    TEST_ASSERT_TRUE(as.begin());
+    TEST_ASSERT_EQUAL_UINT32(2, chip.confWrites); // One write of both bytes
+    TEST_ASSERT_EQUAL_UINT32(2, chip.reads);      // Read before, read back after
+}
+
+void test_begin_fails_without_chip(void) {
+    hostI2cSlave = nullptr;
+    As5600 as;
+    TEST_ASSERT_FALSE(as.begin());
+}
+
+void test_consecutive_angle_reads_reuse_pointer(void) {
+    As5600 as;
+    TEST_ASSERT_TRUE(as.begin());
+    uint32_t addressed = chip.pointerWrites;
+
+    uint16_t angle;
+    chip.setAngle(0x0ABC);
+    TEST_ASSERT_TRUE(as.readAngle(&angle));
+    TEST_ASSERT_EQUAL_HEX16(0x0ABC, angle);
+    TEST_ASSERT_EQUAL_UINT32(addressed + 1, chip.pointerWrites); // First sample sets it
+
+    for (uint16_t i = 0; i < 100; i++) {
+        chip.setAngle(i * 40);
+        TEST_ASSERT_TRUE(as.readAngle(&angle));
+        TEST_ASSERT_EQUAL_UINT16(i * 40, angle);
+    }
+    TEST_ASSERT_EQUAL_UINT32(addressed + 1, chip.pointerWrites); // Bare reads after that
+}
+
+void test_other_register_access_readdresses(void) {
+    As5600 as;
+    TEST_ASSERT_TRUE(as.begin());
+    uint16_t angle;
+    as.readAngle(&angle);
+    uint32_t addressed = chip.pointerWrites;
+
+    TEST_ASSERT_EQUAL(AS5600_MAGNET_OK, as.readMagnet());
+    chip.setAngle(1234);
+    TEST_ASSERT_TRUE(as.readAngle(&angle));
+    TEST_ASSERT_EQUAL_UINT16(1234, angle); // Not STATUS's neighbours
+    TEST_ASSERT_EQUAL_UINT32(addressed + 2, chip.pointerWrites);
+}
+
+void test_failed_read_readdresses(void) {
+    As5600 as;
+    TEST_ASSERT_TRUE(as.begin());
+    uint16_t angle;
+    as.readAngle(&angle);
+
+    hostI2cFailures = 1;
+    TEST_ASSERT_FALSE(as.readAngle(&angle));
+    uint32_t addressed = chip.pointerWrites;
+
+    chip.pointer = 0; // The chip may have reset
+    chip.setAngle(777);
+    TEST_ASSERT_TRUE(as.readAngle(&angle));
+    TEST_ASSERT_EQUAL_UINT16(777, angle);
+    TEST_ASSERT_EQUAL_UINT32(addressed + 1, chip.pointerWrites);
+}
+
+void test_magnet_status_decoded(void) {
+    As5600 as;
+    chip.regs[AS5600_REG_STATUS] = 0;
+    TEST_ASSERT_EQUAL(AS5600_MAGNET_MISSING, as.readMagnet());
+    chip.regs[AS5600_REG_STATUS] = AS5600_STATUS_MD | AS5600_STATUS_ML;
+    TEST_ASSERT_EQUAL(AS5600_MAGNET_WEAK, as.readMagnet());
+    chip.regs[AS5600_REG_STATUS] = AS5600_STATUS_MD | AS5600_STATUS_MH;
+    TEST_ASSERT_EQUAL(AS5600_MAGNET_STRONG, as.readMagnet());
+    hostI2cSlave = nullptr;
+    TEST_ASSERT_EQUAL(AS5600_NO_RESPONSE, as.readMagnet());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_begin_sets_filters);
+    RUN_TEST(test_begin_keeps_output_bits);
+    RUN_TEST(test_begin_is_read_modify_write_verify);
+    RUN_TEST(test_begin_fails_without_chip);
+    RUN_TEST(test_consecutive_angle_reads_reuse_pointer);
+    RUN_TEST(test_other_register_access_readdresses);
+    RUN_TEST(test_failed_read_readdresses);
+    RUN_TEST(test_magnet_status_decoded);
+    return UNITY_END();
+}
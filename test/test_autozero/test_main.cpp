@@ -0,0 +1,143 @@
+// AutoZeroSys state machine, ticked at 1 kHz as from the tick ISR
+#include <unity.h>
+#include <Arduino.h>
+#include "headers/AutoZeroSys.h"
+#include "source/AutoZeroSys.cpp"
+
+static AutoZeroSys az;
+static uint32_t nowMs;
+
+// ms ticks at a fixed position and speed
+static void hold(uint32_t ms, PositionUM um, int32_t velocityUMs = 0) {
+    for (uint32_t i = 0; i < ms; i++) {
+        az.sampleISR(um, velocityUMs, nowMs);
+        nowMs++;
+    }
+}
+
+void setUp(void) {
+    az = AutoZeroSys();
+    az.configure(500, 2000, 5000);
+    az.setEnabled(true);
+    nowMs = 1000;
+}
+
+void tearDown(void) {}
+
+void test_disabled_does_nothing(void) {
+    az.setEnabled(false);
+    hold(2000, 100000);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_DISABLED, az.getState());
+    PositionUM cut;
+    TEST_ASSERT_FALSE(az.takeCut(&cut));
+}
+
+void test_arms_after_arm_delay(void) {
+    hold(499, 120000);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_MEASURING, az.getState());
+    hold(3, 120000);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_ARMED, az.getState());
+    TEST_ASSERT_EQUAL_INT32(120000, az.getLockedPosition());
+}
+
+void test_moving_never_arms(void) {
+    PositionUM um = 0;
+    for (int i = 0; i < 2000; i++) {
+        az.sampleISR(um, 200000, nowMs++); // 200 mm/s feed
+        um += 200;
+    }
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_MEASURING, az.getState());
+}
+
+void test_jitter_inside_band_still_arms(void) {
+    for (int i = 0; i < 600; i++) {
+        az.sampleISR(50000 + ((i & 1) ? 800 : -800), 0, nowMs++);
+    }
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_ARMED, az.getState());
+}
+
+void test_creep_beyond_band_restarts_timing(void) {
+    hold(400, 50000);
+    hold(400, 52500); // Crept 2.5 mm: window starts again here
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_MEASURING, az.getState());
+    hold(101, 52500);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_ARMED, az.getState());
+    TEST_ASSERT_EQUAL_INT32(52500, az.getLockedPosition());
+}
+
+void test_still_hysteresis(void) {
+    // 2 mm/s: not still coming from motion...
+    hold(1000, 0, 2000);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_MEASURING, az.getState());
+    // ...but still once below 1 mm/s, until over 3 mm/s
+    hold(10, 0, 500);
+    hold(600, 0, 2000);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_ARMED, az.getState());
+}
+
+void test_cut_taken_once(void) {
+    hold(600, 300000);
+    hold(1, 300000 - 4000); // Inside the trigger
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_ARMED, az.getState());
+    hold(1, 300000 - 6000, -200000); // Stock pulled back for the cut
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_CUT_PENDING, az.getState());
+
+    hold(100, 0, -200000); // The ISR leaves a pending cut alone
+    PositionUM cut = 0;
+    TEST_ASSERT_TRUE(az.takeCut(&cut));
+    TEST_ASSERT_EQUAL_INT32(300000, cut);
+    TEST_ASSERT_FALSE(az.takeCut(&cut));
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_MEASURING, az.getState());
+
+    // Re-anchors after the main loop re-zeroes
+    hold(600, 0);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_ARMED, az.getState());
+    TEST_ASSERT_EQUAL_INT32(0, az.getLockedPosition());
+}
+
+void test_disarm_drops_pending_cut(void) {
+    hold(600, 300000);
+    hold(1, 290000, 200000);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_CUT_PENDING, az.getState());
+
+    az.disarm(); // Manual zero
+    PositionUM cut;
+    TEST_ASSERT_FALSE(az.takeCut(&cut));
+    hold(499, 0);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_MEASURING, az.getState());
+    hold(2, 0);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_ARMED, az.getState());
+}
+
+void test_disable_drops_pending_cut(void) {
+    hold(600, 300000);
+    hold(1, 290000, 200000);
+    az.setEnabled(false);
+    PositionUM cut;
+    TEST_ASSERT_FALSE(az.takeCut(&cut));
+    hold(10, 290000);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_DISABLED, az.getState());
+}
+
+void test_arm_delay_across_millis_wrap(void) {
+    nowMs = UINT32_MAX - 200;
+    hold(499, 7000);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_MEASURING, az.getState());
+    hold(2, 7000);
+    TEST_ASSERT_EQUAL(AutoZeroSys::AZ_ARMED, az.getState());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_disabled_does_nothing);
+    RUN_TEST(test_arms_after_arm_delay);
+    RUN_TEST(test_moving_never_arms);
+    RUN_TEST(test_jitter_inside_band_still_arms);
+    RUN_TEST(test_creep_beyond_band_restarts_timing);
+    RUN_TEST(test_still_hysteresis);
+    RUN_TEST(test_cut_taken_once);
+    RUN_TEST(test_disarm_drops_pending_cut);
+    RUN_TEST(test_disable_drops_pending_cut);
+    RUN_TEST(test_arm_delay_across_millis_wrap);
+    return UNITY_END();
+}
@@ -0,0 +1,331 @@
+// BigFont cell tables rendered to pixels through the glyph bitmaps
+#include <unity.h>
+#include <Arduino.h>
+#include "headers/BigFont.h"
+#include "source/BigFont.cpp"
+#include "source/LcdGlyphs.cpp"
+
+// The eight bars the original DisplaySys::init() loaded into CGRAM 0-7
+static const uint8_t ORIGINAL_BARS[8][8] = {
+    { 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // Upper bar (2 rows)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F }, // Lower bar (2 rows)
+    { 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F }, // Upper and lower bar (2+2 rows)
+    { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 }, // Left bar (2 pixels wide, full height)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x18 }, // Left lower bar (2 pixels)
+    { 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x18, 0x18 }, // Left upper and lower (2 pixels)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E }, // Decimal point
+    { 0x00, 0x00, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00 }, // Colon
+};
+
+// What each glyph shows: 2 rows of 8 pixel lines, cells side by side
+struct Art {
+    char ch;
+    const char *lines[16];
+};
+
+static const Art EXPECTED[] = {
+    { '0', {
+        "##... ##### ##...",
+        "##... ##### ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ##### ##...",
+        "##... ##### ##...",
+    } },
+    { '1', {
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+    } },
+    { '2', {
+        "##### ##### ##...",
+        "##### ##### ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "##### ##### ##...",
+        "##### ##### ##...",
+        "##... ..... .....",
+        "##... ..... .....",
+        "##... ..... .....",
+        "##... ..... .....",
+        "##... ..... .....",
+        "##... ..... ##...",
+        "##... ##### ##...",
+        "##... ##### ##...",
+    } },
+    { '3', {
+        "##### ##### ##...",
+        "##### ##### ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "##### ##### ##...",
+        "##### ##### ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "##### ##### ##...",
+        "##### ##### ##...",
+    } },
+    { '4', {
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ##### ##...",
+        "##... ##### ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+    } },
+    { '5', {
+        "##... ##### ##...",
+        "##... ##### ##...",
+        "##... ..... ##...",
+        "##... ..... .....",
+        "##... ..... .....",
+        "##... ..... .....",
+        "##... ##### ##...",
+        "##... ##### ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "##### ##### ##...",
+        "##### ##### ##...",
+    } },
+    { '6', {
+        "##... ##### ##...",
+        "##... ##### ##...",
+        "##... ..... ##...",
+        "##... ..... .....",
+        "##... ..... .....",
+        "##... ..... .....",
+        "##... ##### ##...",
+        "##... ##### ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ##### ##...",
+        "##... ##### ##...",
+    } },
+    { '7', {
+        "##### ##### ##...",
+        "##### ##### ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+    } },
+    { '8', {
+        "##... ##### ##...",
+        "##... ##### ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ##### ##...",
+        "##... ##### ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ##### ##...",
+        "##... ##### ##...",
+    } },
+    { '9', {
+        "##... ##### ##...",
+        "##... ##### ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ..... ##...",
+        "##... ##### ##...",
+        "##... ##### ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "..... ..... ##...",
+        "##### ##### ##...",
+        "##### ##### ##...",
+    } },
+    { '-', {
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "##### ##### .....",
+        "##### ##### .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+    } },
+    { '.', {
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".###.",
+        ".###.",
+        ".###.",
+    } },
+    { ' ', {
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+        "..... ..... .....",
+    } },
+};
+
+// One pixel line of a glyph, cells separated by a space (the LCD's gap)
+static void renderLine(const BigGlyph *g, uint8_t line, char *out) {
+    uint8_t row = line / 8;
+    uint8_t y = line % 8;
+    char *p = out;
+    for (uint8_t c = 0; c < g->width; c++) {
+        uint8_t code = g->cells[row][c];
+        for (int8_t x = 4; x >= 0; x--) {
+            bool on = isGlyphCode(code) && ((glyphPattern(code)[y] >> x) & 1);
+            *p++ = on ? '#' : '.';
+        }
+        if (c + 1 < g->width) *p++ = ' ';
+    }
+    *p = '\0';
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_bars_are_the_original_bitmaps(void) {
+    for (uint8_t i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ORIGINAL_BARS[i], glyphPattern(GLYPH_BAR_UP + i), 8);
+    }
+}
+
+void test_cells_use_bars_or_blank(void) {
+    for (const char *s = "0123456789-. "; *s; s++) {
+        const BigGlyph *g = bigFontGlyph(*s);
+        TEST_ASSERT_NOT_NULL(g);
+        TEST_ASSERT_EQUAL(*s, g->ch);
+        for (uint8_t r = 0; r < BIG_FONT_ROWS; r++) {
+            for (uint8_t c = 0; c < g->width; c++) {
+                uint8_t code = g->cells[r][c];
+                TEST_ASSERT_TRUE(code == ' ' || (code >= GLYPH_BAR_UP && code <= GLYPH_COLON));
+            }
+        }
+    }
+}
+
+void test_glyph_pixels(void) {
+    char line[BIG_FONT_MAX_WIDTH * 6 + 1];
+    char msg[32];
+    for (const Art &art : EXPECTED) {
+        const BigGlyph *g = bigFontGlyph(art.ch);
+        TEST_ASSERT_NOT_NULL(g);
+        for (uint8_t l = 0; l < 16; l++) {
+            renderLine(g, l, line);
+            snprintf(msg, sizeof(msg), "'%c' pixel line %u", art.ch, l);
+            TEST_ASSERT_EQUAL_STRING_MESSAGE(art.lines[l], line, msg);
+        }
+    }
+}
+
+void test_widths(void) {
+    TEST_ASSERT_EQUAL_UINT8(3, bigFontGlyph('8')->width);
+    TEST_ASSERT_EQUAL_UINT8(1, bigFontGlyph('.')->width);
+    TEST_ASSERT_EQUAL_UINT8(3 + 3 + 3 + 1 + 3, bigFontWidth("-12.5"));
+    TEST_ASSERT_EQUAL_UINT8(3 + 3, bigFontWidth("4x2")); // No glyph, no columns
+    TEST_ASSERT_NULL(bigFontGlyph('A'));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bars_are_the_original_bitmaps);
+    RUN_TEST(test_cells_use_bars_or_blank);
+    RUN_TEST(test_glyph_pixels);
+    RUN_TEST(test_widths);
+    return UNITY_END();
+}
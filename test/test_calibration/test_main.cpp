@@ -0,0 +1,95 @@
+// CalibrationTable fit and O(1) lookup
+#include <unity.h>
+#include <Arduino.h>
+#include "headers/CalibrationTable.h"
+#include "source/CalibrationTable.cpp"
+
+static CalibrationTable table;
+
+void setUp(void) { table.clear(); }
+void tearDown(void) {}
+
+void test_nothing_to_fit(void) {
+    int32_t counts[] = { 0, 0 };
+    int32_t errorUM[] = { 100, 200 };
+    TEST_ASSERT_FALSE(table.fit(counts, errorUM, 0));
+    TEST_ASSERT_FALSE(table.fit(counts, errorUM, 2)); // Zero distance says nothing
+    TEST_ASSERT_FALSE(table.isActive());
+    TEST_ASSERT_EQUAL_INT32(0, table.correctionUM(50000));
+}
+
+void test_single_reference_is_linear(void) {
+    int32_t counts[] = { 100000 };
+    int32_t errorUM[] = { 500 };
+    TEST_ASSERT_TRUE(table.fit(counts, errorUM, 1));
+    TEST_ASSERT_TRUE(table.isActive());
+
+    TEST_ASSERT_EQUAL_INT32(0, table.correctionUM(0));
+    TEST_ASSERT_INT32_WITHIN(1, 250, table.correctionUM(50000));
+    TEST_ASSERT_INT32_WITHIN(1, 500, table.correctionUM(100000));
+    // Past the longest reference the slope carries on
+    TEST_ASSERT_INT32_WITHIN(2, 1000, table.correctionUM(200000));
+    TEST_ASSERT_INT32_WITHIN(20, 5000, table.correctionUM(1000000));
+}
+
+void test_piecewise_through_references(void) {
+    // Unsorted on purpose: error grows, then turns around
+    int32_t counts[] = { 80000, 40000 };
+    int32_t errorUM[] = { -100, 200 };
+    TEST_ASSERT_TRUE(table.fit(counts, errorUM, 2));
+
+    // Nodes are 8192 counts apart: the kink at 40000 is rounded off a little
+    TEST_ASSERT_INT32_WITHIN(20, 200, table.correctionUM(40000));
+    TEST_ASSERT_INT32_WITHIN(1, -100, table.correctionUM(80000));
+    TEST_ASSERT_INT32_WITHIN(2, 100, table.correctionUM(20000));
+    TEST_ASSERT_INT32_WITHIN(3, 50, table.correctionUM(60000));
+}
+
+void test_odd_symmetric(void) {
+    int32_t counts[] = { 30000, 90000 };
+    int32_t errorUM[] = { 120, 420 };
+    TEST_ASSERT_TRUE(table.fit(counts, errorUM, 2));
+    for (int32_t c = 0; c < 150000; c += 1237) {
+        TEST_ASSERT_EQUAL_INT32(-table.correctionUM(c), table.correctionUM(-c));
+    }
+}
+
+void test_reverse_cut_is_mirrored(void) {
+    // A cut measured in reverse: -counts, -error is the same reference
+    int32_t counts[] = { -100000 };
+    int32_t errorUM[] = { -500 };
+    TEST_ASSERT_TRUE(table.fit(counts, errorUM, 1));
+    TEST_ASSERT_INT32_WITHIN(1, 500, table.correctionUM(100000));
+}
+
+void test_same_distance_is_averaged(void) {
+    int32_t counts[] = { 100000, 100000 };
+    int32_t errorUM[] = { 400, 600 };
+    TEST_ASSERT_TRUE(table.fit(counts, errorUM, 2));
+    TEST_ASSERT_INT32_WITHIN(1, 500, table.correctionUM(100000));
+}
+
+void test_monotone_between_nodes(void) {
+    // A rising error must not step backwards between nodes (integer rounding)
+    int32_t counts[] = { 50000, 120000, 400000 };
+    int32_t errorUM[] = { 300, 900, 2500 };
+    TEST_ASSERT_TRUE(table.fit(counts, errorUM, 3));
+    int32_t last = table.correctionUM(0);
+    for (int32_t c = 1; c < 500000; c += 97) {
+        int32_t y = table.correctionUM(c);
+        TEST_ASSERT_GREATER_OR_EQUAL_INT32(last, y);
+        last = y;
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_to_fit);
+    RUN_TEST(test_single_reference_is_linear);
+    RUN_TEST(test_piecewise_through_references);
+    RUN_TEST(test_odd_symmetric);
+    RUN_TEST(test_reverse_cut_is_mirrored);
+    RUN_TEST(test_same_distance_is_averaged);
+    RUN_TEST(test_monotone_between_nodes);
+    return UNITY_END();
+}
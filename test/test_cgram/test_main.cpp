@@ -0,0 +1,145 @@
+// CgramCache slot allocation, checked pixel for pixel on a model LCD
+#include <unity.h>
+#include <Arduino.h>
+#include "FakeLcd.h"
+#include "headers/CgramCache.h"
+#include "source/CgramCache.cpp"
+#include "source/LcdFrame.cpp"
+#include "source/LcdGlyphs.cpp"
+
+static LcdTransport out(LCD_ADDR);
+static LcdFrame frame;
+static CgramCache cgram;
+
+// One render pass as DisplaySys does it: glyphs first, then the cells
+static void render() {
+    TEST_ASSERT_TRUE(cgram.prepare(&frame, &out));
+    while (frame.isDirty()) {
+        frame.flush(&out, 0x0F, cgram.slotMap());
+        out.drain();
+    }
+    out.drain();
+}
+
+// Every glyph cell shows its pattern, or a space if it got no slot
+static uint8_t assertGlyphsOnGlass() {
+    uint8_t spaces = 0;
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        for (uint8_t c = 0; c < LCD_COLS; c++) {
+            uint8_t code = frame.get(c, r);
+            uint8_t shown = lcdModel.at(c, r);
+            if (!isGlyphCode(code)) {
+                TEST_ASSERT_EQUAL_UINT8(code, shown);
+            } else if (shown == ' ') {
+                spaces++;
+            } else {
+                TEST_ASSERT_LESS_THAN(CGRAM_SLOTS, shown);
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(glyphPattern(code), &lcdModel.cgram[shown * 8], 8);
+            }
+        }
+    }
+    return spaces;
+}
+
+void setUp(void) {
+    lcdModel.reset();
+    out = LcdTransport(LCD_ADDR);
+    frame = LcdFrame();
+    frame.cleared();
+    cgram = CgramCache();
+}
+
+void tearDown(void) {}
+
+void test_uploads_only_referenced_glyphs(void) {
+    frame.put(0, 0, GLYPH_BAR_UP);
+    frame.put(1, 0, GLYPH_BAR_LO);
+    frame.put(2, 1, GLYPH_BAR_UP);
+    frame.write(4, 0, "mm", 2);
+    render();
+    TEST_ASSERT_EQUAL_UINT32(2, cgram.getUploads());
+    TEST_ASSERT_EQUAL_UINT8(0, assertGlyphsOnGlass());
+}
+
+void test_resident_glyphs_are_not_reloaded(void) {
+    frame.put(0, 0, GLYPH_DOT);
+    render();
+    frame.put(5, 2, GLYPH_DOT);
+    frame.put(0, 0, '7');
+    render();
+    TEST_ASSERT_EQUAL_UINT32(1, cgram.getUploads());
+    TEST_ASSERT_EQUAL_UINT8(0, assertGlyphsOnGlass());
+}
+
+void test_screen_change_reuses_unreferenced_slots(void) {
+    // Idle screen: the big-digit bars
+    for (uint8_t g = 0; g < 8; g++) frame.put(g, 0, GLYPH_BAR_UP + g);
+    render();
+    TEST_ASSERT_EQUAL_UINT32(8, cgram.getUploads());
+
+    // Menu: three icons replace the bars
+    frame.fill(0, 0, ' ', 8);
+    frame.put(0, 1, GLYPH_ICON_GEAR);
+    frame.put(0, 2, GLYPH_ICON_BLADE);
+    frame.put(0, 3, GLYPH_ICON_ARROWS);
+    render();
+    TEST_ASSERT_EQUAL_UINT32(11, cgram.getUploads());
+    TEST_ASSERT_EQUAL_UINT8(0, assertGlyphsOnGlass());
+
+    // Back to digits: only the three evicted bars go up again
+    frame.fill(0, 1, ' ', 1);
+    frame.fill(0, 2, ' ', 1);
+    frame.fill(0, 3, ' ', 1);
+    for (uint8_t g = 0; g < 8; g++) frame.put(g, 0, GLYPH_BAR_UP + g);
+    render();
+    TEST_ASSERT_EQUAL_UINT32(14, cgram.getUploads());
+    TEST_ASSERT_EQUAL_UINT8(0, assertGlyphsOnGlass());
+}
+
+void test_ninth_glyph_waits_for_a_slot(void) {
+    for (uint8_t g = 0; g < 9; g++) frame.put(g, 1, GLYPH_BASE + g);
+    render();
+    TEST_ASSERT_EQUAL_UINT32(8, cgram.getUploads());
+    TEST_ASSERT_EQUAL_UINT8(1, assertGlyphsOnGlass()); // Drawn as a space
+
+    // One glyph leaves the screen: the waiting one gets its slot and its cell
+    frame.put(0, 1, 'x');
+    render();
+    TEST_ASSERT_EQUAL_UINT32(9, cgram.getUploads());
+    TEST_ASSERT_EQUAL_UINT8(0, assertGlyphsOnGlass());
+}
+
+void test_full_queue_retries_upload(void) {
+    while (out.room() > 8) out.data(' '); // One short of an upload
+    frame.cursorLost();
+    frame.put(3, 3, GLYPH_COLON);
+    TEST_ASSERT_FALSE(cgram.prepare(&frame, &out));
+    TEST_ASSERT_EQUAL_UINT32(0, cgram.getUploads());
+    out.drain();
+    render();
+    TEST_ASSERT_EQUAL_UINT32(1, cgram.getUploads());
+    TEST_ASSERT_EQUAL_UINT8(0, assertGlyphsOnGlass());
+}
+
+void test_reset_reloads_after_lcd_init(void) {
+    frame.put(0, 0, GLYPH_ICON_STATS);
+    render();
+    lcdModel.reset(); // LCD re-initialised: CGRAM and DDRAM lost
+    cgram.reset();
+    frame.cleared();
+    frame.invalidateAll();
+    render();
+    TEST_ASSERT_EQUAL_UINT32(2, cgram.getUploads());
+    TEST_ASSERT_EQUAL_UINT8(0, assertGlyphsOnGlass());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_uploads_only_referenced_glyphs);
+    RUN_TEST(test_resident_glyphs_are_not_reloaded);
+    RUN_TEST(test_screen_change_reuses_unreferenced_slots);
+    RUN_TEST(test_ninth_glyph_waits_for_a_slot);
+    RUN_TEST(test_full_queue_retries_upload);
+    RUN_TEST(test_reset_reloads_after_lcd_init);
+    return UNITY_END();
+}
@@ -0,0 +1,165 @@
+// EncoderDiag fed the way EncoderSys::sampleISR feeds it, from noisy
+// synthetic feeds through the real MotionEstimator (see PulseTrain.h)
+#include <unity.h>
+#include <Arduino.h>
+#include "PulseTrain.h"
+#include "headers/EncoderDiag.h"
+#include "source/MotionEstimator.cpp"
+#include "source/EncoderDiag.cpp"
+
+// 50 mm wheel, 4096 counts per turn
+static const double COUNTS_PER_MM = 4096.0 / (50.0 * PI);
+static const uint32_t MAX_SPEED = (uint32_t)(DIAG_MAX_SPEED_UMS / 1000.0 * COUNTS_PER_MM);
+static const uint32_t MAX_ACCEL = (uint32_t)(DIAG_MAX_ACCEL_UMS2 / 1000.0 * COUNTS_PER_MM);
+
+struct DiagRig {
+    PulseTrain p;
+    EncoderDiag diag;
+
+    DiagRig() {
+        diag.setLimits(MAX_SPEED, MAX_ACCEL);
+        p.maxLatencyUs = 10;
+        p.onCapture = [this](uint32_t edgeTimeUs, uint8_t edgesPerCapture) {
+            diag.onEdge(edgeTimeUs, edgesPerCapture, p.nowMs());
+        };
+    }
+
+    template <typename VelocityFn>
+    void sample(VelocityFn velocity) {
+        bool estimated = p.sample(velocity);
+        if (estimated) {
+            diag.onEstimate(p.est.getVelocityQ8(), p.est.getEdgeAccel(), p.nowMs());
+        }
+        diag.onSample(p.count, p.est.getVelocityQ8(), SAMPLE_HZ, p.nowMs());
+    }
+
+    template <typename VelocityFn>
+    void run(uint32_t ms, VelocityFn velocity) {
+        for (uint32_t i = 0; i < ms; i++) sample(velocity);
+    }
+
+    uint32_t events() const { return diag.getGlitches() + diag.getSlips() + diag.getChatter(); }
+};
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Hand feed: ramp up over 300 ms, 2 s with a 10 % wobble at 4 Hz, then
+// brake to a stop over 200 ms
+static void checkHandFeed(double mmPerSec) {
+    DiagRig rig;
+    double base = mmPerSec * COUNTS_PER_MM;
+    uint32_t t0 = rig.p.nowUs;
+    auto feed = [base, t0](uint32_t t) {
+        double s = (t - t0) / 1e6;
+        if (s < 0.3) return base * s / 0.3;
+        if (s < 2.3) return base * (1.0 + 0.1 * sin(2 * PI * 4 * (s - 0.3)));
+        if (s < 2.5) return base * (2.5 - s) / 0.2;
+        return 0.0;
+    };
+    rig.diag.startWindow();
+    rig.run(3000, feed);
+
+    TEST_ASSERT_EQUAL_UINT16(0, rig.diag.getGlitches());
+    TEST_ASSERT_EQUAL_UINT16(0, rig.diag.getSlips());
+    TEST_ASSERT_EQUAL_UINT16(0, rig.diag.getChatter());
+    TEST_ASSERT_FALSE(rig.diag.isMeasurementSuspect());
+    TEST_ASSERT_EQUAL_UINT8(100, rig.diag.getHealth());
+}
+
+void test_hand_feed_115(void) { checkHandFeed(115); }
+void test_hand_feed_200(void) { checkHandFeed(200); }
+void test_hand_feed_300(void) { checkHandFeed(300); }
+void test_hand_feed_380(void) { checkHandFeed(380); }
+
+void test_hard_stop_is_not_a_slip(void) {
+    DiagRig rig;
+    double rate = 380 * COUNTS_PER_MM;
+    auto feed = [&rate](uint32_t) { return rate; };
+    rig.run(500, feed);
+    rig.diag.startWindow();
+
+    rate = 0; // Stock hits the fence
+    rig.run(500, feed);
+    TEST_ASSERT_EQUAL_INT32(0, rig.p.est.getVelocityQ8());
+    TEST_ASSERT_EQUAL_UINT16(0, rig.diag.getSlips());
+    TEST_ASSERT_FALSE(rig.diag.isMeasurementSuspect());
+}
+
+void test_skid_is_a_slip(void) {
+    // Stays below the /8 prescaler switch: a skid shows as one edge interval
+    // that suddenly stretches, so coarser captures would blur it
+    DiagRig rig;
+    double rate = 300 * COUNTS_PER_MM;
+    auto feed = [&rate](uint32_t) { return rate; };
+    rig.run(500, feed);
+    rig.diag.startWindow();
+
+    rate = 60 * COUNTS_PER_MM; // Wheel skids, keeps creeping
+    rig.run(400, feed);
+    TEST_ASSERT_EQUAL_UINT16(1, rig.diag.getSlips());
+    TEST_ASSERT_EQUAL_UINT16(0, rig.diag.getGlitches());
+    TEST_ASSERT_TRUE(rig.diag.isMeasurementSuspect());
+}
+
+void test_count_burst_is_a_glitch(void) {
+    DiagRig rig;
+    auto feed = [](uint32_t) { return 150 * COUNTS_PER_MM; };
+    rig.run(500, feed);
+    rig.diag.startWindow();
+
+    rig.p.pos += 600; // Motor noise: 600 counts inside one tick
+    rig.run(5, feed);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, rig.diag.getGlitches());
+    TEST_ASSERT_EQUAL_UINT16(0, rig.diag.getSlips());
+    TEST_ASSERT_TRUE(rig.diag.isMeasurementSuspect());
+}
+
+void test_chatter_keeps_reading(void) {
+    DiagRig rig;
+    auto still = [](uint32_t) { return 0.0; };
+    rig.run(100, still);
+    rig.diag.startWindow();
+
+    // Vibration on an edge: +-1 count every 5 ms
+    for (int i = 0; i < 20; i++) {
+        rig.p.pos += (i & 1) ? -1.0 : 1.0;
+        rig.run(5, still);
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL(1, rig.diag.getChatter());
+    TEST_ASSERT_FALSE(rig.diag.isMeasurementSuspect());
+}
+
+void test_events_counted_once_in_counter_and_window(void) {
+    // First events right after priming, then a burst inside the holdoff:
+    // suspect exactly when a glitch/slip counter moved
+    EncoderDiag diag;
+    diag.setLimits(MAX_SPEED, MAX_ACCEL);
+    diag.onSample(0, 0, SAMPLE_HZ, 1000);   // Primes
+    diag.onSample(5000, 0, SAMPLE_HZ, 1010); // Jump inside what used to be the priming holdoff
+    TEST_ASSERT_EQUAL_UINT16(1, diag.getGlitches());
+    TEST_ASSERT_TRUE(diag.isMeasurementSuspect());
+
+    diag.startWindow();
+    diag.onSample(10000, 0, SAMPLE_HZ, 1020); // Same physical event: merged
+    TEST_ASSERT_EQUAL_UINT16(1, diag.getGlitches());
+    TEST_ASSERT_FALSE(diag.isMeasurementSuspect());
+
+    diag.onSample(15000, 0, SAMPLE_HZ, 1200); // A new one
+    TEST_ASSERT_EQUAL_UINT16(2, diag.getGlitches());
+    TEST_ASSERT_TRUE(diag.isMeasurementSuspect());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_hand_feed_115);
+    RUN_TEST(test_hand_feed_200);
+    RUN_TEST(test_hand_feed_300);
+    RUN_TEST(test_hand_feed_380);
+    RUN_TEST(test_hard_stop_is_not_a_slip);
+    RUN_TEST(test_skid_is_a_slip);
+    RUN_TEST(test_count_burst_is_a_glitch);
+    RUN_TEST(test_chatter_keeps_reading);
+    RUN_TEST(test_events_counted_once_in_counter_and_window);
+    return UNITY_END();
+}
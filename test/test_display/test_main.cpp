@@ -0,0 +1,145 @@
+// DisplaySys screen switches on the HD44780 backend, checked on a model LCD
+#include <unity.h>
+#include <Arduino.h>
+#include "FakeLcd.h"
+#include "headers/DisplaySys.h"
+#include "source/DisplaySys.cpp"
+#include "source/Hd44780Backend.cpp"
+#include "source/CgramCache.cpp"
+#include "source/LcdFrame.cpp"
+#include "source/LcdGlyphs.cpp"
+#include "source/BigFont.cpp"
+#include "source/LineBuf.cpp"
+#include "source/EncoderDiag.cpp"
+
+static DisplaySys display; // One for the whole run: the backend owns a heap LCD object
+static EncoderDiag diag;
+
+// Main loop passes, 1 ms apart
+static void run(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        display.update();
+        hostMillis++;
+        hostMicros += 1000;
+    }
+}
+
+static void assertRow(uint8_t row, const char *text) {
+    for (uint8_t c = 0; c < LCD_COLS; c++) {
+        char want = *text ? *text++ : ' ';
+        TEST_ASSERT_EQUAL_UINT8((uint8_t)want, lcdModel.at(c, row));
+    }
+}
+
+static void showIdle() {
+    display.showIdle(523400, 0, 0.0f, 45, 0, "20x40", 20, false, false);
+}
+
+static void showHidden() {
+    display.showHiddenInfo(3.0f, 25.40f, false, true, &diag, 0);
+}
+
+void setUp(void) {
+    lcdModel.reset();
+    display.init(); // Library init: the one clear the screen ever gets
+    run(100);
+}
+
+void tearDown(void) {}
+
+void test_init_is_the_only_clear(void) {
+    TEST_ASSERT_EQUAL_UINT32(1, lcdModel.clears);
+
+    display.showMenu4("MENU", "Kerf", "Stock", "Back");
+    run(100);
+    showIdle();
+    run(100);
+    display.showError("Encoder fault");
+    run(100);
+    showHidden();
+    run(100);
+    display.showMenu("Kerf", "3.0", true);
+    run(100);
+    showIdle();
+    run(100);
+
+    TEST_ASSERT_EQUAL_UINT32(1, lcdModel.clears);
+}
+
+void test_shorter_screen_blanks_stale_cells(void) {
+    display.showMenu4("ABCDEFGHIJKLMNOPQRST", "ABCDEFGHIJKLMNOPQRST",
+                      "ABCDEFGHIJKLMNOPQRST", "ABCDEFGHIJKLMNOPQRST");
+    run(100);
+    assertRow(3, "ABCDEFGHIJKLMNOPQRST");
+
+    display.showError("E1");
+    run(100);
+    assertRow(0, "ERROR:");
+    assertRow(1, "E1");
+    assertRow(2, "");
+    assertRow(3, "");
+
+    display.showMenu("Kerf", "3.0", true);
+    run(100);
+    assertRow(0, "Kerf");
+    assertRow(1, "> 3.0");
+    TEST_ASSERT_EQUAL_UINT32(1, lcdModel.clears);
+}
+
+void test_idle_to_menu_and_back(void) {
+    showIdle();
+    run(100);
+    assertRow(2, "====================");
+    uint8_t bigCells = 0;
+    for (uint8_t c = 4; c < 18; c++) {
+        if (lcdModel.at(c, 0) != ' ') bigCells++;
+    }
+    TEST_ASSERT_TRUE(bigCells > 0);
+
+    // The big number's glyph cells and the unit label go, no clear needed
+    display.showMenu("Stock", "20x40", false);
+    run(100);
+    assertRow(0, "Stock");
+    assertRow(1, "20x40");
+    assertRow(2, "");
+    assertRow(3, "");
+
+    // And come back in full, unit label included
+    showIdle();
+    run(100);
+    assertRow(2, "====================");
+    TEST_ASSERT_EQUAL_UINT8('C', lcdModel.at(18, 1));
+    TEST_ASSERT_EQUAL_UINT8('M', lcdModel.at(19, 1));
+    TEST_ASSERT_EQUAL_UINT8(' ', lcdModel.at(18, 0));
+    TEST_ASSERT_EQUAL_UINT32(1, lcdModel.clears);
+}
+
+void test_hidden_screen_commands_per_second(void) {
+    // Recomposed on every loop pass, as main.cpp does; let the FPS field settle
+    for (uint16_t i = 0; i < 3000; i++) {
+        showHidden();
+        run(1);
+    }
+    assertRow(1, "Dir:NORM AZ:ON");
+
+    // One second of steady state: at most the FPS digits move. A full repaint
+    // per frame would be 25 x (4 cursor commands + 80 characters).
+    uint32_t commands = lcdModel.commands;
+    uint32_t dataBytes = lcdModel.dataBytes;
+    for (uint16_t i = 0; i < 1000; i++) {
+        showHidden();
+        run(1);
+    }
+    TEST_ASSERT_TRUE(lcdModel.commands - commands <= 2);
+    TEST_ASSERT_TRUE(lcdModel.dataBytes - dataBytes <= 4);
+    TEST_ASSERT_EQUAL_UINT32(1, lcdModel.clears);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_init_is_the_only_clear);
+    RUN_TEST(test_shorter_screen_blanks_stale_cells);
+    RUN_TEST(test_idle_to_menu_and_back);
+    RUN_TEST(test_hidden_screen_commands_per_second);
+    return UNITY_END();
+}
@@ -0,0 +1,135 @@
+// Screens rendered by the host framebuffer backend, checked against golden PGMs
+//
+// The images live in golden/ next to this file. After an intended layout or
+// font change, rerun with UPDATE_GOLDEN=1 in the environment to rewrite them
+// (and look at them before committing). A mismatch leaves <name>.actual.pgm
+// beside the golden image.
+#define DISPLAY_TYPE 2
+#include <unity.h>
+#include <Arduino.h>
+#include <stdio.h>
+#include "headers/DisplaySys.h"
+#include "source/DisplaySys.cpp"
+#include "source/PgmBackend.cpp"
+#include "source/Framebuffer.cpp"
+#include "source/LcdFrame.cpp"
+#include "source/LcdGlyphs.cpp"
+#include "source/BigFont.cpp"
+#include "source/LineBuf.cpp"
+#include "source/EncoderDiag.cpp"
+
+#define PGM_W OLED_WIDTH
+#define PGM_H (OLED_PAGES * 8)
+
+static DisplaySys display;
+
+static void run(DisplaySys &d, uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        d.update();
+        hostMillis++;
+        hostMicros += 1000;
+    }
+}
+
+// golden/<name><suffix> next to this file (no heap: a failed assert longjmps)
+static const char *goldenPath(const char *name, const char *suffix) {
+    static char path[512];
+    const char *file = __FILE__;
+    const char *slash = strrchr(file, '/');
+    int dirLen = slash ? (int)(slash - file) + 1 : 0;
+    snprintf(path, sizeof(path), "%.*sgolden/%s%s", dirLen, file, name, suffix);
+    return path;
+}
+
+// Pixels only; false if the file isn't a 128x64 P5
+static bool readPgm(const char *path, uint8_t pixels[PGM_H][PGM_W]) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    int w = 0, h = 0, maxVal = 0;
+    bool ok = fscanf(f, "P5 %d %d %d", &w, &h, &maxVal) == 3 && fgetc(f) == '\n'
+              && w == PGM_W && h == PGM_H && maxVal == 255
+              && fread(pixels, 1, PGM_W * PGM_H, f) == PGM_W * PGM_H;
+    fclose(f);
+    return ok;
+}
+
+static void assertGolden(const DisplaySys &d, const char *name) {
+    const PgmBackend &glass = d.getBackend();
+    const char *path = goldenPath(name, ".pgm");
+    if (getenv("UPDATE_GOLDEN")) {
+        TEST_ASSERT_TRUE_MESSAGE(glass.writePgm(path), "can't write golden image");
+        return;
+    }
+
+    static uint8_t want[PGM_H][PGM_W];
+    TEST_ASSERT_TRUE_MESSAGE(readPgm(path, want), "golden image missing or not 128x64 P5");
+    for (uint8_t y = 0; y < PGM_H; y++) {
+        for (uint8_t x = 0; x < PGM_W; x++) {
+            if (glass.getPixel(x, y) != want[y][x]) {
+                glass.writePgm(goldenPath(name, ".actual.pgm"));
+                TEST_FAIL_MESSAGE("screen differs from golden image (see .actual.pgm)");
+            }
+        }
+    }
+}
+
+static void showIdle(DisplaySys &d, PositionUM um, bool isInch) {
+    d.showIdle(um, 0, 0.0f, 45, 0, "20x40", 20, isInch, false);
+}
+
+void setUp(void) {
+    hostMillis = 10000;
+    display.init();
+    run(display, 100);
+}
+
+void tearDown(void) {}
+
+void test_idle_screen(void) {
+    showIdle(display, 523400, false); // 523.4 CM
+    run(display, 300);
+    assertGolden(display, "idle");
+}
+
+void test_menu_screen(void) {
+    display.showMenu("Kerf (mm)", "3.0", true);
+    run(display, 100);
+    assertGolden(display, "menu");
+}
+
+void test_big_number_screen(void) {
+    showIdle(display, 12345600, false); // 1234.6 CM shows as 12.3 M
+    run(display, 300);
+    assertGolden(display, "bignum_m");
+}
+
+// Partial updates (dirty windows only) end on the same pixels as a full draw
+void test_partial_updates_match_full_draw(void) {
+    showIdle(display, 523400, false);
+    run(display, 300);
+    display.showMenu("Kerf (mm)", "3.0", true);
+    run(display, 100);
+    showIdle(display, 12345600, false);
+    run(display, 300);
+
+    DisplaySys fresh;
+    fresh.init();
+    showIdle(fresh, 12345600, false);
+    run(fresh, 300);
+
+    for (uint8_t y = 0; y < PGM_H; y++) {
+        for (uint8_t x = 0; x < PGM_W; x++) {
+            TEST_ASSERT_EQUAL_UINT8(fresh.getBackend().getPixel(x, y), display.getBackend().getPixel(x, y));
+        }
+    }
+    assertGolden(display, "bignum_m");
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_screen);
+    RUN_TEST(test_menu_screen);
+    RUN_TEST(test_big_number_screen);
+    RUN_TEST(test_partial_updates_match_full_draw);
+    return UNITY_END();
+}
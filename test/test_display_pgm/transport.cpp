@@ -0,0 +1,3 @@
+// Own unit: LcdFrame links the LCD transport, which keeps its own ROW_ADDR
+#include "FakeLcd.h"
+#include "source/LcdTransport.cpp"
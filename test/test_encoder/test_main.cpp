@@ -0,0 +1,265 @@
+// Encoder timer backends on the fake STM32 timers: the update ISR and the
+// counter racing the seqlock read in readCount, wraps between the reads,
+// and the 16-bit and 32-bit backends agreeing on every position
+#define STM32F4xx
+#include <unity.h>
+#include <Arduino.h>
+#include <stdlib.h>
+#include "headers/EncoderBackend.h"
+
+typedef EncoderTimerBackend<uint16_t, EncoderPinsTIM4> Tim4Backend;
+typedef EncoderTimerBackend<uint32_t, EncoderPinsTIM2> Tim2Backend;
+typedef EncoderTimerBackend<uint32_t, EncoderPinsTIM5> Tim5Backend;
+
+// One instance each for the whole run: init() news its HardwareTimer
+static Tim4Backend enc;
+static Tim2Backend enc2;
+static Tim5Backend enc5;
+static int64_t truth;  // Where the wheel really is
+static int64_t sampled; // Where it was at the last CNT read
+static int64_t origin; // readCount() at the start of the test
+
+// ----------------------------------------------------------------------------
+// Hardware moving under the firmware
+// ----------------------------------------------------------------------------
+// readCount samples SR, CNT, SR in that order. The action planned for read N
+// runs just before read N returns, i.e. between read N-1 and read N.
+enum Action { NONE, STEP, STEP_AND_IRQ };
+static uint8_t readsSeen;
+static uint8_t actionAtRead;
+static Action action;
+static int32_t actionSteps;
+static bool inHook;
+
+static void move(int32_t steps) {
+    hostTimerCount(TIM4, steps);
+    truth += steps;
+}
+
+static void irq() {
+    inHook = true; // The ISR reads CNT too
+    enc.timer()->hostIrq();
+    inHook = false;
+}
+
+static void onRegRead(const HostReg *reg) {
+    if (inHook || (reg != &TIM4->SR && reg != &TIM4->CNT)) return;
+    readsSeen++;
+    if (action != NONE && readsSeen == actionAtRead) {
+        move(actionSteps);
+        if (action == STEP_AND_IRQ) irq();
+        action = NONE; // Once per readCount: the ISR never misses two wraps
+    }
+    if (reg == &TIM4->CNT) sampled = truth;
+}
+
+static void plan(Action a, uint8_t atRead, int32_t steps) {
+    action = a;
+    actionAtRead = atRead;
+    actionSteps = steps;
+    readsSeen = 0;
+}
+
+static int64_t position() {
+    uint32_t ts;
+    return enc.readCount(&ts) - origin;
+}
+
+// Long moves in short hops with the ISR keeping up, as on the chip: the
+// ISR judges the wrap direction from CNT, so it must run near the wrap
+static void travel(int32_t steps) {
+    while (steps != 0) {
+        int32_t hop = (steps > 1000) ? 1000 : (steps < -1000) ? -1000 : steps;
+        move(hop);
+        irq();
+        steps -= hop;
+    }
+}
+
+// The read must give the position at its (last) CNT sample, whatever moved
+// around it; with nothing planned that is the current position
+static void expectPosition() {
+    sampled = truth;
+    int64_t got = position();
+    TEST_ASSERT_EQUAL_INT64(sampled, got);
+}
+
+// Put the counter `before` counts short of the 0xFFFF -> 0 wrap
+static void parkBeforeWrap(uint16_t before) {
+    travel((int32_t)(uint16_t)(0xFFFF - TIM4->CNT.value - before));
+}
+
+void setUp(void) {
+    hostRegRead = nullptr;
+    action = NONE;
+    origin = 0;
+    truth = 0;
+    irq(); // Nothing left pending from the previous test
+    origin = position();
+    hostRegRead = onRegRead;
+}
+
+void tearDown(void) {
+    hostRegRead = nullptr;
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void test_wraps_counted_by_isr_both_ways(void) {
+    parkBeforeWrap(2);
+    move(5);
+    irq();
+    expectPosition();
+    move(-10);
+    irq();
+    expectPosition();
+    travel(-200000); // Several wraps
+    expectPosition();
+    travel(150000);
+    expectPosition();
+}
+
+void test_wrap_between_flag_and_counter_read(void) {
+    // 0xFFFF -> 0 after the first SR read: UIF was clear, CNT already 0
+    parkBeforeWrap(0);
+    plan(STEP, 2, 1);
+    expectPosition();
+    TEST_ASSERT_TRUE(readsSeen > 3); // Retried
+    irq();
+    expectPosition();
+}
+
+void test_wrap_between_counter_and_second_flag_read(void) {
+    // CNT read 0xFFFF, then the wrap sets UIF before the second SR read
+    parkBeforeWrap(0);
+    plan(STEP, 3, 1);
+    expectPosition();
+    TEST_ASSERT_TRUE(readsSeen > 3); // Retried
+    irq();
+    expectPosition();
+}
+
+void test_isr_runs_between_reads(void) {
+    // Wrap and its ISR both land mid-read: the wrap count moved, retry
+    parkBeforeWrap(0);
+    plan(STEP_AND_IRQ, 2, 1);
+    expectPosition();
+    TEST_ASSERT_TRUE(readsSeen > 3);
+    parkBeforeWrap(0);
+    plan(STEP_AND_IRQ, 3, 1);
+    expectPosition();
+    TEST_ASSERT_TRUE(readsSeen > 3);
+}
+
+void test_underflow_between_reads(void) {
+    // 0 -> 0xFFFF going backwards, at each point in the read
+    for (uint8_t at = 1; at <= 3; at++) {
+        parkBeforeWrap(0);
+        move(1);
+        irq(); // Now at 0
+        plan(STEP, at, -1);
+        expectPosition();
+        irq();
+        expectPosition();
+    }
+}
+
+void test_pending_wrap_with_irq_blocked(void) {
+    // Called from an ISR that blocks the update IRQ: UIF stays set, the read
+    // itself accounts for the wrap the ISR has not counted yet
+    parkBeforeWrap(3);
+    move(10);
+    TEST_ASSERT_TRUE(TIM4->SR.value & TIM_SR_UIF);
+    expectPosition();
+    irq();
+    expectPosition();
+
+    move(-10);
+    TEST_ASSERT_TRUE(TIM4->SR.value & TIM_SR_UIF);
+    expectPosition();
+    irq();
+    expectPosition();
+}
+
+void test_timestamp_taken_with_the_sample(void) {
+    hostMicros = 1234;
+    uint32_t ts = 0;
+    enc.readCount(&ts);
+    TEST_ASSERT_EQUAL_UINT32(1234, ts);
+}
+
+void test_random_races_around_the_wrap(void) {
+    srand(7);
+    parkBeforeWrap(4);
+    for (int i = 0; i < 20000; i++) {
+        // Wander within a few counts of the wrap, in and out of it
+        move((rand() % 9) - 4);
+        irq();
+        Action a = (Action)(rand() % 3);
+        int32_t steps = (rand() % 7) - 3;
+        plan(a, (uint8_t)(1 + rand() % 3), steps == 0 ? 1 : steps);
+        int64_t got = position();
+        if (got != sampled) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "iteration %d", i);
+            TEST_FAIL_MESSAGE(msg);
+        }
+        irq();
+    }
+}
+
+void test_16_and_32_bit_backends_agree(void) {
+    // Same wheel on all three timers: a walk through several 16-bit wraps
+    // and below zero, read back through each backend
+    uint32_t ts;
+    int64_t origin2 = enc2.readCount(&ts);
+    int64_t origin5 = enc5.readCount(&ts);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, TIM2->ARR.value);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, TIM5->ARR.value);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFF, TIM4->ARR.value);
+
+    srand(11);
+    int32_t steps = 0;
+    int32_t lowest = 0;
+    for (int i = 0; i < 4000; i++) {
+        // Drift down first, then up: ends well past +/- several wraps
+        int32_t step = (rand() % 2001) - ((i < 2000) ? 1100 : 850);
+        travel(step);
+        hostTimerCount(TIM2, step);
+        hostTimerCount(TIM5, step);
+        steps += step;
+        if (steps < lowest) lowest = steps;
+
+        int64_t p4 = position();
+        int64_t p2 = enc2.readCount(&ts) - origin2;
+        int64_t p5 = enc5.readCount(&ts) - origin5;
+        if (p4 != steps || p2 != steps || p5 != steps) {
+            char msg[96];
+            snprintf(msg, sizeof(msg), "step %d: TIM4 %lld TIM2 %lld TIM5 %lld, moved %ld",
+                     i, (long long)p4, (long long)p2, (long long)p5, (long)steps);
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+    TEST_ASSERT_TRUE(lowest < -2 * 65536); // Negative on the 32-bit timers
+    TEST_ASSERT_TRUE(steps > 65536);
+}
+
+int main(int argc, char **argv) {
+    enc.init(0);
+    enc2.init(0);
+    enc5.init(0);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_wraps_counted_by_isr_both_ways);
+    RUN_TEST(test_wrap_between_flag_and_counter_read);
+    RUN_TEST(test_wrap_between_counter_and_second_flag_read);
+    RUN_TEST(test_isr_runs_between_reads);
+    RUN_TEST(test_underflow_between_reads);
+    RUN_TEST(test_pending_wrap_with_irq_blocked);
+    RUN_TEST(test_timestamp_taken_with_the_sample);
+    RUN_TEST(test_random_races_around_the_wrap);
+    RUN_TEST(test_16_and_32_bit_backends_agree);
+    return UNITY_END();
+}
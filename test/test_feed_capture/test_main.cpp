@@ -0,0 +1,234 @@
+// Feed capture ring on the fake TIM1 pacer and DMA stream: ring wrap,
+// overrun skipping, drain batch boundaries and pacer-period timestamps
+#define STM32F4xx
+#include <unity.h>
+#include <Arduino.h>
+#include "headers/FeedCapture.h"
+
+#define RING 16
+
+// One of each for the run: start() news the pacer on first use
+static FeedCaptureRing<uint16_t, RING> ring16;
+static FeedCaptureRing<uint32_t, RING> ring32;
+
+// What the encoder counter held at each DMA request
+#define MAX_WRITES 200000
+static int64_t written[MAX_WRITES];
+static uint32_t writes;
+static int64_t truth;
+
+static TIM_TypeDef *encTim;
+
+// One pacer update: the wheel moves `delta`, then DMA copies CNT
+static void sample(int32_t delta) {
+    hostTimerCount(encTim, delta);
+    truth += delta;
+    written[writes++] = truth;
+    hostDmaRequest(DMA2_Stream5);
+}
+
+// `n` samples with the 1 kHz tick polling every `pollEvery` of them
+template <typename Ring>
+static void run(Ring &ring, uint32_t n, int32_t delta, uint32_t pollEvery = 1) {
+    for (uint32_t i = 0; i < n; i++) {
+        sample(delta);
+        if ((i + 1) % pollEvery == 0) ring.poll();
+    }
+}
+
+template <typename Ring>
+static void begin(Ring &ring, TIM_TypeDef *tim, uint32_t hz) {
+    encTim = tim;
+    TEST_ASSERT_TRUE(ring.start(tim, hz, truth));
+}
+
+static void expectCounts(const FeedSample *out, uint32_t firstWrite, uint16_t n) {
+    for (uint16_t i = 0; i < n; i++) {
+        if (out[i].count != written[firstWrite + i]) {
+            char msg[80];
+            snprintf(msg, sizeof(msg), "sample %lu: got %lld, counter was %lld", (unsigned long)(firstWrite + i),
+                     (long long)out[i].count, (long long)written[firstWrite + i]);
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+}
+
+void setUp(void) {
+    TIM4->ARR = 0xFFFF;
+    TIM4->CNT = 0;
+    TIM2->ARR = 0xFFFFFFFF;
+    TIM2->CNT = 0;
+    writes = 0;
+    truth = 0;
+    hostMicros = 5000;
+}
+
+void tearDown(void) {
+    ring16.stop();
+    ring32.stop();
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void test_reads_across_the_ring_end(void) {
+    begin(ring16, TIM4, 10000);
+    FeedSample out[RING];
+
+    // Drain in fives: reads straddle the end of the ring on every lap
+    uint32_t read = 0;
+    for (int lap = 0; lap < 10; lap++) {
+        run(ring16, 5, 3);
+        TEST_ASSERT_EQUAL_UINT16(5, ring16.available());
+        TEST_ASSERT_EQUAL_UINT16(5, ring16.drain(out, RING));
+        expectCounts(out, read, 5);
+        read += 5;
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ring16.getOverruns());
+
+    // Peek stops at the ring end, the rest follows from the start
+    run(ring16, 10, 3);
+    TEST_ASSERT_EQUAL_UINT16(10, ring16.drain(out, RING));
+    read += 10; // Read index now 4 short of the end
+    run(ring16, 10, -2);
+    uint16_t n;
+    const volatile uint16_t *raw = ring16.peek(&n);
+    uint16_t first = RING - (read % RING);
+    TEST_ASSERT_EQUAL_UINT16(4, first);
+    TEST_ASSERT_EQUAL_UINT16(first, n);
+    TEST_ASSERT_EQUAL_UINT16((uint16_t)written[read], raw[0]);
+    ring16.consume(n);
+    read += n;
+    raw = ring16.peek(&n);
+    TEST_ASSERT_EQUAL_UINT16(10 - first, n);
+    TEST_ASSERT_EQUAL_UINT16((uint16_t)written[read], raw[0]);
+    ring16.consume(n);
+    TEST_ASSERT_EQUAL_UINT16(0, ring16.available());
+}
+
+void test_wrap_not_yet_polled(void) {
+    // DMA reloads between two ticks: the write total still sees the lap
+    begin(ring16, TIM4, 10000);
+    run(ring16, RING - 2, 1);
+    FeedSample out[RING];
+    TEST_ASSERT_EQUAL_UINT16(RING - 2, ring16.drain(out, RING));
+    run(ring16, 6, 1, 1000); // No poll: NDTR went 2 -> reload -> 12
+    TEST_ASSERT_EQUAL_UINT16(6, ring16.drain(out, RING));
+    expectCounts(out, RING - 2, 6);
+}
+
+void test_counter_wraps_unwrapped_in_order(void) {
+    // 16-bit counter wrapping both ways under the ring
+    begin(ring16, TIM4, 10000);
+    FeedSample out[RING];
+    uint32_t read = 0;
+    for (int i = 0; i < 200; i++) {
+        run(ring16, 8, (i < 100) ? 3000 : -3000);
+        uint16_t n = ring16.drain(out, RING);
+        expectCounts(out, read, n);
+        read += n;
+    }
+    TEST_ASSERT_EQUAL_UINT32(1600, read);
+    TEST_ASSERT_TRUE(written[799] > 4 * 65536);
+}
+
+void test_32_bit_counter_below_zero(void) {
+    begin(ring32, TIM2, 10000);
+    FeedSample out[RING];
+    run(ring32, 12, -700);
+    TEST_ASSERT_EQUAL_UINT16(12, ring32.drain(out, RING));
+    expectCounts(out, 0, 12);
+    TEST_ASSERT_EQUAL_INT64(-8400, out[11].count);
+}
+
+void test_overrun_skips_oldest_and_counts(void) {
+    // Nobody drains for three laps: the newest RING - 1 survive
+    begin(ring16, TIM4, 10000);
+    run(ring16, 3 * RING, 500);
+    TEST_ASSERT_EQUAL_UINT16(RING - 1, ring16.available());
+    TEST_ASSERT_EQUAL_UINT32(2 * RING + 1, ring16.getOverruns());
+
+    // Counts carry on from the oldest survivor (the gap is under half the
+    // 16-bit range), timestamps keep their place in the sequence
+    FeedSample out[RING];
+    TEST_ASSERT_EQUAL_UINT16(RING - 1, ring16.drain(out, RING));
+    expectCounts(out, 2 * RING + 1, RING - 1);
+    TEST_ASSERT_EQUAL_UINT32(5000 + 100 + (2 * RING + 1) * 100, out[0].timestampUs);
+
+    // And the ring runs on normally afterwards
+    run(ring16, 4, 500);
+    TEST_ASSERT_EQUAL_UINT16(4, ring16.drain(out, RING));
+    expectCounts(out, 3 * RING, 4);
+    TEST_ASSERT_EQUAL_UINT32(2 * RING + 1, ring16.getOverruns());
+}
+
+void test_batch_boundaries(void) {
+    // Batches of 7 out of a ring of 16: the split points never line up with
+    // the ring end, timestamps run on across batches
+    begin(ring16, TIM4, 3000);
+    FeedSample out[7];
+    uint32_t read = 0;
+    for (int i = 0; i < 100; i++) {
+        run(ring16, 5 + (i % 6), 1); // 5..10 per tick
+        uint16_t n;
+        while ((n = ring16.drain(out, 7)) > 0) {
+            TEST_ASSERT_TRUE(n <= 7);
+            expectCounts(out, read, n);
+            for (uint16_t j = 0; j < n; j++) {
+                uint64_t k = read + j;
+                uint32_t want = 5000 + 333 + (uint32_t)(k * 33333 / 100);
+                TEST_ASSERT_EQUAL_UINT32(want, out[j].timestampUs);
+            }
+            read += n;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(writes, read);
+    TEST_ASSERT_EQUAL_UINT16(0, ring16.drain(out, 0));
+}
+
+// Timestamps against the pacer's real period, (PSC+1)(ARR+1) / clock
+static void checkPacer(uint32_t hz, uint32_t samples) {
+    begin(ring16, TIM4, hz);
+    uint64_t cycles = (uint64_t)(TIM1->PSC.value + 1) * (TIM1->ARR.value + 1);
+    uint32_t t0 = 5000 + (uint32_t)(cycles / 100);
+    TEST_ASSERT_EQUAL_UINT32(cycles / 100, ring16.getPeriodUs());
+
+    FeedSample out[RING];
+    uint32_t read = 0;
+    while (read < samples) {
+        run(ring16, RING / 2, 1);
+        uint16_t n = ring16.drain(out, RING);
+        for (uint16_t j = 0; j < n; j++) {
+            uint64_t k = read + j;
+            uint32_t want = t0 + (uint32_t)(k * cycles / 100); // 100 cycles per us
+            if (out[j].timestampUs != want) {
+                char msg[80];
+                snprintf(msg, sizeof(msg), "%lu Hz sample %lu: got %lu, want %lu", (unsigned long)hz,
+                         (unsigned long)k, (unsigned long)out[j].timestampUs, (unsigned long)want);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+        read += n;
+    }
+    ring16.stop();
+}
+
+void test_timestamps_follow_the_pacer(void) {
+    checkPacer(10000, 1000);   // Divides the clock: 100 us flat
+    checkPacer(3000, 100000);  // 33333 cycles: 333.33 us, not 333
+    checkPacer(1000, 1000);    // Prescaled: PSC 1, ARR 49999
+    checkPacer(7, 2000);       // PSC 217, ARR 65529: 142855.40 us, not 1/7 s
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_reads_across_the_ring_end);
+    RUN_TEST(test_wrap_not_yet_polled);
+    RUN_TEST(test_counter_wraps_unwrapped_in_order);
+    RUN_TEST(test_32_bit_counter_below_zero);
+    RUN_TEST(test_overrun_skips_oldest_and_counts);
+    RUN_TEST(test_batch_boundaries);
+    RUN_TEST(test_timestamps_follow_the_pacer);
+    return UNITY_END();
+}
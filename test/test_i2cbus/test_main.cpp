@@ -0,0 +1,188 @@
+// I2CBus arbitration (pass budget, aging) and stuck-SDA recovery, on the
+// host Wire and GPIO stand-ins
+#include <unity.h>
+#include <Arduino.h>
+#include "headers/I2CBus.h"
+#include "source/I2CBus.cpp"
+
+// ACKs everything at one address
+struct AckSlave : HostI2cSlave {
+    AckSlave() : HostI2cSlave(LCD_ADDR) {}
+    void onWrite(const uint8_t *data, uint8_t n, bool stop) override {}
+    uint8_t onRead(uint8_t *data, uint8_t n) override {
+        memset(data, 0, n);
+        return n;
+    }
+};
+
+static AckSlave slave;
+static uint8_t payload[32];
+
+// A slave stuck mid-byte: holds SDA until it has seen this many SCL clocks
+static int16_t releaseAfterClocks;
+static uint16_t sclClocks;
+static uint16_t stops;
+static uint8_t lastScl;
+static uint8_t lastSda;
+
+static void watchLines(uint32_t pin) {
+    uint8_t scl = digitalRead(PIN_I2C_SCL);
+    if (scl && !lastScl) {
+        sclClocks++;
+        if (hostPinHeldLow[PIN_I2C_SDA] && releaseAfterClocks >= 0 && sclClocks >= releaseAfterClocks) {
+            hostPinHeldLow[PIN_I2C_SDA] = false;
+        }
+    }
+    uint8_t sda = digitalRead(PIN_I2C_SDA);
+    if (sda && !lastSda && scl && lastScl) stops++; // SDA rises while SCL is high
+    lastScl = scl;
+    lastSda = sda;
+}
+
+static void stickSda(int16_t clocks) {
+    hostPinHeldLow[PIN_I2C_SDA] = true;
+    releaseAfterClocks = clocks;
+    sclClocks = 0;
+    stops = 0;
+    lastScl = digitalRead(PIN_I2C_SCL);
+    lastSda = digitalRead(PIN_I2C_SDA);
+}
+
+void setUp(void) {
+    i2cBus = I2CBus();
+    Wire = TwoWire();
+    hostI2cSlave = &slave;
+    hostI2cFailures = 0;
+    hostMillis = 1000;
+    memset(hostPinHeldLow, 0, sizeof(hostPinHeldLow));
+    hostPinLevel[PIN_I2C_SCL] = HIGH;
+    hostPinLevel[PIN_I2C_SDA] = HIGH;
+    hostPinChanged = watchLines;
+    lastScl = HIGH;
+    lastSda = HIGH;
+    sclClocks = 0;
+    stops = 0;
+    i2cBus.begin();
+    i2cBus.startPass();
+}
+
+void tearDown(void) {
+    hostPinChanged = nullptr;
+}
+
+void test_angle_always_granted(void) {
+    i2cBus.write(I2C_CLIENT_LCD, LCD_ADDR, payload, I2C_PASS_BUDGET_BYTES);
+    TEST_ASSERT_EQUAL_UINT16(0, i2cBus.grant(I2C_CLIENT_LCD, 8));
+    TEST_ASSERT_EQUAL_UINT16(2, i2cBus.grant(I2C_CLIENT_ANGLE, 2));
+}
+
+void test_pass_budget_shared_in_order(void) {
+    TEST_ASSERT_EQUAL_UINT16(I2C_PASS_BUDGET_BYTES, i2cBus.grant(I2C_CLIENT_LCD, 200));
+    TEST_ASSERT_EQUAL_UINT16(8, i2cBus.grant(I2C_CLIENT_LCD, 8));
+
+    // Transactions spend the budget, address byte included
+    TEST_ASSERT_TRUE(i2cBus.write(I2C_CLIENT_LCD, LCD_ADDR, payload, 9));
+    TEST_ASSERT_EQUAL_UINT16(I2C_PASS_BUDGET_BYTES - 10, i2cBus.grant(I2C_CLIENT_EEPROM, 200));
+    i2cBus.write(I2C_CLIENT_LCD, LCD_ADDR, payload, I2C_PASS_BUDGET_BYTES - 10);
+    TEST_ASSERT_EQUAL_UINT16(0, i2cBus.grant(I2C_CLIENT_EEPROM, 1));
+
+    i2cBus.startPass();
+    TEST_ASSERT_EQUAL_UINT16(4, i2cBus.grant(I2C_CLIENT_EEPROM, 4));
+}
+
+void test_aged_client_goes_first(void) {
+    // The display uses every pass in full; the EEPROM is denied each time
+    for (uint8_t pass = 0; pass < I2C_AGING_PASSES; pass++) {
+        i2cBus.startPass();
+        uint16_t n = i2cBus.grant(I2C_CLIENT_LCD, I2C_PASS_BUDGET_BYTES - 1);
+        TEST_ASSERT_EQUAL_UINT16(I2C_PASS_BUDGET_BYTES - 1, n);
+        i2cBus.write(I2C_CLIENT_LCD, LCD_ADDR, payload, n);
+        TEST_ASSERT_EQUAL_UINT16(0, i2cBus.grant(I2C_CLIENT_EEPROM, 16));
+        hostMillis += 2;
+    }
+
+    // Next pass the display yields and the EEPROM gets the bus
+    i2cBus.startPass();
+    TEST_ASSERT_EQUAL_UINT16(0, i2cBus.grant(I2C_CLIENT_LCD, 8));
+    TEST_ASSERT_EQUAL_UINT16(16, i2cBus.grant(I2C_CLIENT_EEPROM, 16));
+    TEST_ASSERT_EQUAL_UINT32(2 * I2C_AGING_PASSES, i2cBus.getMaxWaitMs(I2C_CLIENT_EEPROM));
+
+    // Served: the display is back to normal on the following pass
+    i2cBus.write(I2C_CLIENT_EEPROM, LCD_ADDR, payload, 16);
+    i2cBus.startPass();
+    TEST_ASSERT_EQUAL_UINT16(8, i2cBus.grant(I2C_CLIENT_LCD, 8));
+}
+
+void test_errors_without_stuck_bus_dont_recover(void) {
+    hostI2cFailures = 2 * I2C_RECOVER_AFTER;
+    for (uint8_t i = 0; i < 2 * I2C_RECOVER_AFTER; i++) {
+        TEST_ASSERT_FALSE(i2cBus.write(I2C_CLIENT_LCD, LCD_ADDR, payload, 4));
+    }
+    TEST_ASSERT_EQUAL_UINT32(2 * I2C_RECOVER_AFTER, i2cBus.getErrors(I2C_CLIENT_LCD));
+    TEST_ASSERT_EQUAL_UINT16(0, i2cBus.getRecoveries());
+    TEST_ASSERT_EQUAL_UINT16(0, Wire.ends);
+}
+
+void test_stuck_sda_clocked_free_after_failures(void) {
+    stickSda(5);
+    hostI2cFailures = I2C_RECOVER_AFTER;
+    for (uint8_t i = 0; i < I2C_RECOVER_AFTER - 1; i++) {
+        TEST_ASSERT_FALSE(i2cBus.write(I2C_CLIENT_LCD, LCD_ADDR, payload, 4));
+        TEST_ASSERT_EQUAL_UINT16(0, i2cBus.getRecoveries());
+    }
+    TEST_ASSERT_FALSE(i2cBus.write(I2C_CLIENT_LCD, LCD_ADDR, payload, 4));
+
+    TEST_ASSERT_EQUAL_UINT16(1, i2cBus.getRecoveries());
+    TEST_ASSERT_EQUAL_UINT16(5 + 1, sclClocks); // Until SDA let go, then the STOP's SCL rise
+    TEST_ASSERT_EQUAL_UINT16(1, stops);
+    TEST_ASSERT_EQUAL_UINT8(HIGH, digitalRead(PIN_I2C_SDA));
+    TEST_ASSERT_EQUAL_UINT16(1, Wire.ends);
+    TEST_ASSERT_EQUAL_UINT16(2, Wire.begins); // begin() and the restart
+    TEST_ASSERT_EQUAL_UINT32(I2C_CLOCK_HZ, Wire.clockHz);
+
+    // The bus works again
+    TEST_ASSERT_TRUE(i2cBus.write(I2C_CLIENT_LCD, LCD_ADDR, payload, 4));
+}
+
+void test_recovery_gives_at_most_nine_clocks(void) {
+    // A worst-case byte needs all nine
+    stickSda(9);
+    hostI2cFailures = I2C_RECOVER_AFTER;
+    for (uint8_t i = 0; i < I2C_RECOVER_AFTER; i++) {
+        i2cBus.write(I2C_CLIENT_LCD, LCD_ADDR, payload, 4);
+    }
+    TEST_ASSERT_EQUAL_UINT16(9 + 1, sclClocks);
+    TEST_ASSERT_EQUAL_UINT16(1, stops);
+
+    // A dead slave never lets go: still nine, and no STOP is possible
+    stickSda(-1);
+    hostI2cFailures = I2C_RECOVER_AFTER;
+    for (uint8_t i = 0; i < I2C_RECOVER_AFTER; i++) {
+        i2cBus.write(I2C_CLIENT_LCD, LCD_ADDR, payload, 4);
+    }
+    TEST_ASSERT_EQUAL_UINT16(2, i2cBus.getRecoveries());
+    TEST_ASSERT_EQUAL_UINT16(9 + 1, sclClocks);
+    TEST_ASSERT_EQUAL_UINT16(0, stops);
+}
+
+void test_stuck_at_boot_recovered_by_begin(void) {
+    i2cBus = I2CBus();
+    Wire = TwoWire();
+    stickSda(3);
+    i2cBus.begin();
+    TEST_ASSERT_EQUAL_UINT16(1, i2cBus.getRecoveries());
+    TEST_ASSERT_EQUAL_UINT16(3 + 1, sclClocks);
+    TEST_ASSERT_EQUAL_UINT16(1, Wire.begins); // Started once, by the recovery
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_angle_always_granted);
+    RUN_TEST(test_pass_budget_shared_in_order);
+    RUN_TEST(test_aged_client_goes_first);
+    RUN_TEST(test_errors_without_stuck_bus_dont_recover);
+    RUN_TEST(test_stuck_sda_clocked_free_after_failures);
+    RUN_TEST(test_recovery_gives_at_most_nine_clocks);
+    RUN_TEST(test_stuck_at_boot_recovered_by_begin);
+    return UNITY_END();
+}
@@ -0,0 +1,114 @@
+// Menu knob decoding: the quadrature transition table and whole detents
+// through the tick ISR, with the pins driven by the test
+#include <unity.h>
+#include <Arduino.h>
+#include <vector>
+#include "headers/UserInput.h"
+#include "source/UserInput.cpp"
+
+// Pin state as the decoder indexes it: (DT << 1) | CLK. KY-040 rests at 3.
+// Clockwise walks 3 -> 1 -> 0 -> 2 -> 3, one bit at a time.
+static const uint8_t CW_ORDER[4] = { 3, 1, 0, 2 };
+
+static void setPins(uint8_t state) {
+    hostPinLevel[PIN_MENU_CLK] = state & 0x01;
+    hostPinLevel[PIN_MENU_DT] = (state >> 1) & 0x01;
+}
+
+// One tick per pin state, 1 ms apart
+static std::vector<InputRecord> feed(UserInput &in, const std::vector<uint8_t> &states) {
+    std::vector<InputRecord> out;
+    for (uint8_t s : states) {
+        setPins(s);
+        hostMillis++;
+        in.isrTick();
+        InputRecord r;
+        while (in.pollEvent(&r)) out.push_back(r);
+    }
+    return out;
+}
+
+void setUp(void) {
+    hostMillis = 1000;
+    setPins(3);
+    hostPinLevel[PIN_MENU_SW] = HIGH; // Button released
+}
+
+void tearDown(void) {}
+
+// Every (last, now) pair against the Gray-code order: one step forward is +1,
+// one back is -1, no change or both bits at once is 0
+void test_transition_table(void) {
+    for (uint8_t last = 0; last < 4; last++) {
+        for (uint8_t now = 0; now < 4; now++) {
+            uint8_t i = 0;
+            while (CW_ORDER[i] != last) i++;
+            int8_t want = 0;
+            if (now == CW_ORDER[(i + 1) & 3]) want = 1;
+            else if (now == CW_ORDER[(i + 3) & 3]) want = -1;
+            TEST_ASSERT_EQUAL_INT8(want, KNOB_TRANSITIONS[(last << 2) | now]);
+        }
+    }
+}
+
+struct KnobCase {
+    const char *name;
+    std::vector<uint8_t> states;       // Pin states after the rest state 3
+    std::vector<InputEvent> events;    // Raw events queued, in order
+};
+
+void test_detent_sequences(void) {
+    const KnobCase cases[] = {
+        { "one detent forward", { 1, 0, 2, 3 }, { EVENT_CW } },
+        { "one detent back", { 2, 0, 1, 3 }, { EVENT_CCW } },
+        { "two detents forward", { 1, 0, 2, 3, 1, 0, 2, 3 }, { EVENT_CW, EVENT_CW } },
+        { "forward then back", { 1, 0, 2, 3, 2, 0, 1, 3 }, { EVENT_CW, EVENT_CCW } },
+        { "contact bounce on the first edge", { 1, 3, 1, 3, 1, 0, 2, 3 }, { EVENT_CW } },
+        { "bounce on every edge", { 1, 3, 1, 0, 1, 0, 2, 0, 2, 3 }, { EVENT_CW } },
+        { "half a detent and back", { 1, 0, 1, 3 }, {} },
+        { "three quarters is not a detent", { 1, 0, 2 }, {} },
+        { "illegal double-bit jump", { 0, 3 }, {} },
+        { "double-bit jump mid detent", { 1, 2, 3 }, {} },
+        { "no change", { 3, 3, 3 }, {} },
+    };
+
+    for (const KnobCase &c : cases) {
+        UserInput in;
+        setPins(3);
+        in.init();
+        std::vector<InputRecord> got = feed(in, c.states);
+
+        TEST_ASSERT_EQUAL_MESSAGE(c.events.size(), got.size(), c.name);
+        for (size_t i = 0; i < got.size(); i++) {
+            TEST_ASSERT_EQUAL_MESSAGE(c.events[i], got[i].event, c.name);
+        }
+        TEST_ASSERT_EQUAL_UINT32(0, in.getOverflowCount());
+    }
+}
+
+// A jump that skips a state counts nothing rather than a guessed direction:
+// the next full cycle is one detent, not two
+void test_skipped_state_nets_out(void) {
+    UserInput in;
+    in.init();
+    std::vector<InputRecord> got = feed(in, { 1, 2, 3, 1, 0, 2, 3 });
+    TEST_ASSERT_EQUAL(1, got.size());
+    TEST_ASSERT_EQUAL(EVENT_CW, got[0].event);
+}
+
+void test_events_carry_tick_time(void) {
+    UserInput in;
+    in.init();
+    std::vector<InputRecord> got = feed(in, { 1, 0, 2, 3 });
+    TEST_ASSERT_EQUAL(1, got.size());
+    TEST_ASSERT_EQUAL_UINT32(1004, got[0].timeMs); // The tick that saw the last edge
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_transition_table);
+    RUN_TEST(test_detent_sequences);
+    RUN_TEST(test_skipped_state_nets_out);
+    RUN_TEST(test_events_carry_tick_time);
+    return UNITY_END();
+}
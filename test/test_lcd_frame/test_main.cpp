@@ -0,0 +1,204 @@
+// LcdFrame diffing and cursor economy, checked against a model LCD
+#include <unity.h>
+#include <Arduino.h>
+#include "FakeLcd.h"
+#include "headers/LcdFrame.h"
+#include "source/LcdFrame.cpp"
+#include "source/LcdGlyphs.cpp"
+
+static LcdTransport out(LCD_ADDR);
+static LcdFrame frame;
+static uint8_t glyphMap[GLYPH_COUNT];
+
+// Flushes the rows in rowMask until nothing more goes out; LCD bytes queued
+static uint16_t show(uint8_t rowMask = 0x0F) {
+    uint16_t bytes = 0;
+    uint16_t n;
+    do {
+        n = frame.flush(&out, rowMask, glyphMap);
+        bytes += n;
+        out.drain();
+    } while (n > 0);
+    return bytes;
+}
+
+static void assertScreenMatchesFrame() {
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        for (uint8_t c = 0; c < LCD_COLS; c++) {
+            uint8_t want = frame.get(c, r);
+            if (isGlyphCode(want)) want = glyphMap[want - GLYPH_BASE];
+            TEST_ASSERT_EQUAL_UINT8(want, lcdModel.at(c, r));
+        }
+    }
+}
+
+void setUp(void) {
+    lcdModel.reset();
+    out = LcdTransport(LCD_ADDR);
+    frame = LcdFrame();
+    frame.cleared(); // Same as the model: blank, cursor home
+    for (uint8_t g = 0; g < GLYPH_COUNT; g++) glyphMap[g] = g & 7;
+}
+
+void tearDown(void) {}
+
+void test_cleared_frame_sends_nothing(void) {
+    TEST_ASSERT_FALSE(frame.isDirty());
+    TEST_ASSERT_EQUAL_UINT16(0, show());
+}
+
+void test_unknown_screen_goes_out_in_one_run(void) {
+    frame = LcdFrame(); // Nothing known about the glass
+    frame.write(0, 0, "Row zero", 20);
+    frame.write(0, 3, "Row three", 20);
+    // DDRAM order 0 -> 2 -> 1 -> 3 is contiguous: one cursor move for 80 cells
+    TEST_ASSERT_EQUAL_UINT16(81, show());
+    TEST_ASSERT_EQUAL_UINT32(1, lcdModel.commands);
+    TEST_ASSERT_EQUAL_UINT32(80, lcdModel.dataBytes);
+    assertScreenMatchesFrame();
+}
+
+void test_same_text_costs_nothing(void) {
+    frame.write(0, 1, "Kerf 3.2", 20);
+    TEST_ASSERT_GREATER_THAN(0, show());
+    frame.write(0, 1, "Kerf 3.2", 20);
+    TEST_ASSERT_FALSE(frame.isDirty());
+    TEST_ASSERT_EQUAL_UINT16(0, show());
+}
+
+void test_changed_cells_only(void) {
+    frame.write(0, 1, "Kerf 3.2", 20);
+    show();
+
+    frame.write(0, 1, "Kerf 3.5", 20); // One cell: cursor + data
+    TEST_ASSERT_EQUAL_UINT16(2, show());
+
+    frame.write(0, 1, "Kerf 4.75", 20); // Cells 5-8 are one run
+    TEST_ASSERT_EQUAL_UINT16(5, show());
+    assertScreenMatchesFrame();
+}
+
+void test_run_continues_across_row_end(void) {
+    // Row 0 ends at 0x13 and row 2 starts at 0x14: no cursor move between
+    frame.put(19, 0, 'A');
+    frame.put(0, 2, 'B');
+    TEST_ASSERT_EQUAL_UINT16(3, show());
+    assertScreenMatchesFrame();
+}
+
+void test_row_mask_limits_flush(void) {
+    frame.write(0, 0, "top", 3);
+    frame.write(0, 3, "bottom", 6);
+    show(0x01);
+    TEST_ASSERT_EQUAL_UINT8('t', lcdModel.at(0, 0));
+    TEST_ASSERT_EQUAL_UINT8(' ', lcdModel.at(0, 3));
+    TEST_ASSERT_TRUE(frame.isDirty());
+    show(0x08);
+    assertScreenMatchesFrame();
+}
+
+void test_back_pressure_resumes(void) {
+    // Leave room for 5 LCD bytes only
+    while (out.room() > 5) out.data(' ');
+    frame.cursorLost(); // Those moved the cursor behind the frame's back
+    frame.write(0, 0, "ABCDEFGHIJ", 10);
+    TEST_ASSERT_EQUAL_UINT16(5, frame.flush(&out, 0x0F, glyphMap));
+    TEST_ASSERT_TRUE(frame.isDirty());
+    TEST_ASSERT_EQUAL_UINT16(0, frame.flush(&out, 0x0F, glyphMap)); // Still full
+    out.drain();
+    TEST_ASSERT_EQUAL_UINT16(6, frame.flush(&out, 0x0F, glyphMap)); // Picks up at 'E', cursor still right
+    out.drain();
+    TEST_ASSERT_FALSE(frame.isDirty());
+    TEST_ASSERT_EQUAL_UINT32(1, lcdModel.commands);
+}
+
+// A bus error part way into a character under back-pressure: the transport
+// resyncs, the owner invalidates (as DisplaySys does when getErrors() moves)
+// and the redraw lands in the right cells
+void test_bus_error_mid_frame_redraws(void) {
+    frame.write(0, 0, "12345678901234567890", 20);
+    frame.write(0, 1, "ABCDEFGHIJKLMNOPQRST", 20);
+    show();
+
+    frame.write(0, 0, "abcdefghijklmnopqrst", 20);
+    frame.write(0, 1, "zyxwvutsrqponmlkjihg", 20);
+    frame.flush(&out, 0x0F, glyphMap);
+    lcdModel.failAfter = 4 * 7 + 2; // Inside the 7th byte
+    uint32_t errors = out.getErrors();
+    while (!out.isIdle()) out.pump(LCD_TX_SLICE_BYTES);
+    TEST_ASSERT_EQUAL_UINT32(errors + 1, out.getErrors());
+
+    frame.invalidateAll();
+    show();
+    assertScreenMatchesFrame();
+}
+
+void test_invalidate_resends(void) {
+    frame.write(0, 2, "abcdef", 6);
+    show();
+    lcdModel.ddram[0x14 + 2] = '?'; // Something else wrote the glass
+    frame.invalidate(2, 2, 2);
+    TEST_ASSERT_EQUAL_UINT16(3, show());
+    assertScreenMatchesFrame();
+}
+
+void test_glyphs_go_out_as_their_slot(void) {
+    glyphMap[GLYPH_DOT - GLYPH_BASE] = 5;
+    frame.put(3, 1, GLYPH_DOT);
+    show();
+    TEST_ASSERT_EQUAL_UINT8(5, lcdModel.at(3, 1));
+
+    uint8_t counts[GLYPH_COUNT];
+    frame.put(4, 1, GLYPH_DOT);
+    frame.put(5, 1, GLYPH_COLON);
+    frame.countGlyphs(counts);
+    TEST_ASSERT_EQUAL_UINT8(2, counts[GLYPH_DOT - GLYPH_BASE]);
+    TEST_ASSERT_EQUAL_UINT8(1, counts[GLYPH_COLON - GLYPH_BASE]);
+    TEST_ASSERT_EQUAL_UINT8(0, counts[GLYPH_BAR_UP - GLYPH_BASE]);
+}
+
+void test_commit_row_for_self_drawing_backends(void) {
+    frame.put(1, 2, 'x');
+    frame.put(7, 2, 'y');
+    TEST_ASSERT_EQUAL_HEX32((1UL << 1) | (1UL << 7), frame.commitRow(2));
+    TEST_ASSERT_FALSE(frame.isDirty());
+    TEST_ASSERT_EQUAL_HEX32(0, frame.commitRow(2));
+}
+
+void test_random_edits_match_screen(void) {
+    uint32_t rng = 7;
+    for (int round = 0; round < 300; round++) {
+        int edits = 1 + round % 9;
+        for (int i = 0; i < edits; i++) {
+            rng = rng * 1103515245UL + 12345UL;
+            uint8_t col = (rng >> 8) % LCD_COLS;
+            uint8_t row = (rng >> 16) % LCD_ROWS;
+            uint8_t c = (rng >> 24) % 4 == 0 ? GLYPH_BASE + (rng >> 4) % 8 : 'a' + (rng >> 20) % 26;
+            frame.put(col, row, c);
+        }
+        // Partial flushes under a tight queue, as the render scheduler does
+        while (frame.isDirty()) {
+            frame.flush(&out, 0x0F, glyphMap);
+            out.pump(24);
+        }
+        out.drain();
+        assertScreenMatchesFrame();
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_cleared_frame_sends_nothing);
+    RUN_TEST(test_unknown_screen_goes_out_in_one_run);
+    RUN_TEST(test_same_text_costs_nothing);
+    RUN_TEST(test_changed_cells_only);
+    RUN_TEST(test_run_continues_across_row_end);
+    RUN_TEST(test_row_mask_limits_flush);
+    RUN_TEST(test_back_pressure_resumes);
+    RUN_TEST(test_bus_error_mid_frame_redraws);
+    RUN_TEST(test_invalidate_resends);
+    RUN_TEST(test_glyphs_go_out_as_their_slot);
+    RUN_TEST(test_commit_row_for_self_drawing_backends);
+    RUN_TEST(test_random_edits_match_screen);
+    return UNITY_END();
+}
@@ -0,0 +1,3 @@
+// Own unit: LcdTransport.cpp and LcdFrame.cpp each keep a file-local ROW_ADDR
+#include "FakeLcd.h"
+#include "source/LcdTransport.cpp"
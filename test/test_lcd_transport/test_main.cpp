@@ -0,0 +1,158 @@
+// LcdTransport encoding, queueing and bounded pumping on a model backpack
+#include <unity.h>
+#include <Arduino.h>
+#include "FakeLcd.h"
+#include "source/LcdTransport.cpp"
+
+static LcdTransport out(LCD_ADDR);
+
+void setUp(void) {
+    lcdModel.reset();
+    out = LcdTransport(LCD_ADDR);
+}
+
+void tearDown(void) {}
+
+void test_default_clock_within_pcf8574_rating(void) {
+#if !I2C_FAST_MODE
+    TEST_ASSERT_LESS_OR_EQUAL(100000, I2C_CLOCK_HZ);
+#endif
+    // One pass of display traffic stays near 2 ms whatever the clock
+    TEST_ASSERT_INT32_WITHIN(300, 2250, I2C_PASS_BUDGET_BYTES * 9 * 1000000L / I2C_CLOCK_HZ);
+    TEST_ASSERT_LESS_OR_EQUAL(I2C_PASS_BUDGET_BYTES, LCD_TX_SLICE_BYTES);
+}
+
+void test_byte_is_two_enable_pulses(void) {
+    TEST_ASSERT_TRUE(out.data(0xA5));
+    out.drain();
+
+    static const uint8_t expect[4] = {
+        0xA0 | 0x08 | 0x04 | 0x01, // High nibble, backlight, EN, RS
+        0xA0 | 0x08 | 0x01,
+        0x50 | 0x08 | 0x04 | 0x01, // Low nibble
+        0x50 | 0x08 | 0x01,
+    };
+    TEST_ASSERT_EQUAL_UINT32(4, out.getBytesSent());
+    TEST_ASSERT_EQUAL_UINT32(1, lcdModel.dataBytes);
+    TEST_ASSERT_EQUAL_HEX8(expect[3], lcdModel.lastExpander);
+    TEST_ASSERT_EQUAL_UINT8(0xA5, lcdModel.ddram[0]);
+}
+
+void test_backlight_off(void) {
+    out.setBacklight(false);
+    out.command(0x80);
+    out.drain();
+    TEST_ASSERT_EQUAL_HEX8(0, lcdModel.lastExpander & 0x08);
+    TEST_ASSERT_EQUAL_UINT32(1, lcdModel.commands);
+}
+
+void test_set_cursor_rows(void) {
+    out.setCursor(5, 2);
+    out.data('x');
+    out.setCursor(19, 3);
+    out.data('y');
+    out.drain();
+    TEST_ASSERT_EQUAL_UINT8('x', lcdModel.at(5, 2));
+    TEST_ASSERT_EQUAL_UINT8('y', lcdModel.at(19, 3));
+}
+
+void test_full_queue_rejects(void) {
+    uint16_t fits = out.room();
+    TEST_ASSERT_EQUAL_UINT16(LCD_TX_QUEUE_BYTES / 4, fits);
+    for (uint16_t i = 0; i < fits; i++) TEST_ASSERT_TRUE(out.data('a'));
+    TEST_ASSERT_EQUAL_UINT16(0, out.room());
+    TEST_ASSERT_FALSE(out.data('b'));
+    TEST_ASSERT_FALSE(out.command(0x80));
+    out.drain();
+    TEST_ASSERT_TRUE(out.isIdle());
+    TEST_ASSERT_EQUAL_UINT32(fits, lcdModel.dataBytes);
+}
+
+void test_pump_is_bounded_and_chunked(void) {
+    for (uint8_t i = 0; i < 40; i++) out.data('0' + i % 10); // 160 expander bytes
+    TEST_ASSERT_EQUAL_UINT16(LCD_TX_SLICE_BYTES, out.pump(LCD_TX_SLICE_BYTES));
+    TEST_ASSERT_LESS_OR_EQUAL(LCD_TX_CHUNK, lcdModel.maxWrite);
+    TEST_ASSERT_EQUAL_UINT32(LCD_TX_SLICE_BYTES / 4, lcdModel.dataBytes);
+
+    // Budgets are rounded down to whole LCD bytes
+    TEST_ASSERT_EQUAL_UINT16(0, out.pump(3));
+    TEST_ASSERT_EQUAL_UINT16(4, out.pump(7));
+    while (!out.isIdle()) out.pump(7);
+    TEST_ASSERT_EQUAL_UINT32(40, lcdModel.dataBytes);
+    TEST_ASSERT_EQUAL_UINT32(160, out.getBytesSent());
+    for (uint8_t i = 0; i < 20; i++) TEST_ASSERT_EQUAL_UINT8('0' + i % 10, lcdModel.at(i, 0));
+}
+
+static void printAt(uint8_t col, uint8_t row, const char *s) {
+    out.setCursor(col, row);
+    while (*s) out.data(*s++);
+}
+
+void test_bus_error_counts_and_drops(void) {
+    out.data('q');
+    lcdModel.failWrites = true;
+    out.drain();
+    TEST_ASSERT_EQUAL_UINT32(2, out.getErrors()); // The write, then the resync's first nibble
+    TEST_ASSERT_TRUE(out.isIdle());
+    TEST_ASSERT_EQUAL_UINT8(' ', lcdModel.ddram[0]);
+}
+
+// A write cut after the high nibble of 'E': without the resync every byte
+// after it would be read a nibble out
+void test_torn_write_resyncs_nibble_phase(void) {
+    printAt(0, 0, "HELLO");
+    lcdModel.failAfter = 6;
+    out.drain();
+    TEST_ASSERT_EQUAL_UINT32(1, out.getErrors());
+    TEST_ASSERT_TRUE(out.isIdle()); // The rest of the queue went with it
+    TEST_ASSERT_FALSE(lcdModel.eightBit);
+    TEST_ASSERT_FALSE(lcdModel.haveHighNibble);
+
+    // The owner redraws: decoded in phase again
+    printAt(0, 0, "HELLO");
+    printAt(0, 3, "WORLD");
+    out.drain();
+    TEST_ASSERT_EQUAL_UINT32(1, out.getErrors());
+    const char *expect[2] = { "HELLO", "WORLD" };
+    for (uint8_t i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_UINT8(expect[0][i], lcdModel.at(i, 0));
+        TEST_ASSERT_EQUAL_UINT8(expect[1][i], lcdModel.at(i, 3));
+    }
+}
+
+// Display unplugged and back: it powers up in 8-bit mode, and nothing is sent
+// to it before the resync that failed while it was away has gone through
+void test_resync_retried_until_display_answers(void) {
+    printAt(0, 1, "gone");
+    lcdModel.failWrites = true;
+    out.drain();
+    uint32_t errors = out.getErrors();
+
+    // Still away: the retry fails first and the frame is dropped unsent
+    printAt(0, 1, "gone");
+    TEST_ASSERT_EQUAL_UINT16(0, out.pump(LCD_TX_SLICE_BYTES));
+    TEST_ASSERT_TRUE(out.isIdle());
+    TEST_ASSERT_EQUAL_UINT32(errors + 1, out.getErrors());
+
+    lcdModel.reset();
+    lcdModel.eightBit = true;
+    printAt(0, 1, "back");
+    out.drain();
+    TEST_ASSERT_EQUAL_UINT32(errors + 1, out.getErrors());
+    TEST_ASSERT_FALSE(lcdModel.eightBit);
+    for (uint8_t i = 0; i < 4; i++) TEST_ASSERT_EQUAL_UINT8("back"[i], lcdModel.at(i, 1));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_default_clock_within_pcf8574_rating);
+    RUN_TEST(test_byte_is_two_enable_pulses);
+    RUN_TEST(test_backlight_off);
+    RUN_TEST(test_set_cursor_rows);
+    RUN_TEST(test_full_queue_rejects);
+    RUN_TEST(test_pump_is_bounded_and_chunked);
+    RUN_TEST(test_bus_error_counts_and_drops);
+    RUN_TEST(test_torn_write_resyncs_nibble_phase);
+    RUN_TEST(test_resync_retried_until_display_answers);
+    return UNITY_END();
+}
@@ -0,0 +1,88 @@
+// LineBuf formatting and capacity
+#include <unity.h>
+#include <Arduino.h>
+#include "headers/LineBuf.h"
+#include "source/LineBuf.cpp"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_append_and_terminate(void) {
+    LineBuf line("Kerf ");
+    line.add('=').add(' ').addInt(3);
+    TEST_ASSERT_EQUAL_STRING("Kerf = 3", line.c_str());
+    TEST_ASSERT_EQUAL_UINT8(8, line.length());
+    line.clear();
+    TEST_ASSERT_TRUE(line.isEmpty());
+    TEST_ASSERT_EQUAL_STRING("", line.c_str());
+}
+
+void test_integers(void) {
+    LineBuf line;
+    line.addInt(0).add(' ').addInt(-42).add(' ').addInt(INT32_MIN);
+    TEST_ASSERT_EQUAL_STRING("0 -42 -2147483648", line.c_str());
+    line.clear();
+    line.addUInt(UINT32_MAX);
+    TEST_ASSERT_EQUAL_STRING("4294967295", line.c_str());
+}
+
+void test_fixed_point(void) {
+    LineBuf line;
+    line.addFixed(1234, 1);
+    TEST_ASSERT_EQUAL_STRING("123.4", line.c_str());
+    line.clear();
+    line.addFixed(5, 3);
+    TEST_ASSERT_EQUAL_STRING("0.005", line.c_str());
+    line.clear();
+    line.addFixed(-5, 1);
+    TEST_ASSERT_EQUAL_STRING("-0.5", line.c_str());
+    line.clear();
+    line.addFixed(77, 0);
+    TEST_ASSERT_EQUAL_STRING("77", line.c_str());
+}
+
+void test_floats_round_like_string(void) {
+    LineBuf line;
+    line.addFloat(3.175f, 2); // 1/8" kerf
+    TEST_ASSERT_EQUAL_STRING("3.18", line.c_str());
+    line.clear();
+    line.addFloat(-12.04f, 1);
+    TEST_ASSERT_EQUAL_STRING("-12.0", line.c_str());
+    line.clear();
+    line.addFloat(49.95f, 1);
+    TEST_ASSERT_EQUAL_STRING("50.0", line.c_str());
+    line.clear();
+    line.addFloat(1e12f, 2);
+    TEST_ASSERT_EQUAL_STRING("OVF", line.c_str());
+}
+
+void test_pad(void) {
+    LineBuf line("Len");
+    line.pad('.', 8).add('X');
+    TEST_ASSERT_EQUAL_STRING("Len.....X", line.c_str());
+    line.pad(' ', 4); // Already wider: nothing
+    TEST_ASSERT_EQUAL_UINT8(9, line.length());
+}
+
+void test_capacity_is_one_display_line(void) {
+    LineBuf line("0123456789");
+    line.add("ABCDEFGHIJ").add("overflow").add('!').addInt(12345);
+    TEST_ASSERT_EQUAL_UINT8(LINEBUF_CAPACITY, line.length());
+    TEST_ASSERT_EQUAL_STRING("0123456789ABCDEFGHIJ", line.c_str());
+
+    LineBuf padded;
+    padded.pad('-', 200);
+    TEST_ASSERT_EQUAL_UINT8(LINEBUF_CAPACITY, padded.length());
+    TEST_ASSERT_EQUAL('\0', padded.c_str()[LINEBUF_CAPACITY]);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_append_and_terminate);
+    RUN_TEST(test_integers);
+    RUN_TEST(test_fixed_point);
+    RUN_TEST(test_floats_round_like_string);
+    RUN_TEST(test_pad);
+    RUN_TEST(test_capacity_is_one_display_line);
+    return UNITY_END();
+}
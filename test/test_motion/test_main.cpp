@@ -0,0 +1,122 @@
+// MotionEstimator against synthetic encoder pulse trains (see PulseTrain.h)
+#include <unity.h>
+#include <Arduino.h>
+#include "PulseTrain.h"
+#include "source/MotionEstimator.cpp"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Steady feed: after settling, every sample within 1 % (+/- 2 counts/s)
+static void checkSteady(double rate) {
+    PulseTrain p;
+    auto v = [rate](uint32_t) { return rate; };
+    for (int i = 0; i < 300; i++) p.sample(v);
+
+    int32_t lo = INT32_MAX, hi = INT32_MIN;
+    for (int i = 0; i < 1000; i++) {
+        p.sample(v);
+        lo = min(lo, p.velocity());
+        hi = max(hi, p.velocity());
+    }
+    int32_t tol = (int32_t)(fabs(rate) / 100) + 2;
+    TEST_ASSERT_INT32_WITHIN(tol, (int32_t)rate, lo);
+    TEST_ASSERT_INT32_WITHIN(tol, (int32_t)rate, hi);
+    TEST_ASSERT_INT32_WITHIN(fabs(rate) * 2, 0, p.est.getAccel()); // Well under 1 % of rate per ms
+}
+
+void test_steady_slow_t_method(void) { checkSteady(300); }
+void test_steady_3000(void) { checkSteady(3000); }
+void test_steady_7000(void) { checkSteady(7000); }
+void test_steady_div8(void) { checkSteady(20000); }
+void test_steady_reverse(void) { checkSteady(-3000); }
+
+void test_ramp_through_prescaler_switch(void) {
+    // 0 -> 20000 counts/s in 0.5 s (40000 counts/s^2), then hold
+    PulseTrain p;
+    uint32_t t0 = p.nowUs;
+    auto v = [t0](uint32_t t) {
+        double s = (t - t0) / 1e6;
+        return (s < 0.5) ? 40000.0 * s : 20000.0;
+    };
+    for (int i = 0; i < 480; i++) {
+        p.sample(v);
+        if (i >= 50) {
+            double truth = 40000.0 * (p.nowUs - t0) / 1e6;
+            // Edge estimates lag by half a capture interval at most
+            TEST_ASSERT_INT32_WITHIN(truth * 0.03 + 60, (int32_t)truth, p.velocity());
+        }
+    }
+    TEST_ASSERT_TRUE(p.div8);
+    TEST_ASSERT_INT32_WITHIN(8000, 40000, p.est.getAccel());
+
+    for (int i = 0; i < 500; i++) p.sample(v);
+    TEST_ASSERT_INT32_WITHIN(202, 20000, p.velocity());
+    TEST_ASSERT_INT32_WITHIN(10000, 0, p.est.getAccel()); // ~0.4 m/s^2: capture jitter only
+}
+
+void test_stop_decays_to_zero(void) {
+    PulseTrain p;
+    double rate = 3000;
+    auto v = [&rate](uint32_t) { return rate; };
+    for (int i = 0; i < 300; i++) p.sample(v);
+
+    rate = 0;
+    int32_t last = p.velocity();
+    uint32_t ms = 0;
+    while (p.velocity() != 0 && ms < 1000) {
+        p.sample(v);
+        TEST_ASSERT_LESS_OR_EQUAL_INT32(last, p.velocity()); // Never bounces back up
+        last = p.velocity();
+        ms++;
+    }
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(MotionEstimator::MOTION_STOP_US / 1000 + 1, ms);
+    TEST_ASSERT_EQUAL_INT32(0, p.est.getAccel());
+}
+
+void test_start_from_rest(void) {
+    PulseTrain p;
+    double rate = 0;
+    auto v = [&rate](uint32_t) { return rate; };
+    for (int i = 0; i < 500; i++) p.sample(v);
+    TEST_ASSERT_EQUAL_INT32(0, p.velocity());
+
+    // The first edge only anchors (its interval spans the standstill)
+    rate = 2000;
+    for (int i = 0; i < 10; i++) p.sample(v);
+    TEST_ASSERT_GREATER_THAN_INT32(0, p.velocity());
+    for (int i = 0; i < 20; i++) p.sample(v);
+    TEST_ASSERT_INT32_WITHIN(22, 2000, p.velocity());
+}
+
+void test_reversal_flips_sign(void) {
+    PulseTrain p;
+    double rate = 2000;
+    auto v = [&rate](uint32_t) { return rate; };
+    for (int i = 0; i < 300; i++) p.sample(v);
+
+    rate = -2000;
+    int ms = 0;
+    while (p.velocity() >= 0 && ms < 50) {
+        p.sample(v);
+        ms++;
+    }
+    TEST_ASSERT_LESS_THAN_INT32(0, p.velocity());
+    TEST_ASSERT_LESS_OR_EQUAL(10, ms);
+    for (int i = 0; i < 50; i++) p.sample(v);
+    TEST_ASSERT_INT32_WITHIN(22, -2000, p.velocity());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_steady_slow_t_method);
+    RUN_TEST(test_steady_3000);
+    RUN_TEST(test_steady_7000);
+    RUN_TEST(test_steady_div8);
+    RUN_TEST(test_steady_reverse);
+    RUN_TEST(test_ramp_through_prescaler_switch);
+    RUN_TEST(test_stop_decays_to_zero);
+    RUN_TEST(test_start_from_rest);
+    RUN_TEST(test_reversal_flips_sign);
+    return UNITY_END();
+}
@@ -0,0 +1,339 @@
+// SettingsLog on a RAM model of the two flash sectors, with power cuts at
+// every flash operation of an append, a compaction and an erase
+#include <unity.h>
+#include <Arduino.h>
+#include "headers/InternalFlash.h"
+#include "source/SettingsLog.cpp"
+
+// ============================================================================
+// RAM FLASH (stands in for InternalFlash.cpp)
+// ============================================================================
+// Programming only clears bits. The power fails once budget operations have
+// completed: the word being programmed is left with some of its new 0 bits,
+// an erase with any mix of old, erased and half-erased words.
+
+struct PowerCut {};
+
+static uint32_t sectors[2][STORAGE_SECTOR_SIZE / 4];
+static long budget = -1; // Flash operations until the power fails, -1 = never
+static uint32_t erases = 0;
+static uint32_t rng = 12345;
+
+static uint32_t nextRandom() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static uint32_t *sectorWords(uint8_t sector) {
+    return sectors[(sector == STORAGE_SECTOR_A) ? 0 : 1];
+}
+
+static bool powerFails() {
+    if (budget < 0) return false;
+    if (budget == 0) return true;
+    budget--;
+    return false;
+}
+
+uintptr_t flashSectorBase(uint8_t sector) {
+    return (uintptr_t)sectorWords(sector);
+}
+
+bool flashProgram(uintptr_t addr, uint32_t word) {
+    uint32_t *p = (uint32_t *)addr;
+    if (powerFails()) {
+        *p &= word | nextRandom();
+        throw PowerCut();
+    }
+    *p &= word;
+    return *p == word;
+}
+
+bool flashErase(uint8_t sector) {
+    uint32_t *p = sectorWords(sector);
+    if (powerFails()) {
+        for (uint32_t i = 0; i < STORAGE_SECTOR_SIZE / 4; i++) {
+            uint32_t r = nextRandom();
+            if (r % 3 == 1) p[i] = 0xFFFFFFFFUL;
+            else if (r % 3 == 2) p[i] |= nextRandom();
+        }
+        throw PowerCut();
+    }
+    memset(p, 0xFF, STORAGE_SECTOR_SIZE);
+    erases++;
+    return true;
+}
+
+// ============================================================================
+// DEVICE
+// ============================================================================
+struct Settings {
+    uint32_t index;
+    uint8_t fill[92];
+};
+
+#define VERSION 3
+
+static void fillSettings(Settings &s, uint32_t index) {
+    s.index = index;
+    for (uint8_t i = 0; i < sizeof(s.fill); i++) s.fill[i] = (uint8_t)(index * 7 + i);
+}
+
+static bool intact(const Settings &s) {
+    Settings expect;
+    fillSettings(expect, s.index);
+    return memcmp(&s, &expect, sizeof(Settings)) == 0;
+}
+
+// One power-on: a fresh log object over whatever the flash holds
+struct Device {
+    SettingsLog log;
+    Settings settings;
+    bool loaded;
+
+    Device() {
+        memset(&settings, 0, sizeof(settings));
+        loaded = log.begin(&settings, sizeof(Settings), VERSION);
+    }
+
+    // Save and run the loop until it is written (false if it can't be yet)
+    bool save(uint32_t index) {
+        fillSettings(settings, index);
+        log.save(&settings);
+        for (int pass = 0; pass < 100 && !log.isIdle(); pass++) log.update();
+        return log.isIdle();
+    }
+};
+
+static void blankFlash() {
+    memset(sectors, 0xFF, sizeof(sectors));
+    budget = -1;
+    erases = 0;
+}
+
+// Saves needed from a fresh log until the first compaction
+static uint32_t savesToFill() {
+    blankFlash();
+    Device dev;
+    uint32_t n = 0;
+    while (dev.log.getCompactions() == 0) dev.save(++n);
+    return n;
+}
+
+void setUp(void) { blankFlash(); }
+void tearDown(void) {}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+void test_first_boot_keeps_defaults(void) {
+    Device first;
+    TEST_ASSERT_FALSE(first.loaded);
+    TEST_ASSERT_TRUE(first.save(1));
+
+    Device second;
+    TEST_ASSERT_TRUE(second.loaded);
+    TEST_ASSERT_EQUAL_UINT32(1, second.settings.index);
+}
+
+void test_newest_record_wins(void) {
+    {
+        Device dev;
+        for (uint32_t i = 1; i <= 20; i++) TEST_ASSERT_TRUE(dev.save(i));
+    }
+    Device dev;
+    TEST_ASSERT_TRUE(dev.loaded);
+    TEST_ASSERT_EQUAL_UINT32(20, dev.settings.index);
+    TEST_ASSERT_TRUE(intact(dev.settings));
+    TEST_ASSERT_EQUAL_UINT32(20, dev.log.getSequence());
+}
+
+void test_other_layout_is_ignored(void) {
+    {
+        Device dev;
+        dev.save(5);
+    }
+    SettingsLog log;
+    Settings s;
+    TEST_ASSERT_FALSE(log.begin(&s, sizeof(Settings), VERSION + 1));
+    TEST_ASSERT_FALSE(log.begin(&s, sizeof(Settings) - 4, VERSION));
+}
+
+void test_update_never_erases(void) {
+    uint32_t fill = savesToFill();
+    blankFlash();
+    Device dev;
+    uint32_t bootErases = erases;
+
+    // Fill both sectors: the second compaction needs the old sector erased
+    uint32_t i = 1;
+    while (dev.save(i)) i++;
+    TEST_ASSERT_EQUAL_UINT32(bootErases, erases);
+    TEST_ASSERT_EQUAL_UINT16(1, dev.log.getCompactions());
+    TEST_ASSERT_GREATER_THAN_UINT32(fill, i);
+    TEST_ASSERT_TRUE(dev.log.isStalled()); // The operator is told
+
+    // The stuck save goes through once the menu has erased the old sector
+    dev.log.eraseSpare();
+    TEST_ASSERT_EQUAL_UINT32(bootErases + 1, erases);
+    for (int pass = 0; pass < 100 && !dev.log.isIdle(); pass++) dev.log.update();
+    TEST_ASSERT_TRUE(dev.log.isIdle());
+    TEST_ASSERT_FALSE(dev.log.isStalled());
+    TEST_ASSERT_EQUAL_UINT16(2, dev.log.getCompactions());
+
+    Device after;
+    TEST_ASSERT_EQUAL_UINT32(i, after.settings.index);
+    TEST_ASSERT_EQUAL_UINT32(0, after.log.getErrors());
+}
+
+// The erase is asked for half a sector ahead, so saves never have to wait
+void test_erase_due_well_before_needed(void) {
+    uint32_t fill = savesToFill();
+    blankFlash();
+    Device dev;
+    uint32_t i = 1;
+    while (dev.log.getCompactions() == 0) TEST_ASSERT_TRUE(dev.save(i++));
+    TEST_ASSERT_FALSE(dev.log.isEraseDue()); // Fresh sector: no hurry
+
+    while (!dev.log.isEraseDue()) {
+        TEST_ASSERT_TRUE(dev.save(i++));
+        TEST_ASSERT_FALSE(dev.log.isStalled());
+    }
+    uint32_t dueAt = i;
+    TEST_ASSERT_UINT32_WITHIN(fill / 10, fill + fill / 2, dueAt);
+
+    dev.log.eraseSpare();
+    TEST_ASSERT_FALSE(dev.log.isEraseDue());
+    while (dev.log.getCompactions() == 1) {
+        TEST_ASSERT_TRUE(dev.save(i++)); // Straight through the next compaction
+        TEST_ASSERT_FALSE(dev.log.isStalled());
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, dev.log.getErrors());
+}
+
+void test_no_log_is_stalled(void) {
+    SettingsLog log;
+    TEST_ASSERT_TRUE(log.isStalled()); // begin() never ran: saves go nowhere
+    TEST_ASSERT_FALSE(log.isEraseDue());
+}
+
+void test_erase_spare_keeps_the_only_copy(void) {
+    // After a compaction the record in the new sector has decayed: the old
+    // sector holds the only good copy and must survive a menu visit
+    uint32_t fill = savesToFill();
+    uint32_t *active = sectors[1];
+    active[5] &= active[5] - 1; // One payload bit of the copied record drops
+
+    {
+        Device dev;
+        TEST_ASSERT_TRUE(dev.loaded);
+        TEST_ASSERT_EQUAL_UINT32(fill - 1, dev.settings.index);
+        dev.log.eraseSpare();
+    }
+    {
+        Device dev;
+        TEST_ASSERT_EQUAL_UINT32(fill - 1, dev.settings.index);
+        TEST_ASSERT_TRUE(dev.save(fill + 1)); // Now the new sector has one
+        uint32_t before = erases;
+        dev.log.eraseSpare();
+        TEST_ASSERT_EQUAL_UINT32(before + 1, erases);
+    }
+    Device dev;
+    TEST_ASSERT_EQUAL_UINT32(fill + 1, dev.settings.index);
+}
+
+// Cuts the power after each flash operation in turn while saves from..to
+// are written, reboots, and checks the log comes back with the last
+// completed save or the one in flight, then carries on saving.
+static void sweepCuts(const char *label, uint32_t primeSaves, uint32_t from, uint32_t to) {
+    static uint32_t snapshot[2][STORAGE_SECTOR_SIZE / 4];
+
+    blankFlash();
+    {
+        Device dev;
+        for (uint32_t i = 1; i <= primeSaves; i++) dev.save(i);
+    }
+    memcpy(snapshot, sectors, sizeof(sectors));
+
+    for (long cut = 0;; cut++) {
+        memcpy(sectors, snapshot, sizeof(sectors));
+        uint32_t committed = primeSaves;
+        uint32_t inFlight = 0;
+        bool wasCut = false;
+        {
+            Device dev;
+            budget = cut;
+            try {
+                for (uint32_t i = from; i <= to; i++) {
+                    inFlight = i;
+                    dev.save(i);
+                    committed = i;
+                    if (dev.log.getCompactions() > 0) dev.log.eraseSpare(); // Menu visit
+                }
+            } catch (PowerCut &) {
+                wasCut = true;
+            }
+            budget = -1;
+        }
+        if (!wasCut) break; // Every operation has had its cut
+
+        char msg[64];
+        snprintf(msg, sizeof(msg), "%s, cut after %ld flash operations", label, cut);
+        Device dev;
+        TEST_ASSERT_TRUE_MESSAGE(dev.loaded, msg);
+        TEST_ASSERT_TRUE_MESSAGE(intact(dev.settings), msg);
+        if (dev.settings.index != committed) {
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(inFlight, dev.settings.index, msg);
+        }
+
+        TEST_ASSERT_TRUE_MESSAGE(dev.save(1000), msg);
+        Device again;
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(1000, again.settings.index, msg);
+    }
+}
+
+void test_power_cut_while_appending(void) {
+    sweepCuts("append", 5, 6, 8);
+}
+
+void test_power_cut_while_compacting(void) {
+    uint32_t fill = savesToFill();
+    // The last records of the first sector, the copy, the new header and
+    // the menu erase of the old sector
+    sweepCuts("compaction", fill - 2, fill - 1, fill + 1);
+}
+
+void test_power_cut_on_first_boot(void) {
+    // Junk in sector A: the first boot erases it before writing a header
+    memset(sectors[0], 0x5A, 64);
+    budget = 0;
+    try {
+        Device dev;
+        TEST_FAIL_MESSAGE("erase was not attempted");
+    } catch (PowerCut &) {
+    }
+    budget = -1;
+
+    Device dev;
+    TEST_ASSERT_FALSE(dev.loaded);
+    TEST_ASSERT_TRUE(dev.save(1));
+    Device again;
+    TEST_ASSERT_EQUAL_UINT32(1, again.settings.index);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_boot_keeps_defaults);
+    RUN_TEST(test_newest_record_wins);
+    RUN_TEST(test_other_layout_is_ignored);
+    RUN_TEST(test_update_never_erases);
+    RUN_TEST(test_erase_due_well_before_needed);
+    RUN_TEST(test_no_log_is_stalled);
+    RUN_TEST(test_erase_spare_keeps_the_only_copy);
+    RUN_TEST(test_power_cut_while_appending);
+    RUN_TEST(test_power_cut_while_compacting);
+    RUN_TEST(test_power_cut_on_first_boot);
+    return UNITY_END();
+}
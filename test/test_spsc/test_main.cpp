@@ -0,0 +1,171 @@
+// SpscQueue ordering, capacity and index wrap, and a two-thread stress run
+#include <unity.h>
+#include <Arduino.h>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include "headers/SpscQueue.h"
+#include "headers/UserInput.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_fifo_order(void) {
+    SpscQueue<uint16_t, 4> q;
+    uint16_t v;
+    TEST_ASSERT_TRUE(q.isEmpty());
+    TEST_ASSERT_FALSE(q.pop(&v));
+
+    TEST_ASSERT_TRUE(q.push(10));
+    TEST_ASSERT_TRUE(q.push(20));
+    TEST_ASSERT_EQUAL_UINT8(2, q.size());
+    TEST_ASSERT_TRUE(q.pop(&v));
+    TEST_ASSERT_EQUAL_UINT16(10, v);
+    TEST_ASSERT_TRUE(q.pop(&v));
+    TEST_ASSERT_EQUAL_UINT16(20, v);
+    TEST_ASSERT_TRUE(q.isEmpty());
+}
+
+void test_full_rejects_newest(void) {
+    SpscQueue<uint8_t, 4> q;
+    for (uint8_t i = 0; i < 4; i++) TEST_ASSERT_TRUE(q.push(i));
+    TEST_ASSERT_FALSE(q.push(99));
+    TEST_ASSERT_EQUAL_UINT8(4, q.size());
+
+    uint8_t v;
+    for (uint8_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(q.pop(&v));
+        TEST_ASSERT_EQUAL_UINT8(i, v); // The oldest survive, in order
+    }
+    TEST_ASSERT_FALSE(q.pop(&v));
+}
+
+void test_largest_queue_fills(void) {
+    // 128 entries: fill = head - tail must not alias empty in 8 bits
+    SpscQueue<uint8_t, 128> q;
+    for (int i = 0; i < 128; i++) TEST_ASSERT_TRUE(q.push((uint8_t)i));
+    TEST_ASSERT_FALSE(q.push(0));
+    TEST_ASSERT_FALSE(q.isEmpty());
+    TEST_ASSERT_EQUAL_UINT8(128, q.size());
+}
+
+void test_clear_drops_pending(void) {
+    SpscQueue<uint8_t, 8> q;
+    q.push(1);
+    q.push(2);
+    q.clear();
+    uint8_t v;
+    TEST_ASSERT_FALSE(q.pop(&v));
+    TEST_ASSERT_TRUE(q.push(3));
+    TEST_ASSERT_TRUE(q.pop(&v));
+    TEST_ASSERT_EQUAL_UINT8(3, v);
+}
+
+void test_matches_model_across_index_wrap(void) {
+    // Uneven bursts on both sides, many times round the 8-bit counters
+    SpscQueue<uint32_t, 16> q;
+    std::deque<uint32_t> model;
+    uint32_t next = 0;
+    uint32_t rng = 1;
+
+    for (int round = 0; round < 5000; round++) {
+        rng = rng * 1103515245UL + 12345UL;
+        int pushes = (rng >> 16) % 7;
+        int pops = (rng >> 20) % 7;
+
+        for (int i = 0; i < pushes; i++) {
+            bool ok = q.push(next);
+            TEST_ASSERT_EQUAL(model.size() < 16, ok);
+            if (ok) model.push_back(next);
+            next++;
+        }
+        for (int i = 0; i < pops; i++) {
+            uint32_t v;
+            bool ok = q.pop(&v);
+            TEST_ASSERT_EQUAL(!model.empty(), ok);
+            if (ok) {
+                TEST_ASSERT_EQUAL_UINT32(model.front(), v);
+                model.pop_front();
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT8(model.size(), q.size());
+    }
+}
+
+// The producer plays UserInput::postEvent() (queue the record, count the
+// loss when full), the consumer plays the main loop, each on its own thread.
+// timeMs is the producer's sequence number, so a gap in what the consumer
+// sees is exactly the rejected pushes. Asserts run after the join: Unity
+// can't fail from another thread.
+void test_threads_keep_order_and_count_losses(void) {
+    const uint32_t PUSHES = 200000;
+    SpscQueue<InputRecord, INPUT_QUEUE_SIZE> q;
+    std::atomic<bool> started(false);
+    std::atomic<bool> done(false);
+    uint32_t overflows = 0;
+
+    uint32_t received = 0;
+    uint32_t gaps = 0;
+    uint32_t outOfOrder = 0;
+    uint32_t torn = 0;
+
+    std::thread consumer([&]() {
+        uint32_t expect = 0;
+        uint32_t rng = 7;
+        started.store(true);
+        for (;;) {
+            bool finished = done.load();
+            InputRecord r;
+            while (q.pop(&r)) {
+                if (r.timeMs < expect) outOfOrder++;
+                else gaps += r.timeMs - expect;
+                expect = r.timeMs + 1;
+                if (r.steps != (uint8_t)r.timeMs || r.event != ((r.timeMs & 1) ? EVENT_CW : EVENT_CCW)) torn++;
+                received++;
+
+                // A busy loop now and then: the queue fills and drops
+                rng = rng * 1103515245UL + 12345UL;
+                if (((rng >> 16) & 0x3FF) == 0) {
+                    for (volatile int spin = 0; spin < 20000; spin++) {}
+                }
+            }
+            if (finished) {
+                gaps += PUSHES - expect; // Dropped at the very end
+                return;
+            }
+        }
+    });
+
+    while (!started.load()) {}
+    for (uint32_t i = 0; i < PUSHES; i++) {
+        for (volatile int spin = 0; spin < 50; spin++) {} // Ticks come at a pace
+        if ((i & 63) == 0) std::this_thread::yield(); // Lets the consumer in on one core too
+        InputRecord r;
+        r.event = (i & 1) ? EVENT_CW : EVENT_CCW;
+        r.timeMs = i;
+        r.steps = (uint8_t)i;
+        if (!q.push(r)) {
+            overflows++;
+        }
+    }
+    done.store(true);
+    consumer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(PUSHES, received + overflows);
+    TEST_ASSERT_EQUAL_UINT32(overflows, gaps); // Only rejected pushes are missing
+    TEST_ASSERT_TRUE(overflows > 0);           // The stalls did fill the queue
+    TEST_ASSERT_TRUE(received > PUSHES / 100);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_fifo_order);
+    RUN_TEST(test_full_rejects_newest);
+    RUN_TEST(test_largest_queue_fills);
+    RUN_TEST(test_clear_drops_pending);
+    RUN_TEST(test_matches_model_across_index_wrap);
+    RUN_TEST(test_threads_keep_order_and_count_losses);
+    return UNITY_END();
+}
@@ -0,0 +1,229 @@
+// Target-approach alarm on the fake TIM4: the trip prediction, the tick's
+// serviceAlarm and the CH3 compare match, approached from both sides
+#define STM32F4xx
+#include <unity.h>
+#include <Arduino.h>
+#include "headers/EncoderSys.h"
+#include "source/EncoderSys.cpp"
+#include "source/MotionEstimator.cpp"
+#include "source/EncoderDiag.cpp"
+#include "source/CalibrationTable.cpp"
+
+static EncoderSys enc; // init() news the timer: one for the run
+
+static bool alarmPin() {
+    return hostPinLevel[PIN_TARGET_ALARM] == HIGH;
+}
+
+static int64_t countNow() {
+    return enc.getSnapshot().count;
+}
+
+// Wheel moves `steps` counts one at a time, the encoder IRQ (wrap, compare)
+// served after each count: no latency
+static void roll(int32_t steps) {
+    int32_t dir = (steps > 0) ? 1 : -1;
+    while (steps != 0) {
+        hostTimerCount(TIM4, dir);
+        hostTimerIrq(TIM4);
+        steps -= dir;
+    }
+}
+
+// Wheel moves `steps` counts before the IRQ gets to run (latency)
+static void jump(int32_t steps) {
+    hostTimerCount(TIM4, steps);
+    hostTimerIrq(TIM4);
+}
+
+// One 1 ms tick: `perTick` counts, then the sample ISR
+static void tick(int32_t perTick) {
+    if (perTick != 0) roll(perTick);
+    hostMicros += 1000;
+    hostMillis += 1;
+    enc.sampleISR();
+}
+
+// Alarm `counts` away from here, armed by a tick with the wheel stopped
+static int64_t armAt(int64_t counts) {
+    int64_t target = countNow() + counts;
+    enc.reset();
+    enc.setTargetAlarm((PositionUM)enc.countsToUM(counts), 0);
+    tick(0);
+    return target;
+}
+
+void setUp(void) {
+    for (int i = 0; i < 50; i++) tick(0); // Settle the estimator at rest
+    enc.clearTargetAlarm();
+}
+
+void tearDown(void) {}
+
+// ============================================================================
+// predictTripCount
+// ============================================================================
+
+void test_predict_trip_count(void) {
+    const int32_t Q8 = 256;
+    // Stopped, no lead time, or at the target: the target itself
+    TEST_ASSERT_EQUAL_INT64(10000, EncoderSys::predictTripCount(10000, 0, 0, 100));
+    TEST_ASSERT_EQUAL_INT64(10000, EncoderSys::predictTripCount(10000, 0, 5000 * Q8, 0));
+    TEST_ASSERT_EQUAL_INT64(10000, EncoderSys::predictTripCount(10000, 10000, 5000 * Q8, 100));
+
+    // Approaching from below: 5000 counts/s * 100 ms = 500 counts early
+    TEST_ASSERT_EQUAL_INT64(9500, EncoderSys::predictTripCount(10000, 0, 5000 * Q8, 100));
+    // From above, same speed the other way
+    TEST_ASSERT_EQUAL_INT64(10500, EncoderSys::predictTripCount(10000, 20000, -5000 * Q8, 100));
+
+    // Moving away: no look-ahead in either direction
+    TEST_ASSERT_EQUAL_INT64(10000, EncoderSys::predictTripCount(10000, 0, -5000 * Q8, 100));
+    TEST_ASSERT_EQUAL_INT64(10000, EncoderSys::predictTripCount(10000, 20000, 5000 * Q8, 100));
+
+    // Lead never reaches behind the current position
+    TEST_ASSERT_EQUAL_INT64(9800, EncoderSys::predictTripCount(10000, 9800, 5000 * Q8, 1000));
+    TEST_ASSERT_EQUAL_INT64(10200, EncoderSys::predictTripCount(10000, 10200, -5000 * Q8, 1000));
+
+    // Far past 16 bits, and negative positions
+    TEST_ASSERT_EQUAL_INT64(4999999500LL, EncoderSys::predictTripCount(5000000000LL, 0, 5000 * Q8, 100));
+    TEST_ASSERT_EQUAL_INT64(-99500, EncoderSys::predictTripCount(-100000, 0, -5000 * Q8, 100));
+}
+
+// ============================================================================
+// onCompare: exact count, right epoch only
+// ============================================================================
+
+void test_compare_fires_at_the_count_from_below(void) {
+    int64_t target = armAt(300);
+    roll(299);
+    TEST_ASSERT_FALSE(alarmPin());
+    roll(1);
+    TEST_ASSERT_TRUE(alarmPin());
+    TEST_ASSERT_TRUE(enc.isTargetAlarmActive());
+    TEST_ASSERT_EQUAL_INT64(target, countNow());
+}
+
+void test_compare_fires_at_the_count_from_above(void) {
+    int64_t target = armAt(-300);
+    roll(-299);
+    TEST_ASSERT_FALSE(alarmPin());
+    roll(-1);
+    TEST_ASSERT_TRUE(alarmPin());
+    TEST_ASSERT_EQUAL_INT64(target, countNow());
+}
+
+void test_compare_ignores_the_wrong_epoch(void) {
+    // CCR3 holds the low 16 bits: the counter matches them one wrap early
+    int64_t target = armAt(65536 + 200);
+    roll(199);
+    TEST_ASSERT_FALSE(alarmPin());
+    roll(1); // CNT == CCR3, 65536 counts short
+    TEST_ASSERT_FALSE(alarmPin());
+    roll(65535);
+    TEST_ASSERT_FALSE(alarmPin());
+    roll(1);
+    TEST_ASSERT_TRUE(alarmPin());
+    TEST_ASSERT_EQUAL_INT64(target, countNow());
+
+    // Same coming down
+    target = armAt(-(65536 + 200));
+    roll(-200);
+    TEST_ASSERT_FALSE(alarmPin());
+    roll(-65536);
+    TEST_ASSERT_TRUE(alarmPin());
+    TEST_ASSERT_EQUAL_INT64(target, countNow());
+}
+
+void test_compare_window_is_64_counts(void) {
+    // IRQ served late: still the right epoch within 64 counts of the trip
+    armAt(300);
+    roll(290);
+    jump(10 + 64);
+    TEST_ASSERT_TRUE(alarmPin());
+
+    armAt(-300);
+    roll(-290);
+    jump(-(10 + 64));
+    TEST_ASSERT_TRUE(alarmPin());
+
+    // 65 past: the compare stays out of it, the tick catches the crossing
+    armAt(300);
+    roll(290);
+    jump(10 + 65);
+    TEST_ASSERT_FALSE(alarmPin());
+    tick(0);
+    TEST_ASSERT_TRUE(alarmPin());
+
+    armAt(-300);
+    roll(-290);
+    jump(-(10 + 65));
+    TEST_ASSERT_FALSE(alarmPin());
+    tick(0);
+    TEST_ASSERT_TRUE(alarmPin());
+}
+
+// ============================================================================
+// serviceAlarm: look-ahead at speed, late fire, re-arm
+// ============================================================================
+
+void test_lead_trips_early_at_speed(void) {
+    // 20 counts/ms = 20000 counts/s: 100 ms lead is 2000 counts
+    int64_t target = countNow() + 10000;
+    enc.reset();
+    enc.setTargetAlarm((PositionUM)enc.countsToUM(10000), 100);
+    int64_t firedAt = 0;
+    for (int i = 0; i < 600 && !alarmPin(); i++) {
+        tick(20);
+        firedAt = countNow();
+    }
+    TEST_ASSERT_TRUE(alarmPin());
+    TEST_ASSERT_INT64_WITHIN(100, target - 2000, firedAt);
+
+    // And from above
+    for (int i = 0; i < 50; i++) tick(0);
+    target = countNow() - 10000;
+    enc.reset();
+    enc.setTargetAlarm((PositionUM)enc.countsToUM(-10000), 100);
+    for (int i = 0; i < 600 && !alarmPin(); i++) {
+        tick(-20);
+        firedAt = countNow();
+    }
+    TEST_ASSERT_TRUE(alarmPin());
+    TEST_ASSERT_INT64_WITHIN(100, target + 2000, firedAt);
+}
+
+void test_rearms_after_backing_off(void) {
+    int64_t rearm = enc.umToCounts(TARGET_ALARM_REARM_UM);
+    armAt(300);
+    roll(300);
+    TEST_ASSERT_TRUE(alarmPin());
+
+    // Back off just short of the hysteresis, then past it
+    roll(-(int32_t)rearm);
+    tick(0);
+    TEST_ASSERT_TRUE(alarmPin());
+    roll(-1);
+    tick(0);
+    TEST_ASSERT_FALSE(alarmPin());
+    TEST_ASSERT_FALSE(enc.isTargetAlarmActive());
+
+    // Re-armed (compare back on from the next tick): fires again on the
+    // next approach
+    tick(0);
+    roll((int32_t)rearm + 1);
+    TEST_ASSERT_TRUE(alarmPin());
+}
+
+int main(int argc, char **argv) {
+    enc.init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_predict_trip_count);
+    RUN_TEST(test_compare_fires_at_the_count_from_below);
+    RUN_TEST(test_compare_fires_at_the_count_from_above);
+    RUN_TEST(test_compare_ignores_the_wrong_epoch);
+    RUN_TEST(test_compare_window_is_64_counts);
+    RUN_TEST(test_lead_trips_early_at_speed);
+    RUN_TEST(test_rearms_after_backing_off);
+    return UNITY_END();
+}